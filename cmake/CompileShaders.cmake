@@ -24,6 +24,9 @@ function(add_shader_compile_dir SHADER_DIR)
 
     set(BGFX_SHADERC bgfx::shaderc)
 
+    # 着色器共用的 .sh 头文件，修改后需要重新编译包含它们的着色器
+    file(GLOB SHADER_INCLUDE_FILES CONFIGURE_DEPENDS "${SHADER_DIR}/include/*.sh")
+
     set(PROFILES 120 300_es spirv) # pssl
     if (UNIX AND NOT APPLE)
         set(PLATFORM LINUX)
@@ -66,14 +69,14 @@ function(add_shader_compile_dir SHADER_DIR)
 
             add_custom_command(
                     OUTPUT ${OUTPUT_VERTEX}
-                    DEPENDS ${VERTEX_SHADER_FILE} ${VARYING_DEF_FILE}
+                    DEPENDS ${VERTEX_SHADER_FILE} ${VARYING_DEF_FILE} ${SHADER_INCLUDE_FILES}
                     COMMAND ${BGFX_SHADERC} --type vertex --platform ${PLATFORM} --profile ${PROFILE} -f ${VERTEX_SHADER_FILE} --varyingdef ${VARYING_DEF_FILE} -o ${OUTPUT_VERTEX} -i ${SHADER_DIR} -i ${BGFX_SHADER_INCLUDE_PATH}
                     COMMENT "Compiling vertex shader ${SHADER_NAME} for ${PROFILE_EXT} profile"
             )
 
             add_custom_command(
                     OUTPUT ${OUTPUT_FRAGMENT}
-                    DEPENDS ${FRAGMENT_SHADER_FILE} ${VARYING_DEF_FILE}
+                    DEPENDS ${FRAGMENT_SHADER_FILE} ${VARYING_DEF_FILE} ${SHADER_INCLUDE_FILES}
                     COMMAND ${BGFX_SHADERC} --type fragment --platform ${PLATFORM} --profile ${PROFILE} -f ${FRAGMENT_SHADER_FILE} --varyingdef ${VARYING_DEF_FILE} -o ${OUTPUT_FRAGMENT} -i ${SHADER_DIR} -i ${BGFX_SHADER_INCLUDE_PATH}
                     COMMENT "Compiling fragment shader ${SHADER_NAME} for ${PROFILE_EXT} profile"
             )
@@ -0,0 +1,81 @@
+cmake_minimum_required(VERSION 3.20)
+
+# 构建时把源图片（png/tga/jpg）转换为 KTX：生成完整的 mip 链、预乘 alpha，并按 TINA_TEXTURE_FORMAT 压缩。
+# 文件名以 -n 结尾的视为法线贴图，不做预乘。转换结果以“源文件内容 + 转换参数”的哈希为键缓存在
+# TINA_TEXTURE_CACHE_DIR 中，内容没有变化时重新配置或换构建目录都不会再次调用 texturec。
+# 运行时 BgfxUtils::decodeImage 会优先读取同名的 .ktx 文件，因此同一目录下不能有只差扩展名的源图片。
+# 只转换 TEXTURE_DIR 下一层的文件，子目录（例如放入运行时图集的 sprites/，需要无 mip 的 RGBA8）保持原样。
+function(add_texture_compile_dir TEXTURE_DIR)
+
+    if (NOT EXISTS "${TEXTURE_DIR}")
+        message(NOTICE "Texture directory ${TEXTURE_DIR} does not exist")
+        return()
+    endif ()
+
+    if (CMAKE_CROSSCOMPILING AND NOT ("${CMAKE_HOST_SYSTEM_NAME}" STREQUAL "${CMAKE_SYSTEM_NAME}"))
+        message(STATUS "Not compiling textures during cross-compilation")
+        return()
+    endif ()
+
+    set(TEXTURE_OUTPUT_DIR "${CMAKE_BINARY_DIR}/resources/textures")
+    file(MAKE_DIRECTORY "${TEXTURE_OUTPUT_DIR}")
+    file(MAKE_DIRECTORY "${TINA_TEXTURE_CACHE_DIR}")
+
+    set(BGFX_TEXTUREC bgfx::texturec)
+
+    file(GLOB TEXTURE_SOURCE_LIST CONFIGURE_DEPENDS
+            "${TEXTURE_DIR}/*.png"
+            "${TEXTURE_DIR}/*.tga"
+            "${TEXTURE_DIR}/*.jpg"
+            "${TEXTURE_DIR}/*.jpeg")
+
+    set(TEXTURE_NAME_LIST)
+    foreach (TEXTURE_FILE ${TEXTURE_SOURCE_LIST})
+        # 与运行时 getCookedTexturePath 一致，只去掉最后一个扩展名
+        get_filename_component(TEXTURE_NAME "${TEXTURE_FILE}" NAME_WLE)
+
+        # a.png 与 a.jpg 会生成同一个 a.ktx，运行时无法区分
+        if (TEXTURE_NAME IN_LIST TEXTURE_NAME_LIST)
+            message(FATAL_ERROR "Texture ${TEXTURE_FILE} maps to ${TEXTURE_NAME}.ktx, which is already produced by another source image")
+        endif ()
+        list(APPEND TEXTURE_NAME_LIST "${TEXTURE_NAME}")
+
+        set(TEXTUREC_ARGS --mips)
+        if (TEXTURE_NAME MATCHES "-n$")
+            list(APPEND TEXTUREC_ARGS --normalmap)
+        else ()
+            list(APPEND TEXTUREC_ARGS --pma)
+        endif ()
+        if (TINA_TEXTURE_FORMAT)
+            list(APPEND TEXTUREC_ARGS -t ${TINA_TEXTURE_FORMAT})
+        endif ()
+
+        # 源文件修改后重新配置，以便重新计算缓存键
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${TEXTURE_FILE}")
+        file(SHA1 "${TEXTURE_FILE}" CONTENT_HASH)
+        string(SHA1 CACHE_KEY "${CONTENT_HASH};${TEXTUREC_ARGS}")
+
+        set(CACHED_TEXTURE "${TINA_TEXTURE_CACHE_DIR}/${CACHE_KEY}.ktx")
+        set(OUTPUT_TEXTURE "${TEXTURE_OUTPUT_DIR}/${TEXTURE_NAME}.ktx")
+
+        add_custom_command(
+                OUTPUT ${CACHED_TEXTURE}
+                DEPENDS ${TEXTURE_FILE}
+                COMMAND ${BGFX_TEXTUREC} -f ${TEXTURE_FILE} -o ${CACHED_TEXTURE} ${TEXTUREC_ARGS}
+                COMMENT "Compiling texture ${TEXTURE_NAME}"
+        )
+
+        add_custom_command(
+                OUTPUT ${OUTPUT_TEXTURE}
+                DEPENDS ${CACHED_TEXTURE}
+                COMMAND ${CMAKE_COMMAND} -E copy_if_different ${CACHED_TEXTURE} ${OUTPUT_TEXTURE}
+        )
+
+        list(APPEND TEXTURE_OUTPUT_LIST ${OUTPUT_TEXTURE})
+    endforeach ()
+
+    add_custom_target(textures ALL DEPENDS ${TEXTURE_OUTPUT_LIST})
+    source_group(TREE "${TEXTURE_DIR}" PREFIX "Texture Files" FILES ${TEXTURE_SOURCE_LIST})
+    target_sources(textures PRIVATE ${TEXTURE_SOURCE_LIST})
+
+endfunction()
@@ -0,0 +1,60 @@
+#include "CpuFeatures.hpp"
+
+#if TINA_SIMD_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace Tina::CpuFeatures
+{
+    namespace
+    {
+        struct Features
+        {
+            bool ssse3 = false;
+            bool avx2 = false;
+        };
+
+        Features detect()
+        {
+            Features features;
+#if TINA_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            const int maxLeaf = info[0];
+            __cpuid(info, 1);
+            features.ssse3 = (info[2] & (1 << 9)) != 0;
+            // AVX2 还需要操作系统保存 YMM 寄存器状态
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (maxLeaf >= 7 && osxsave && (_xgetbv(0) & 0x6) == 0x6)
+            {
+                __cpuidex(info, 7, 0);
+                features.avx2 = (info[1] & (1 << 5)) != 0;
+            }
+#else
+            __builtin_cpu_init();
+            features.ssse3 = __builtin_cpu_supports("ssse3");
+            features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+#endif
+            return features;
+        }
+
+        const Features& getFeatures()
+        {
+            static const Features features = detect();
+            return features;
+        }
+    }
+
+    bool hasSSSE3()
+    {
+        return getFeatures().ssse3;
+    }
+
+    bool hasAVX2()
+    {
+        return getFeatures().avx2;
+    }
+} // Tina::CpuFeatures
@@ -0,0 +1,28 @@
+#ifndef TINA_BASE_CPUFEATURES_HPP
+#define TINA_BASE_CPUFEATURES_HPP
+
+// x86 上可以使用 SSE2 及以上的内建函数（x86-64 保证支持 SSE2）
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TINA_SIMD_X86 1
+#else
+#define TINA_SIMD_X86 0
+#endif
+
+// GCC/Clang 需要通过 target 属性单独为函数开启更高的指令集，MSVC 可以直接使用内建函数
+#if defined(__GNUC__) || defined(__clang__)
+#define TINA_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TINA_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TINA_TARGET_SSSE3
+#define TINA_TARGET_AVX2
+#endif
+
+namespace Tina::CpuFeatures
+{
+    // 运行时检测，结果在首次调用时缓存；非 x86 平台始终返回 false
+    bool hasSSSE3();
+    bool hasAVX2();
+} // Tina::CpuFeatures
+
+#endif //TINA_BASE_CPUFEATURES_HPP
@@ -0,0 +1,213 @@
+#include "InternedString.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace Tina
+{
+    namespace
+    {
+        constexpr uint32_t SHARD_COUNT = 16;
+        constexpr uint32_t ENTRIES_PER_CHUNK = 4096;
+        constexpr uint32_t MAX_CHUNKS = 4096;
+        constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+        struct Entry
+        {
+            const char* data;
+            uint32_t length;
+            uint32_t hash;
+        };
+
+        uint32_t hashString(std::string_view str)
+        {
+            // FNV-1a
+            uint32_t hash = 2166136261u;
+            for (const char c : str)
+            {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        // 哈希值已在句柄构造时算好，查表时不再重复计算
+        struct Key
+        {
+            std::string_view str;
+            uint32_t hash;
+
+            bool operator==(const Key& other) const { return hash == other.hash && str == other.str; }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const noexcept { return key.hash; }
+        };
+
+        struct Shard
+        {
+            std::shared_mutex mutex;
+            // 键指向 arena 中的字符串，与 Entry 共享同一份存储
+            std::unordered_map<Key, uint32_t, KeyHash> ids;
+            std::vector<std::unique_ptr<char[]>> blocks;
+            char* cursor = nullptr;
+            size_t remaining = 0;
+
+            // 调用方需持有写锁
+            const char* store(std::string_view str)
+            {
+                const size_t size = str.size() + 1;
+                if (size > remaining)
+                {
+                    const size_t blockSize = std::max(size, ARENA_BLOCK_SIZE);
+                    blocks.push_back(std::make_unique<char[]>(blockSize));
+                    cursor = blocks.back().get();
+                    remaining = blockSize;
+                }
+
+                char* result = cursor;
+                std::memcpy(result, str.data(), str.size());
+                result[str.size()] = '\0';
+                cursor += size;
+                remaining -= size;
+                return result;
+            }
+        };
+
+        class InternTable
+        {
+        public:
+            InternTable()
+            {
+                // id 0 固定为空字符串，哈希为 0，与默认构造的句柄一致
+                Entry* chunk = getChunk(0);
+                chunk[0] = Entry{"", 0, 0};
+            }
+
+            uint32_t intern(std::string_view str, uint32_t hash)
+            {
+                // 分片用哈希高位，避免与哈希表桶索引使用的低位相关
+                Shard& shard = m_shards[(hash >> 28) % SHARD_COUNT];
+                const Key key{str, hash};
+                {
+                    std::shared_lock lock(shard.mutex);
+                    if (const auto it = shard.ids.find(key); it != shard.ids.end())
+                    {
+                        return it->second;
+                    }
+                }
+
+                std::unique_lock lock(shard.mutex);
+                if (const auto it = shard.ids.find(key); it != shard.ids.end())
+                {
+                    return it->second;
+                }
+
+                const uint32_t id = m_nextId.fetch_add(1, std::memory_order_relaxed);
+                if (id / ENTRIES_PER_CHUNK >= MAX_CHUNKS)
+                {
+                    throw std::runtime_error("Intern table is full");
+                }
+
+                const char* data = shard.store(str);
+                getChunk(id / ENTRIES_PER_CHUNK)[id % ENTRIES_PER_CHUNK] =
+                    Entry{data, static_cast<uint32_t>(str.size()), hash};
+                // 条目先写入再放进哈希表，其他线程只能通过哈希表（持锁）或已有句柄拿到 id
+                shard.ids.emplace(Key{std::string_view(data, str.size()), hash}, id);
+                return id;
+            }
+
+            const Entry& getEntry(uint32_t id) const
+            {
+                const Entry* chunk = m_chunks[id / ENTRIES_PER_CHUNK].load(std::memory_order_acquire);
+                return chunk[id % ENTRIES_PER_CHUNK];
+            }
+
+            size_t size() const
+            {
+                return m_nextId.load(std::memory_order_relaxed);
+            }
+
+        private:
+            Entry* getChunk(uint32_t index)
+            {
+                Entry* chunk = m_chunks[index].load(std::memory_order_acquire);
+                if (chunk == nullptr)
+                {
+                    auto* fresh = new Entry[ENTRIES_PER_CHUNK]();
+                    if (m_chunks[index].compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel))
+                    {
+                        chunk = fresh;
+                    }
+                    else
+                    {
+                        delete[] fresh;
+                    }
+                }
+                return chunk;
+            }
+
+            Shard m_shards[SHARD_COUNT];
+            std::atomic<Entry*> m_chunks[MAX_CHUNKS]{};
+            std::atomic<uint32_t> m_nextId{1};
+        };
+
+        // 刻意不析构，静态对象析构时仍可访问驻留的字符串
+        InternTable& getTable()
+        {
+            static auto* table = new InternTable();
+            return *table;
+        }
+    }
+
+    InternedString::InternedString(std::string_view str)
+    {
+        if (!str.empty())
+        {
+            m_hash = hashString(str);
+            m_id = getTable().intern(str, m_hash);
+        }
+    }
+
+    InternedString::InternedString(const char* str)
+        : InternedString(str ? std::string_view(str) : std::string_view())
+    {
+    }
+
+    InternedString::InternedString(const std::string& str) : InternedString(std::string_view(str))
+    {
+    }
+
+    InternedString::InternedString(const String& str) : InternedString(std::string_view(str.c_str(), str.length()))
+    {
+    }
+
+    std::string_view InternedString::view() const
+    {
+        const Entry& entry = getTable().getEntry(m_id);
+        return {entry.data, entry.length};
+    }
+
+    const char* InternedString::c_str() const
+    {
+        return getTable().getEntry(m_id).data;
+    }
+
+    size_t InternedString::length() const
+    {
+        return getTable().getEntry(m_id).length;
+    }
+
+    size_t InternedString::getInternedCount()
+    {
+        return getTable().size();
+    }
+} // Tina
@@ -0,0 +1,75 @@
+#ifndef TINA_BASE_INTERNEDSTRING_HPP
+#define TINA_BASE_INTERNEDSTRING_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "String.hpp"
+
+namespace Tina
+{
+    /**
+     * 驻留字符串句柄。
+     * 相同内容的字符串在全局驻留表中只保存一份，句柄只包含 32 位 id 和预先计算好的哈希值，
+     * 比较是整数比较，作为哈希表的键时也无需再次计算哈希。
+     *
+     * 驻留表按哈希分片、由读写锁保护，只有首次驻留某个字符串时才需要写锁；
+     * 通过 id 取回字符串内容完全无锁。驻留的字符串在进程生命周期内不会释放，
+     * 因此只应用于资源路径、配置键、uniform 名这类数量有限的标识符。
+     */
+    class InternedString
+    {
+    public:
+        // 默认构造为空字符串，id 为 0
+        InternedString() = default;
+        explicit InternedString(std::string_view str);
+        explicit InternedString(const char* str);
+        explicit InternedString(const std::string& str);
+        explicit InternedString(const String& str);
+
+        [[nodiscard]] uint32_t getId() const { return m_id; }
+        [[nodiscard]] uint32_t getHash() const { return m_hash; }
+        [[nodiscard]] bool empty() const { return m_id == 0; }
+
+        // 返回的视图在整个进程生命周期内有效，且以 '\0' 结尾
+        [[nodiscard]] std::string_view view() const;
+        [[nodiscard]] const char* c_str() const;
+        [[nodiscard]] size_t length() const;
+
+        explicit operator std::string_view() const { return view(); }
+
+        bool operator==(const InternedString& other) const { return m_id == other.m_id; }
+        bool operator!=(const InternedString& other) const { return m_id != other.m_id; }
+        // 按 id 排序（即驻留顺序），不是字典序
+        bool operator<(const InternedString& other) const { return m_id < other.m_id; }
+
+        // 当前驻留的字符串数量（包含空字符串）
+        static size_t getInternedCount();
+
+    private:
+        uint32_t m_id = 0;
+        uint32_t m_hash = 0;
+    };
+} // Tina
+
+template <>
+struct std::hash<Tina::InternedString>
+{
+    size_t operator()(const Tina::InternedString& str) const noexcept
+    {
+        return str.getHash();
+    }
+};
+
+template <>
+struct fmt::formatter<Tina::InternedString> : formatter<string_view>
+{
+    template <typename FormatContext>
+    auto format(const Tina::InternedString& str, FormatContext& ctx) const
+    {
+        return formatter<string_view>::format(string_view(str.c_str(), str.length()), ctx);
+    }
+};
+
+#endif //TINA_BASE_INTERNEDSTRING_HPP
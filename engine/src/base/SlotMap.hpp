@@ -0,0 +1,166 @@
+#ifndef TINA_BASE_SLOTMAP_HPP
+#define TINA_BASE_SLOTMAP_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Tina
+{
+    /**
+     * 带代数的槽位表。
+     * 元素紧密存放在 m_values 中，删除时与末尾元素交换，遍历是连续内存访问；
+     * 键由槽位下标和代数组成，查找只需一次数组下标和代数比较。槽位被删除后代数加一，
+     * 旧键随即失效，不会误取到之后复用该槽位的元素。
+     *
+     * 键打包为 32 位：低 IndexBits 位是槽位下标，其上 GenerationBits 位是代数。
+     * 代数从 1 开始且回绕时跳过 0，因此有效键永远不为 0。
+     */
+    template <typename T, uint32_t IndexBits = 16, uint32_t GenerationBits = 16>
+    class SlotMap
+    {
+        static_assert(IndexBits + GenerationBits <= 32, "SlotMap key must fit in 32 bits");
+
+    public:
+        using Key = uint32_t;
+
+        static constexpr Key INVALID_KEY = 0;
+        static constexpr uint32_t MAX_SIZE = (1u << IndexBits) - 1;
+
+        static constexpr uint32_t getIndex(Key key) { return key & INDEX_MASK; }
+        static constexpr uint32_t getGeneration(Key key) { return (key >> IndexBits) & GENERATION_MASK; }
+
+        // 槽位用尽时返回 INVALID_KEY
+        Key insert(T value)
+        {
+            uint32_t index;
+            if (m_freeHead != NONE)
+            {
+                index = m_freeHead;
+                m_freeHead = m_slots[index].target;
+            }
+            else
+            {
+                if (m_slots.size() >= MAX_SIZE)
+                {
+                    return INVALID_KEY;
+                }
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.push_back({NONE, 1});
+            }
+
+            Slot& slot = m_slots[index];
+            slot.target = static_cast<uint32_t>(m_values.size());
+            m_values.push_back(std::move(value));
+            m_valueSlots.push_back(index);
+            return makeKey(index, slot.generation);
+        }
+
+        bool erase(Key key)
+        {
+            const uint32_t index = getIndex(key);
+            if (!contains(key))
+            {
+                return false;
+            }
+
+            // 用末尾元素填补空位
+            Slot& slot = m_slots[index];
+            const uint32_t valueIndex = slot.target;
+            const uint32_t last = static_cast<uint32_t>(m_values.size()) - 1;
+            if (valueIndex != last)
+            {
+                m_values[valueIndex] = std::move(m_values[last]);
+                m_valueSlots[valueIndex] = m_valueSlots[last];
+                m_slots[m_valueSlots[valueIndex]].target = valueIndex;
+            }
+            m_values.pop_back();
+            m_valueSlots.pop_back();
+
+            slot.generation = nextGeneration(slot.generation);
+            slot.target = m_freeHead;
+            m_freeHead = index;
+            return true;
+        }
+
+        [[nodiscard]] bool contains(Key key) const
+        {
+            const uint32_t index = getIndex(key);
+            return index < m_slots.size() && m_slots[index].generation == getGeneration(key) &&
+                m_slots[index].target < m_values.size() && m_valueSlots[m_slots[index].target] == index;
+        }
+
+        T* get(Key key)
+        {
+            return contains(key) ? &m_values[m_slots[getIndex(key)].target] : nullptr;
+        }
+
+        const T* get(Key key) const
+        {
+            return contains(key) ? &m_values[m_slots[getIndex(key)].target] : nullptr;
+        }
+
+        void clear()
+        {
+            // 保留槽位并推进代数，使清空前发出的键全部失效
+            for (const uint32_t index : m_valueSlots)
+            {
+                Slot& slot = m_slots[index];
+                slot.generation = nextGeneration(slot.generation);
+                slot.target = m_freeHead;
+                m_freeHead = index;
+            }
+            m_values.clear();
+            m_valueSlots.clear();
+        }
+
+        [[nodiscard]] size_t size() const { return m_values.size(); }
+        [[nodiscard]] bool empty() const { return m_values.empty(); }
+
+        // 紧密存放的第 i 个元素对应的键，遍历时使用
+        [[nodiscard]] Key keyAt(size_t i) const
+        {
+            const uint32_t index = m_valueSlots[i];
+            return makeKey(index, m_slots[index].generation);
+        }
+
+        T& valueAt(size_t i) { return m_values[i]; }
+        const T& valueAt(size_t i) const { return m_values[i]; }
+
+        typename std::vector<T>::iterator begin() { return m_values.begin(); }
+        typename std::vector<T>::iterator end() { return m_values.end(); }
+        typename std::vector<T>::const_iterator begin() const { return m_values.begin(); }
+        typename std::vector<T>::const_iterator end() const { return m_values.end(); }
+
+    private:
+        static constexpr uint32_t INDEX_MASK = (1u << IndexBits) - 1;
+        static constexpr uint32_t GENERATION_MASK = GenerationBits >= 32 ? ~0u : (1u << GenerationBits) - 1;
+        static constexpr uint32_t NONE = ~0u;
+
+        struct Slot
+        {
+            // 占用时为元素在 m_values 中的位置，空闲时为下一个空闲槽位
+            uint32_t target;
+            uint32_t generation;
+        };
+
+        static constexpr Key makeKey(uint32_t index, uint32_t generation)
+        {
+            return index | (generation << IndexBits);
+        }
+
+        static uint32_t nextGeneration(uint32_t generation)
+        {
+            generation = (generation + 1) & GENERATION_MASK;
+            return generation == 0 ? 1 : generation;
+        }
+
+        std::vector<Slot> m_slots;
+        std::vector<T> m_values;
+        // m_values[i] 所在的槽位
+        std::vector<uint32_t> m_valueSlots;
+        uint32_t m_freeHead = NONE;
+    };
+} // Tina
+
+#endif //TINA_BASE_SLOTMAP_HPP
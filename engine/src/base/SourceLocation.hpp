@@ -0,0 +1,25 @@
+#ifndef TINA_BASE_SOURCELOCATION_HPP
+#define TINA_BASE_SOURCELOCATION_HPP
+
+namespace Tina
+{
+    /**
+     * 源代码位置，用法与 C++20 的 std::source_location 相同：作为默认参数 SourceLocation::current()
+     * 时得到的是调用方的位置。基于 GCC/Clang/MSVC 的内建函数实现，C++17 下也可以使用。
+     * 经 std::make_unique 等函数转发构造时，默认参数取到的是标准库内部的位置，需要显式传入 SourceLocation::current()。
+     */
+    struct SourceLocation
+    {
+        const char* file = "";
+        int line = 0;
+        const char* function = "";
+
+        static constexpr SourceLocation current(const char* file = __builtin_FILE(), int line = __builtin_LINE(),
+                                                const char* function = __builtin_FUNCTION()) noexcept
+        {
+            return {file, line, function};
+        }
+    };
+} // Tina
+
+#endif //TINA_BASE_SOURCELOCATION_HPP
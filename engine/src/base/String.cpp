@@ -4,17 +4,23 @@
 
 #include "String.hpp"
 
+#include <cstddef>
 #include <fmt/base.h>
+#include "StringSearch.hpp"
+#include "memory/TrackMemory.hpp"
 
 namespace Tina
 {
-    char* String::allocateMemory(size_t size)
+    char* String::allocateMemory(size_t size, const SourceLocation& location)
     {
+        TINA_TRACK_ALLOC(MemoryTag::String, size, location);
+        (void)location;
         return getMemoryPool().allocate(size);
     }
 
     void String::deallocateMemory(char* ptr, size_t size)
     {
+        TINA_TRACK_FREE(MemoryTag::String, size);
         getMemoryPool().deallocate(ptr, size);
     }
 
@@ -23,131 +29,289 @@ namespace Tina
         return StringMemoryPool::getInstance();
     }
 
-    StringMemoryPool::StringMemoryPool()
+    struct StringMemoryPool::FreeBlock
     {
-        initializePool(m_blocks, SMALL_STRING_SIZE);
-        initializePool(m_mediumPool, MEDIUM_STRING_SIZE);
-        initializePool(m_largePool, LARGE_STRING_SIZE);
-    }
+        FreeBlock* next;
+        // 以下字段只在一批块的第一个块上有效
+        FreeBlock* nextBatch;
+        size_t batchCount;
+    };
 
-    StringMemoryPool::~StringMemoryPool()
+    struct alignas(std::max_align_t) StringMemoryPool::Chunk
     {
-        releasePool(m_blocks);
-        releasePool(m_mediumPool);
-        releasePool(m_largePool);
-    }
+        Chunk* next;
+    };
 
-    void StringMemoryPool::updateAllocationStats(size_t size)
+    // 单个线程的统计计数，只由拥有它的线程写入（共享记录除外）
+    struct StringMemoryPool::StatsRecord
     {
-        m_stats.totalAllocations++;
-        m_stats.currentAllocations++;
-        m_stats.peakAllocations = std::max(m_stats.peakAllocations, m_stats.currentAllocations);
+        std::atomic<size_t> totalAllocations{0};
+        std::atomic<size_t> totalMemoryUsed{0};
+        std::atomic<int64_t> currentAllocations{0};
+        std::atomic<int64_t> currentMemoryUsed{0};
+        std::atomic<size_t> allocations[SIZE_CLASS_COUNT + 1]{};
+        std::atomic<size_t> deallocations[SIZE_CLASS_COUNT + 1]{};
+        std::atomic<bool> active{false};
+        StatsRecord* next = nullptr;
+    };
 
-        m_stats.totalMemoryUsed += size;
-        m_stats.currentMemoryUsed += size;
-        m_stats.peakMemoryUsed = std::max(m_stats.peakMemoryUsed, m_stats.currentMemoryUsed);
+    namespace
+    {
+        enum class CacheState : uint8_t
+        {
+            Uninitialized,
+            Active,
+            Destroyed
+        };
 
-        if (size <= SMALL_STRING_SIZE)
+        // 可平凡析构，线程退出的任何阶段都可以安全读取
+        thread_local CacheState t_cacheState = CacheState::Uninitialized;
+
+        template <typename T, typename U>
+        void addCounter(std::atomic<T>& counter, U delta, bool shared)
         {
-            updatePoolStats(m_stats.smallPool, true);
+            if (shared)
+            {
+                counter.fetch_add(static_cast<T>(delta), std::memory_order_relaxed);
+            }
+            else
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + static_cast<T>(delta),
+                              std::memory_order_relaxed);
+            }
         }
-        else if (size <= MEDIUM_STRING_SIZE)
+
+        void updatePeak(std::atomic<size_t>& peak, size_t value)
         {
-            updatePoolStats(m_stats.mediumPool, true);
+            size_t current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
         }
-        else if (size <= LARGE_STRING_SIZE)
+    }
+
+    struct StringMemoryPool::ThreadCache
+    {
+        FreeBlock* heads[SIZE_CLASS_COUNT]{};
+        size_t counts[SIZE_CLASS_COUNT]{};
+        StatsRecord* stats;
+
+        explicit ThreadCache(StringMemoryPool& pool) : stats(pool.acquireStatsRecord())
         {
-            updatePoolStats(m_stats.largePool, true);
+            t_cacheState = CacheState::Active;
         }
-        else
+
+        ~ThreadCache()
         {
-            updatePoolStats(m_stats.customAllocations, true);
+            StringMemoryPool& pool = getInstance();
+            for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+            {
+                if (heads[i])
+                {
+                    pool.pushBatch(i, heads[i], counts[i]);
+                }
+            }
+            stats->active.store(false, std::memory_order_release);
+            t_cacheState = CacheState::Destroyed;
         }
-    }
 
-    void StringMemoryPool::updateDeallocationStats(size_t size)
+        char* pop(StringMemoryPool& pool, size_t sizeClass)
+        {
+            if (!heads[sizeClass])
+            {
+                FreeBlock* batch = pool.takeBatch(sizeClass, counts[sizeClass]);
+                heads[sizeClass] = batch ? batch : pool.carveChunk(sizeClass, counts[sizeClass]);
+            }
+
+            FreeBlock* block = heads[sizeClass];
+            heads[sizeClass] = block->next;
+            --counts[sizeClass];
+            return reinterpret_cast<char*>(block);
+        }
+
+        void push(StringMemoryPool& pool, size_t sizeClass, char* ptr)
+        {
+            auto* block = reinterpret_cast<FreeBlock*>(ptr);
+            block->next = heads[sizeClass];
+            heads[sizeClass] = block;
+
+            if (++counts[sizeClass] >= CACHE_BATCH_SIZE * 2)
+            {
+                // 保留链表头部最近释放的块（缓存更热），其余的整体归还给全局链表
+                FreeBlock* last = heads[sizeClass];
+                for (size_t i = 1; i < CACHE_BATCH_SIZE; ++i)
+                {
+                    last = last->next;
+                }
+                FreeBlock* rest = last->next;
+                last->next = nullptr;
+                pool.pushBatch(sizeClass, rest, counts[sizeClass] - CACHE_BATCH_SIZE);
+                counts[sizeClass] = CACHE_BATCH_SIZE;
+            }
+        }
+    };
+
+    StringMemoryPool::StringMemoryPool() : m_sharedStats(new StatsRecord())
     {
-        m_stats.currentAllocations--;
-        m_stats.currentMemoryUsed -= size;
+    }
 
+    size_t StringMemoryPool::getSizeClass(size_t size)
+    {
         if (size <= SMALL_STRING_SIZE)
         {
-            updatePoolStats(m_stats.smallPool, false);
+            return 0;
         }
-        else if (size <= MEDIUM_STRING_SIZE)
+        if (size <= MEDIUM_STRING_SIZE)
         {
-            updatePoolStats(m_stats.mediumPool, false);
+            return 1;
         }
-        else if (size <= LARGE_STRING_SIZE)
+        if (size <= LARGE_STRING_SIZE)
         {
-            updatePoolStats(m_stats.largePool, false);
+            return 2;
         }
-        else
+        return CUSTOM_CLASS;
+    }
+
+    size_t StringMemoryPool::getClassSize(size_t sizeClass)
+    {
+        static constexpr size_t sizes[SIZE_CLASS_COUNT] = {SMALL_STRING_SIZE, MEDIUM_STRING_SIZE, LARGE_STRING_SIZE};
+        return sizes[sizeClass];
+    }
+
+    StringMemoryPool::ThreadCache* StringMemoryPool::getThreadCache()
+    {
+        if (t_cacheState == CacheState::Destroyed)
         {
-            updatePoolStats(m_stats.customAllocations, false);
+            return nullptr;
         }
+        static thread_local ThreadCache cache(*this);
+        return &cache;
     }
 
-    void StringMemoryPool::updatePoolStats(PoolStats::PoolTypeStats& stats, bool isAllocation)
+    StringMemoryPool::StatsRecord* StringMemoryPool::acquireStatsRecord()
     {
-        if (isAllocation)
+        // 优先复用已退出线程留下的记录，计数保留以保证汇总结果正确
+        for (StatsRecord* record = m_statsRecords.load(std::memory_order_acquire); record; record = record->next)
         {
-            stats.allocations++;
-            stats.currentUsage++;
-            stats.peakUsage = std::max(stats.peakUsage, stats.currentUsage);
+            bool expected = false;
+            if (!record->active.load(std::memory_order_relaxed) &&
+                record->active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return record;
+            }
         }
-        else
+
+        auto* record = new StatsRecord();
+        record->active.store(true, std::memory_order_relaxed);
+        record->next = m_statsRecords.load(std::memory_order_relaxed);
+        while (!m_statsRecords.compare_exchange_weak(record->next, record,
+                                                     std::memory_order_release, std::memory_order_relaxed))
         {
-            stats.deallocations++;
-            stats.currentUsage--;
         }
+        return record;
     }
 
-    void StringMemoryPool::initializePool(std::vector<MemoryBlock>& pool, size_t blockSize)
+    void StringMemoryPool::pushBatch(size_t sizeClass, FreeBlock* first, size_t count)
     {
-        pool.resize(BLOCK_COUNT);
-        for (auto& block : pool)
+        first->batchCount = count;
+        first->nextBatch = m_freeBatches[sizeClass].load(std::memory_order_relaxed);
+        while (!m_freeBatches[sizeClass].compare_exchange_weak(first->nextBatch, first,
+                                                               std::memory_order_release, std::memory_order_relaxed))
         {
-            block.data = new char[blockSize];
-            block.used = false;
-            block.size = blockSize;
         }
     }
 
-    void StringMemoryPool::releasePool(std::vector<MemoryBlock>& pool)
+    StringMemoryPool::FreeBlock* StringMemoryPool::takeBatch(size_t sizeClass, size_t& count)
     {
-        for (auto& block : pool)
+        // 整体取走全局链表，留下第一批后把其余的再压回去，避免逐个 CAS 弹出带来的 ABA 问题
+        FreeBlock* batch = m_freeBatches[sizeClass].exchange(nullptr, std::memory_order_acquire);
+        if (!batch)
+        {
+            return nullptr;
+        }
+
+        if (FreeBlock* rest = batch->nextBatch)
         {
-            delete[] block.data;
+            FreeBlock* tail = rest;
+            while (tail->nextBatch)
+            {
+                tail = tail->nextBatch;
+            }
+            tail->nextBatch = m_freeBatches[sizeClass].load(std::memory_order_relaxed);
+            while (!m_freeBatches[sizeClass].compare_exchange_weak(tail->nextBatch, rest,
+                                                                   std::memory_order_release,
+                                                                   std::memory_order_relaxed))
+            {
+            }
         }
-        pool.clear();
+
+        count = batch->batchCount;
+        return batch;
     }
 
-    char* StringMemoryPool::allocate(size_t size)
+    StringMemoryPool::FreeBlock* StringMemoryPool::carveChunk(size_t sizeClass, size_t& count)
     {
-        char* ptr = nullptr;
+        static_assert(sizeof(FreeBlock) <= SMALL_STRING_SIZE, "Free list node must fit in the smallest block.");
 
-        if (size <= SMALL_STRING_SIZE)
+        // 块在进程生命周期内不归还系统，只挂在 m_chunks 上
+        const size_t blockSize = getClassSize(sizeClass);
+        auto* memory = static_cast<char*>(::operator new(sizeof(Chunk) + blockSize * BLOCK_COUNT));
+
+        auto* chunk = reinterpret_cast<Chunk*>(memory);
+        chunk->next = m_chunks.load(std::memory_order_relaxed);
+        while (!m_chunks.compare_exchange_weak(chunk->next, chunk,
+                                               std::memory_order_release, std::memory_order_relaxed))
         {
-            ptr = allocateFromPool(m_blocks, size);
         }
-        else if (size <= MEDIUM_STRING_SIZE)
+
+        char* data = memory + sizeof(Chunk);
+        for (size_t i = 0; i < BLOCK_COUNT; ++i)
+        {
+            auto* block = reinterpret_cast<FreeBlock*>(data + i * blockSize);
+            block->next = i + 1 < BLOCK_COUNT ? reinterpret_cast<FreeBlock*>(data + (i + 1) * blockSize) : nullptr;
+        }
+
+        count = BLOCK_COUNT;
+        return reinterpret_cast<FreeBlock*>(data);
+    }
+
+    char* StringMemoryPool::allocate(size_t size)
+    {
+        const size_t sizeClass = getSizeClass(size);
+        ThreadCache* cache = getThreadCache();
+        char* ptr;
+
+        if (sizeClass == CUSTOM_CLASS)
         {
-            ptr = allocateFromPool(m_mediumPool, size);
+            ptr = new char[size];
         }
-        else if (size <= LARGE_STRING_SIZE)
+        else if (cache)
         {
-            ptr = allocateFromPool(m_largePool, size);
+            ptr = cache->pop(*this, sizeClass);
         }
         else
         {
-            ptr = new char[size];
+            // 线程缓存已析构（线程退出阶段），直接与全局链表交换
+            size_t count = 0;
+            FreeBlock* block = takeBatch(sizeClass, count);
+            if (!block)
+            {
+                block = carveChunk(sizeClass, count);
+            }
+            if (count > 1)
+            {
+                pushBatch(sizeClass, block->next, count - 1);
+            }
+            ptr = reinterpret_cast<char*>(block);
         }
 
-        if (ptr)
-        {
-            updateAllocationStats(size);
-        }
+        const bool shared = cache == nullptr;
+        StatsRecord& stats = shared ? *m_sharedStats : *cache->stats;
+        addCounter(stats.totalAllocations, 1, shared);
+        addCounter(stats.totalMemoryUsed, size, shared);
+        addCounter(stats.currentAllocations, 1, shared);
+        addCounter(stats.currentMemoryUsed, size, shared);
+        addCounter(stats.allocations[sizeClass], 1, shared);
         return ptr;
     }
 
@@ -155,89 +319,134 @@ namespace Tina
     {
         if (!ptr) return;
 
-        updateDeallocationStats(size);
+        const size_t sizeClass = getSizeClass(size);
+        ThreadCache* cache = getThreadCache();
 
-        if (size <= SMALL_STRING_SIZE)
-        {
-            deallocateToPool(m_blocks, ptr);
-        }
-        else if (size <= MEDIUM_STRING_SIZE)
+        if (sizeClass == CUSTOM_CLASS)
         {
-            deallocateToPool(m_mediumPool, ptr);
+            delete[] ptr;
         }
-        else if (size <= LARGE_STRING_SIZE)
+        else if (cache)
         {
-            deallocateToPool(m_largePool, ptr);
+            cache->push(*this, sizeClass, ptr);
         }
         else
         {
-            delete[] ptr;
+            auto* block = reinterpret_cast<FreeBlock*>(ptr);
+            block->next = nullptr;
+            pushBatch(sizeClass, block, 1);
         }
+
+        const bool shared = cache == nullptr;
+        StatsRecord& stats = shared ? *m_sharedStats : *cache->stats;
+        addCounter(stats.currentAllocations, -1, shared);
+        addCounter(stats.currentMemoryUsed, -static_cast<int64_t>(size), shared);
+        addCounter(stats.deallocations[sizeClass], 1, shared);
     }
 
-    char* StringMemoryPool::allocateFromPool(std::vector<MemoryBlock>& pool, size_t size)
+    StringMemoryPool& StringMemoryPool::getInstance()
     {
-        for (auto& block : pool)
-        {
-            if (!block.used)
-            {
-                block.used = true;
-                return block.data;
-            }
-        }
-
-        MemoryBlock newBlock;
-        newBlock.data = new char[size];
-        newBlock.used = true;
-        newBlock.size = size;
-        pool.push_back(newBlock);
-        return newBlock.data;
+        // 刻意不析构，避免静态 String 在内存池销毁之后才释放
+        static auto* instance = new StringMemoryPool();
+        return *instance;
     }
 
-    void StringMemoryPool::deallocateToPool(std::vector<MemoryBlock>& pool, const char* ptr)
+    StringMemoryPool::PoolStats StringMemoryPool::getStats() const
     {
-        for (auto& block : pool)
+        int64_t currentAllocations = 0;
+        int64_t currentMemoryUsed = 0;
+        int64_t currentUsage[SIZE_CLASS_COUNT + 1]{};
+        PoolStats result;
+        PoolStats::PoolTypeStats* poolStats[SIZE_CLASS_COUNT + 1] = {
+            &result.smallPool, &result.mediumPool, &result.largePool, &result.customAllocations
+        };
+
+        auto accumulate = [&](const StatsRecord& record)
         {
-            if (block.data == ptr)
+            result.totalAllocations += record.totalAllocations.load(std::memory_order_relaxed);
+            result.totalMemoryUsed += record.totalMemoryUsed.load(std::memory_order_relaxed);
+            currentAllocations += record.currentAllocations.load(std::memory_order_relaxed);
+            currentMemoryUsed += record.currentMemoryUsed.load(std::memory_order_relaxed);
+            for (size_t i = 0; i <= SIZE_CLASS_COUNT; ++i)
             {
-                block.used = false;
-                return;
+                const size_t allocations = record.allocations[i].load(std::memory_order_relaxed);
+                const size_t deallocations = record.deallocations[i].load(std::memory_order_relaxed);
+                poolStats[i]->allocations += allocations;
+                poolStats[i]->deallocations += deallocations;
+                currentUsage[i] += static_cast<int64_t>(allocations) - static_cast<int64_t>(deallocations);
             }
+        };
+
+        for (const StatsRecord* record = m_statsRecords.load(std::memory_order_acquire); record; record = record->next)
+        {
+            accumulate(*record);
         }
-    }
+        accumulate(*m_sharedStats);
 
-    StringMemoryPool& StringMemoryPool::getInstance()
-    {
-        static StringMemoryPool instance;
-        return instance;
-    }
+        // 并发读取时各计数不是同一时刻的快照，钳制到 0 以免出现负数
+        result.currentAllocations = static_cast<size_t>(std::max<int64_t>(currentAllocations, 0));
+        result.currentMemoryUsed = static_cast<size_t>(std::max<int64_t>(currentMemoryUsed, 0));
+        updatePeak(m_peakAllocations, result.currentAllocations);
+        updatePeak(m_peakMemoryUsed, result.currentMemoryUsed);
+        result.peakAllocations = m_peakAllocations.load(std::memory_order_relaxed);
+        result.peakMemoryUsed = m_peakMemoryUsed.load(std::memory_order_relaxed);
 
-    const StringMemoryPool::PoolStats& StringMemoryPool::getStats() const
-    {
-        return m_stats;
+        for (size_t i = 0; i <= SIZE_CLASS_COUNT; ++i)
+        {
+            poolStats[i]->currentUsage = static_cast<size_t>(std::max<int64_t>(currentUsage[i], 0));
+            updatePeak(m_peakUsage[i], poolStats[i]->currentUsage);
+            poolStats[i]->peakUsage = m_peakUsage[i].load(std::memory_order_relaxed);
+        }
+        return result;
     }
 
     void StringMemoryPool::resetStats()
     {
-        m_stats = PoolStats{};
+        auto clear = [](StatsRecord& record)
+        {
+            record.totalAllocations.store(0, std::memory_order_relaxed);
+            record.totalMemoryUsed.store(0, std::memory_order_relaxed);
+            record.currentAllocations.store(0, std::memory_order_relaxed);
+            record.currentMemoryUsed.store(0, std::memory_order_relaxed);
+            for (size_t i = 0; i <= SIZE_CLASS_COUNT; ++i)
+            {
+                record.allocations[i].store(0, std::memory_order_relaxed);
+                record.deallocations[i].store(0, std::memory_order_relaxed);
+            }
+        };
+
+        for (StatsRecord* record = m_statsRecords.load(std::memory_order_acquire); record; record = record->next)
+        {
+            clear(*record);
+        }
+        clear(*m_sharedStats);
+
+        m_peakAllocations.store(0, std::memory_order_relaxed);
+        m_peakMemoryUsed.store(0, std::memory_order_relaxed);
+        for (auto& peak : m_peakUsage)
+        {
+            peak.store(0, std::memory_order_relaxed);
+        }
     }
 
     void StringMemoryPool::printStats() const
     {
+        const PoolStats stats = getStats();
+
         fmt::print("String Memory Pool Statistics:\n");
-        fmt::print("Total allocations: {}\n", m_stats.totalAllocations);
-        fmt::print("Current allocations: {}\n", m_stats.currentAllocations);
-        fmt::print("Peak allocations: {}\n", m_stats.peakAllocations);
-        fmt::print("Total memory used: {} bytes\n", m_stats.totalMemoryUsed);
-        fmt::print("Current memory used: {} bytes\n", m_stats.currentMemoryUsed);
-        fmt::print("Peak memory used: {} bytes\n", m_stats.peakMemoryUsed);
+        fmt::print("Total allocations: {}\n", stats.totalAllocations);
+        fmt::print("Current allocations: {}\n", stats.currentAllocations);
+        fmt::print("Peak allocations: {}\n", stats.peakAllocations);
+        fmt::print("Total memory used: {} bytes\n", stats.totalMemoryUsed);
+        fmt::print("Current memory used: {} bytes\n", stats.currentMemoryUsed);
+        fmt::print("Peak memory used: {} bytes\n", stats.peakMemoryUsed);
 
         fmt::print("\nPool-specific statistics:\n");
 
-        fmt::print("Small Pool:\n  {}\n", m_stats.smallPool);
-        fmt::print("Medium Pool:\n  {}\n", m_stats.mediumPool);
-        fmt::print("Large Pool:\n  {}\n", m_stats.largePool);
-        fmt::print("Custom Allocations:\n  {}\n", m_stats.customAllocations); // 这里之前用错了变量
+        fmt::print("Small Pool:\n  {}\n", stats.smallPool);
+        fmt::print("Medium Pool:\n  {}\n", stats.mediumPool);
+        fmt::print("Large Pool:\n  {}\n", stats.largePool);
+        fmt::print("Custom Allocations:\n  {}\n", stats.customAllocations);
     }
 
 
@@ -246,12 +455,13 @@ namespace Tina
         sso.data[0] = '\0';
     }
 
-    String::String(const String& other) : m_size(other.m_size), m_isSSO(other.m_isSSO)
+    String::String(const String& other, const SourceLocation& location)
+        : m_size(other.m_size), m_isSSO(other.m_isSSO)
     {
-        copyFrom(other);
+        copyFrom(other, location);
     }
 
-    String::String(const char* str)
+    String::String(const char* str, const SourceLocation& location)
     {
         assert(str != nullptr && "Input String cannot be null");
         m_size = std::strlen(str);
@@ -264,16 +474,16 @@ namespace Tina
         else
         {
             heap.m_capacity = m_size + 1;
-            heap.m_data = allocateMemory(heap.m_capacity);
+            heap.m_data = allocateMemory(heap.m_capacity, location);
             std::memcpy(heap.m_data, str, m_size + 1);
         }
     }
 
-    String::String(const std::string& str) : String(str.c_str())
+    String::String(const std::string& str, const SourceLocation& location) : String(str.c_str(), location)
     {
     }
 
-    String::String(std::string_view str)
+    String::String(std::string_view str, const SourceLocation& location)
     {
         m_size = str.size();
         m_isSSO = canUseSSO(m_size);
@@ -286,13 +496,13 @@ namespace Tina
         else
         {
             heap.m_capacity = m_size + 1;
-            heap.m_data = allocateMemory(heap.m_capacity);
+            heap.m_data = allocateMemory(heap.m_capacity, location);
             std::memcpy(heap.m_data, str.data(), m_size);
             heap.m_data[m_size] = '\0';
         }
     }
 
-    String::String(const char* str, size_t length) {
+    String::String(const char* str, size_t length, const SourceLocation& location) {
         if (str == nullptr) {
             m_isSSO = true;
             m_size = 0;
@@ -308,7 +518,7 @@ namespace Tina
         } else {
             m_isSSO = false;
             heap.m_capacity = m_size + 1;
-            heap.m_data = allocateMemory(heap.m_capacity);
+            heap.m_data = allocateMemory(heap.m_capacity, location);
             std::memcpy(heap.m_data, str, m_size);
             heap.m_data[m_size] = '\0';
         }
@@ -344,7 +554,7 @@ namespace Tina
         other.sso.data[0] = '\0';
     }
 
-    void String::copyFrom(const String& other)
+    void String::copyFrom(const String& other, const SourceLocation& location)
     {
         if (m_isSSO)
         {
@@ -353,7 +563,7 @@ namespace Tina
         else
         {
             heap.m_capacity = other.heap.m_capacity;
-            heap.m_data = allocateMemory(heap.m_capacity);
+            heap.m_data = allocateMemory(heap.m_capacity, location);
             std::memcpy(heap.m_data, other.heap.m_data, m_size + 1);
         }
     }
@@ -368,7 +578,7 @@ namespace Tina
             }
             m_size = other.m_size;
             m_isSSO = other.m_isSSO;
-            copyFrom(other);
+            copyFrom(other, SourceLocation::current());
         }
         return *this;
     }
@@ -388,7 +598,7 @@ namespace Tina
         return *this;
     }
 
-    void String::reserve(size_t newCapacity) {
+    void String::reserve(size_t newCapacity, const SourceLocation& location) {
         fmt::print("reserve({}): current m_isSSO={}, current capacity={}\n",
                    newCapacity, m_isSSO, getCapacity());
 
@@ -400,14 +610,14 @@ namespace Tina
         if (m_isSSO) {
             if (newCapacity > SSO_CAPACITY) {
                 fmt::print("  -> Switching to heap with capacity {}\n", newCapacity);
-                switchToHeap(newCapacity);
+                switchToHeap(newCapacity, location);
             } else {
                 fmt::print("  -> Staying in SSO mode\n");
             }
         } else {
             fmt::print("  -> Reallocating on heap from {} to {}\n",
                       heap.m_capacity, newCapacity);
-            char* newData = allocateMemory(newCapacity);
+            char* newData = allocateMemory(newCapacity, location);
             std::memcpy(newData, heap.m_data, m_size + 1);
             deallocateMemory(heap.m_data, heap.m_capacity);
             heap.m_data = newData;
@@ -415,9 +625,9 @@ namespace Tina
         }
     }
 
-    void String::switchToHeap(size_t newCapacity)
+    void String::switchToHeap(size_t newCapacity, const SourceLocation& location)
     {
-        char* newData = allocateMemory(newCapacity);
+        char* newData = allocateMemory(newCapacity, location);
         std::memcpy(newData, sso.data, m_size + 1);
         heap.m_data = newData;
         heap.m_capacity = newCapacity;
@@ -436,7 +646,7 @@ namespace Tina
         }
     }
 
-    void String::shrink_to_fit()
+    void String::shrink_to_fit(const SourceLocation& location)
     {
         if (m_isSSO) return;
 
@@ -446,7 +656,7 @@ namespace Tina
         }
         else if (heap.m_capacity > m_size + 1)
         {
-            char* newData = allocateMemory(m_size + 1);
+            char* newData = allocateMemory(m_size + 1, location);
             std::memcpy(newData, heap.m_data, m_size + 1);
             deallocateMemory(heap.m_data, heap.m_capacity);
             heap.m_data = newData;
@@ -454,11 +664,11 @@ namespace Tina
         }
     }
 
-    void String::resize(size_t newSize, char ch)
+    void String::resize(size_t newSize, char ch, const SourceLocation& location)
     {
         if (newSize > getCapacity())
         {
-            reserve(std::max(newSize, getCapacity() * 2));
+            reserve(std::max(newSize, getCapacity() * 2), location);
         }
 
         char* data = getDataPtr();
@@ -496,13 +706,13 @@ namespace Tina
                 if (m_isSSO)
                 {
                     size_t newCapacity = std::max(newSize + 1, SSO_CAPACITY * 2);
-                    switchToHeap(newCapacity);
+                    switchToHeap(newCapacity, SourceLocation::current());
                 }
                 else
                 {
                     // 已经在堆上，继续扩容
                     size_t newCapacity = std::max(newSize + 1, heap.m_capacity * 2);
-                    char* newData = allocateMemory(newCapacity);
+                    char* newData = allocateMemory(newCapacity, SourceLocation::current());
                     std::memcpy(newData, heap.m_data, m_size + 1);
                     deallocateMemory(heap.m_data, heap.m_capacity);
                     heap.m_data = newData;
@@ -607,13 +817,14 @@ namespace Tina
     bool String::operator==(const String& other) const
     {
         if (m_size != other.m_size) return false;
-        return std::memcmp(getDataPtr(), other.getDataPtr(), m_size) == 0;
+        return StringSearch::equals(getDataPtr(), other.getDataPtr(), m_size);
     }
 
     bool String::operator==(const char* str) const
     {
         if (!str) return m_size == 0;
-        return std::strcmp(getDataPtr(), str) == 0;
+        const size_t length = std::strlen(str);
+        return length == m_size && StringSearch::equals(getDataPtr(), str, m_size);
     }
 
     bool String::operator!=(const String& other) const
@@ -637,81 +848,99 @@ namespace Tina
     // 查找方法
     size_t String::find(const String& str, size_t pos) const
     {
-        if (pos > m_size) return npos;
-        const char* found = std::strstr(getDataPtr() + pos, str.getDataPtr());
-        return found ? found - getDataPtr() : npos;
+        return find(str.getDataPtr(), pos, str.size());
     }
 
     size_t String::find(const char* str, size_t pos) const
     {
-        if (!str || pos > m_size) return npos;
-        const char* found = std::strstr(getDataPtr() + pos, str);
-        return found ? found - getDataPtr() : npos;
+        if (!str) return npos;
+        return find(str, pos, std::strlen(str));
     }
 
-    size_t String::rfind(const String& str, size_t pos) const
+    size_t String::find(const char* str, size_t pos, size_t length) const
     {
-        if (str.empty()) return pos > m_size ? m_size : pos;
-        if (str.size() > m_size) return npos;
+        if (pos > m_size) return npos;
+        const size_t found = StringSearch::find(getDataPtr() + pos, m_size - pos, str, length);
+        return found == StringSearch::npos ? npos : found + pos;
+    }
 
-        pos = std::min(pos, m_size - str.size());
-        for (size_t i = pos + 1; i-- > 0;)
-        {
-            if (std::memcmp(getDataPtr() + i, str.getDataPtr(), str.size()) == 0)
-            {
-                return i;
-            }
-        }
-        return npos;
+    size_t String::find(char ch, size_t pos) const
+    {
+        if (pos >= m_size) return npos;
+        const size_t found = StringSearch::findByte(getDataPtr() + pos, m_size - pos, ch);
+        return found == StringSearch::npos ? npos : found + pos;
+    }
+
+    size_t String::rfind(const String& str, size_t pos) const
+    {
+        return rfind(str.getDataPtr(), pos, str.size());
     }
 
     size_t String::rfind(const char* str, size_t pos) const
     {
-        return rfind(String(str), pos);
+        if (!str) return npos;
+        return rfind(str, pos, std::strlen(str));
+    }
+
+    size_t String::rfind(const char* str, size_t pos, size_t length) const
+    {
+        if (length == 0) return pos > m_size ? m_size : pos;
+        if (length > m_size) return npos;
+
+        // 匹配的起点不超过 pos，因此只需在 [0, pos + length) 范围内查找
+        const size_t start = std::min(pos, m_size - length);
+        return StringSearch::rfind(getDataPtr(), start + length, str, length);
+    }
+
+    size_t String::rfind(char ch, size_t pos) const
+    {
+        if (m_size == 0) return npos;
+        const size_t end = std::min(pos, m_size - 1) + 1;
+        return StringSearch::rfindByte(getDataPtr(), end, ch);
     }
 
     // 子串操作
-    String String::substr(size_t pos, size_t len) const
+    String String::substr(size_t pos, size_t len, const SourceLocation& location) const
     {
         if (pos > m_size) throw std::out_of_range("String::substr");
         len = std::min(len, m_size - pos);
-        return String(std::string_view(getDataPtr() + pos, len));
+        return String(std::string_view(getDataPtr() + pos, len), location);
     }
 
-    void String::append(const char* str, size_t n)
+    void String::append(const char* str, size_t n, const SourceLocation& location)
     {
         if (!str || n == 0) return;
         size_t newSize = m_size + n;
         if (newSize + 1 > getCapacity())
         {
-            reserve(std::max(newSize + 1, getCapacity() * 2));
+            reserve(std::max(newSize + 1, getCapacity() * 2), location);
         }
         std::memcpy(getDataPtr() + m_size, str, n);
         m_size = newSize;
         getDataPtr()[m_size] = '\0';
     }
 
-    void String::append(const String& str)
+    void String::append(const String& str, const SourceLocation& location)
     {
-        append(str.getDataPtr(), str.size());
+        append(str.getDataPtr(), str.size(), location);
     }
 
-    void String::insert(size_t pos, const String& str)
+    void String::insert(size_t pos, const String& str, const SourceLocation& location)
     {
         if (pos > m_size) throw std::out_of_range("String::insert");
         size_t newSize = m_size + str.size();
         if (newSize + 1 > getCapacity())
         {
-            reserve(std::max(newSize + 1, getCapacity() * 2));
+            reserve(std::max(newSize + 1, getCapacity() * 2), location);
         }
         std::memmove(getDataPtr() + pos + str.size(), getDataPtr() + pos, m_size - pos + 1);
         std::memcpy(getDataPtr() + pos, str.getDataPtr(), str.size());
         m_size = newSize;
     }
 
-    void String::insert(size_t pos, const char* str)
+    void String::insert(size_t pos, const char* str, const SourceLocation& location)
     {
-        insert(pos, String(str));
+        insert(pos, String(str, location), location);
     }
 
     void String::erase(size_t pos, size_t len)
@@ -729,7 +958,7 @@ namespace Tina
         }
     }
 
-    void String::replace(size_t pos, size_t len, const String& str)
+    void String::replace(size_t pos, size_t len, const String& str, const SourceLocation& location)
     {
         if (pos > m_size) throw std::out_of_range("String::replace");
         if (len == npos || pos + len > m_size)
@@ -740,7 +969,7 @@ namespace Tina
         size_t newSize = m_size - len + str.size();
         if (newSize + 1 > getCapacity())
         {
-            reserve(std::max(newSize + 1, getCapacity() * 2));
+            reserve(std::max(newSize + 1, getCapacity() * 2), location);
         }
 
         std::memmove(getDataPtr() + pos + str.size(),
@@ -751,8 +980,8 @@ namespace Tina
         tryToSwitchToSSO();
     }
 
-    void String::replace(size_t pos, size_t len, const char* str)
+    void String::replace(size_t pos, size_t len, const char* str, const SourceLocation& location)
     {
-        replace(pos, len, String(str));
+        replace(pos, len, String(str, location), location);
     }
 }
@@ -8,10 +8,12 @@
 #include <string>
 #include <string_view>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <stdexcept>
 #include <vector>
 #include <fmt/base.h>
+#include "SourceLocation.hpp"
 
 namespace Tina
 {
@@ -20,14 +22,17 @@ namespace Tina
     class String
     {
     public:
+        // 会申请内存的公开接口以默认参数 location 取得调用方的位置，内存统计（TrackMemory）记到那里。
+        // 运算符无法附加参数，其中的分配记到 String.cpp 内的位置
+
         // 构造函数
         String();
-        String(const String& other);
-        explicit String(const char* str);
-        explicit String(const std::string& str);
-        explicit String(std::string_view str);
+        String(const String& other, const SourceLocation& location = SourceLocation::current());
+        explicit String(const char* str, const SourceLocation& location = SourceLocation::current());
+        explicit String(const std::string& str, const SourceLocation& location = SourceLocation::current());
+        explicit String(std::string_view str, const SourceLocation& location = SourceLocation::current());
         String(String&& other) noexcept;
-        String(const char* str, size_t length);
+        String(const char* str, size_t length, const SourceLocation& location = SourceLocation::current());
 
         ~String();
 
@@ -59,25 +64,32 @@ namespace Tina
 
         // 修改方法
         void clear();
-        void reserve(size_t capacity);
-        void resize(size_t newSize, char ch = '\0');
-        void shrink_to_fit();
+        void reserve(size_t capacity, const SourceLocation& location = SourceLocation::current());
+        void resize(size_t newSize, char ch = '\0', const SourceLocation& location = SourceLocation::current());
+        void shrink_to_fit(const SourceLocation& location = SourceLocation::current());
 
         // 查找方法
         size_t find(const String& str, size_t pos = 0) const;
         size_t find(const char* str, size_t pos = 0) const;
+        size_t find(const char* str, size_t pos, size_t length) const;
+        size_t find(char ch, size_t pos = 0) const;
         size_t rfind(const String& str, size_t pos = npos) const;
         size_t rfind(const char* str, size_t pos = npos) const;
+        size_t rfind(const char* str, size_t pos, size_t length) const;
+        size_t rfind(char ch, size_t pos = npos) const;
 
         // 子串操作
-        String substr(size_t pos = 0, size_t len = npos) const;
-        void append(const char* str, size_t n);
-        void append(const String& str);
-        void insert(size_t pos, const String& str);
-        void insert(size_t pos, const char* str);
+        String substr(size_t pos = 0, size_t len = npos,
+                      const SourceLocation& location = SourceLocation::current()) const;
+        void append(const char* str, size_t n, const SourceLocation& location = SourceLocation::current());
+        void append(const String& str, const SourceLocation& location = SourceLocation::current());
+        void insert(size_t pos, const String& str, const SourceLocation& location = SourceLocation::current());
+        void insert(size_t pos, const char* str, const SourceLocation& location = SourceLocation::current());
         void erase(size_t pos = 0, size_t len = npos);
-        void replace(size_t pos, size_t len, const String& str);
-        void replace(size_t pos, size_t len, const char* str);
+        void replace(size_t pos, size_t len, const String& str,
+                     const SourceLocation& location = SourceLocation::current());
+        void replace(size_t pos, size_t len, const char* str,
+                     const SourceLocation& location = SourceLocation::current());
 
         static constexpr size_t SSO_CAPACITY = 15;
         static constexpr size_t npos = static_cast<size_t>(-1);
@@ -102,15 +114,15 @@ namespace Tina
 
         // 私有辅助方法
         void checkIndex(size_t index) const;
-        char* allocateMemory(size_t size);
+        char* allocateMemory(size_t size, const SourceLocation& location);
         void deallocateMemory(char* ptr, size_t size);
         bool canUseSSO(size_t size) const { return size <= SSO_CAPACITY; }
         char* getDataPtr() { return m_isSSO ? sso.data : heap.m_data; }
         const char* getDataPtr() const { return m_isSSO ? sso.data : heap.m_data; }
         size_t getCapacity() const { return m_isSSO ? SSO_CAPACITY : heap.m_capacity; }
         void moveFrom(String&& other) noexcept;
-        void copyFrom(const String& other);
-        void switchToHeap(size_t newCapacity);
+        void copyFrom(const String& other, const SourceLocation& location);
+        void switchToHeap(size_t newCapacity, const SourceLocation& location);
         void tryToSwitchToSSO();
 
         static StringMemoryPool& getMemoryPool();
@@ -119,6 +131,15 @@ namespace Tina
     inline String operator+(const char* str, const String& other);
 
 
+    /**
+     * 字符串堆内存池。
+     * 按 32/128/512 字节分为三个尺寸类，每类维护侵入式空闲链表，分配和释放都是 O(1)。
+     * 每个线程先从自己的缓存中分配，缓存超过上限时把一批块归还到全局链表，
+     * 缓存为空时从全局链表整体取走一批。全局链表只做 CAS 压入和 exchange 整体取出，不会出现 ABA 问题。
+     * 超过 512 字节的请求直接走 new[]。
+     *
+     * 内存池是进程级单例且刻意不析构，静态 String 对象在程序退出时仍可安全释放。
+     */
     class StringMemoryPool
     {
     public:
@@ -148,42 +169,55 @@ namespace Tina
         static constexpr size_t SMALL_STRING_SIZE = 32;
         static constexpr size_t MEDIUM_STRING_SIZE = 128;
         static constexpr size_t LARGE_STRING_SIZE = 512;
-        static constexpr size_t BLOCK_COUNT = 1024;
+        // 每次向系统申请时切分出的块数
+        static constexpr size_t BLOCK_COUNT = 64;
+        // 线程缓存每次与全局链表交换的块数，缓存达到两倍时归还一批
+        static constexpr size_t CACHE_BATCH_SIZE = 32;
 
-        struct MemoryBlock
-        {
-            char* data;
-            bool used;
-            size_t size;
-        };
-
-        StringMemoryPool();
-        ~StringMemoryPool();
+        StringMemoryPool(const StringMemoryPool&) = delete;
+        StringMemoryPool& operator=(const StringMemoryPool&) = delete;
 
         char* allocate(size_t size);
         void deallocate(char* ptr, size_t size);
         static StringMemoryPool& getInstance();
 
-        const PoolStats& getStats() const;
+        // 汇总所有线程的统计，峰值在汇总时采样
+        PoolStats getStats() const;
 
+        // 只应在没有其他线程使用字符串时调用
         void resetStats();
         void printStats() const;
 
     private:
-        std::vector<MemoryBlock> m_blocks;
-        std::vector<MemoryBlock> m_mediumPool;
-        std::vector<MemoryBlock> m_largePool;
+        static constexpr size_t SIZE_CLASS_COUNT = 3;
+        static constexpr size_t CUSTOM_CLASS = SIZE_CLASS_COUNT;
+
+        struct FreeBlock;
+        struct Chunk;
+        struct StatsRecord;
+        struct ThreadCache;
+
+        StringMemoryPool();
+        ~StringMemoryPool() = default;
+
+        std::atomic<FreeBlock*> m_freeBatches[SIZE_CLASS_COUNT]{};
+        std::atomic<Chunk*> m_chunks{nullptr};
+        std::atomic<StatsRecord*> m_statsRecords{nullptr};
+        StatsRecord* m_sharedStats;
+
+        mutable std::atomic<size_t> m_peakAllocations{0};
+        mutable std::atomic<size_t> m_peakMemoryUsed{0};
+        mutable std::atomic<size_t> m_peakUsage[SIZE_CLASS_COUNT + 1]{};
 
-        PoolStats m_stats;
+        static size_t getSizeClass(size_t size);
+        static size_t getClassSize(size_t sizeClass);
 
-        void updateAllocationStats(size_t size);
-        void updateDeallocationStats(size_t size);
-        void updatePoolStats(PoolStats::PoolTypeStats& stats, bool isAllocation);
+        ThreadCache* getThreadCache();
+        StatsRecord* acquireStatsRecord();
 
-        void initializePool(std::vector<MemoryBlock>& pool, size_t blockSize);
-        void releasePool(std::vector<MemoryBlock>& pool);
-        char* allocateFromPool(std::vector<MemoryBlock>& pool, size_t size);
-        void deallocateToPool(std::vector<MemoryBlock>& pool, const char* ptr);
+        void pushBatch(size_t sizeClass, FreeBlock* first, size_t count);
+        FreeBlock* takeBatch(size_t sizeClass, size_t& count);
+        FreeBlock* carveChunk(size_t sizeClass, size_t& count);
     };
 }
 
@@ -0,0 +1,195 @@
+#include "StringBuilder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+#include "memory/TrackMemory.hpp"
+
+namespace Tina
+{
+    StringBuilder::StringBuilder(size_t chunkSize, const SourceLocation& location)
+        : m_chunkSize(std::max<size_t>(chunkSize, 64)), m_location(location)
+    {
+    }
+
+    StringBuilder::StringBuilder(StringBuilder&& other) noexcept
+        : m_head(std::exchange(other.m_head, nullptr))
+        , m_tail(std::exchange(other.m_tail, nullptr))
+        , m_chunkSize(other.m_chunkSize)
+        , m_size(std::exchange(other.m_size, 0))
+        , m_chunkCount(std::exchange(other.m_chunkCount, 0))
+        , m_location(other.m_location)
+    {
+    }
+
+    StringBuilder& StringBuilder::operator=(StringBuilder&& other) noexcept
+    {
+        if (this != &other)
+        {
+            releaseChunks(m_head);
+            m_head = std::exchange(other.m_head, nullptr);
+            m_tail = std::exchange(other.m_tail, nullptr);
+            m_chunkSize = other.m_chunkSize;
+            m_size = std::exchange(other.m_size, 0);
+            m_chunkCount = std::exchange(other.m_chunkCount, 0);
+            m_location = other.m_location;
+        }
+        return *this;
+    }
+
+    StringBuilder::~StringBuilder()
+    {
+        releaseChunks(m_head);
+    }
+
+    void StringBuilder::appendSlow(std::string_view str)
+    {
+        const char* src = str.data();
+        size_t remaining = str.size();
+
+        while (remaining > 0)
+        {
+            if (m_tail == nullptr || m_tail->size == m_tail->capacity)
+            {
+                // 超长的单次追加直接申请足够大的块，避免切成大量小段
+                Chunk* chunk = allocateChunk(std::max(m_chunkSize, remaining));
+                if (m_tail)
+                {
+                    m_tail->next = chunk;
+                }
+                else
+                {
+                    m_head = chunk;
+                }
+                m_tail = chunk;
+            }
+
+            const size_t count = std::min(remaining, m_tail->capacity - m_tail->size);
+            std::memcpy(m_tail->data() + m_tail->size, src, count);
+            m_tail->size += count;
+            m_size += count;
+            src += count;
+            remaining -= count;
+        }
+    }
+
+    void StringBuilder::append(const char* str)
+    {
+        if (str)
+        {
+            append(std::string_view(str));
+        }
+    }
+
+    void StringBuilder::append(const std::string& str)
+    {
+        append(std::string_view(str));
+    }
+
+    void StringBuilder::append(const String& str)
+    {
+        append(std::string_view(str.c_str(), str.length()));
+    }
+
+    void StringBuilder::append(char c)
+    {
+        if (m_tail && m_tail->size < m_tail->capacity)
+        {
+            m_tail->data()[m_tail->size++] = c;
+            ++m_size;
+            return;
+        }
+        append(std::string_view(&c, 1));
+    }
+
+    void StringBuilder::append(size_t count, char c)
+    {
+        while (count > 0)
+        {
+            if (m_tail == nullptr || m_tail->size == m_tail->capacity)
+            {
+                append(c);
+                --count;
+                continue;
+            }
+            const size_t fill = std::min(count, m_tail->capacity - m_tail->size);
+            std::memset(m_tail->data() + m_tail->size, c, fill);
+            m_tail->size += fill;
+            m_size += fill;
+            count -= fill;
+        }
+    }
+
+    void StringBuilder::clear()
+    {
+        if (m_head)
+        {
+            releaseChunks(m_head->next);
+            m_head->next = nullptr;
+            m_head->size = 0;
+            m_tail = m_head;
+            m_chunkCount = 1;
+        }
+        m_size = 0;
+    }
+
+    std::string StringBuilder::toString() const
+    {
+        std::string result;
+        result.resize(m_size);
+        copyTo(result.data());
+        return result;
+    }
+
+    String StringBuilder::toTinaString(const SourceLocation& location) const
+    {
+        String result;
+        if (m_size > 0)
+        {
+            result.resize(m_size, '\0', location);
+            copyTo(&result[0]);
+        }
+        return result;
+    }
+
+    void StringBuilder::copyTo(char* dest) const
+    {
+        forEachSegment([&dest](std::string_view segment)
+        {
+            std::memcpy(dest, segment.data(), segment.size());
+            dest += segment.size();
+        });
+    }
+
+    std::vector<std::string_view> StringBuilder::getSegments() const
+    {
+        std::vector<std::string_view> segments;
+        segments.reserve(m_chunkCount);
+        forEachSegment([&segments](std::string_view segment)
+        {
+            segments.push_back(segment);
+        });
+        return segments;
+    }
+
+    StringBuilder::Chunk* StringBuilder::allocateChunk(size_t capacity)
+    {
+        void* memory = ::operator new(sizeof(Chunk) + capacity);
+        TINA_TRACK_ALLOC(MemoryTag::String, sizeof(Chunk) + capacity, m_location);
+        ++m_chunkCount;
+        return ::new(memory) Chunk{nullptr, 0, capacity};
+    }
+
+    void StringBuilder::releaseChunks(Chunk* chunk)
+    {
+        while (chunk)
+        {
+            Chunk* next = chunk->next;
+            TINA_TRACK_FREE(MemoryTag::String, sizeof(Chunk) + chunk->capacity);
+            ::operator delete(chunk);
+            --m_chunkCount;
+            chunk = next;
+        }
+    }
+} // Tina
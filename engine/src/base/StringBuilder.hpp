@@ -0,0 +1,124 @@
+#ifndef TINA_BASE_STRINGBUILDER_HPP
+#define TINA_BASE_STRINGBUILDER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "NonCopyable.hpp"
+#include "SourceLocation.hpp"
+#include "String.hpp"
+
+namespace Tina
+{
+    /**
+     * 分段字符串构建器，用于拼接着色器预处理结果、YAML 导出、批量日志这类大文本。
+     * 内容追加到链式的定长块中，块写满后申请新块，已写入的数据永远不会被移动或重新拷贝，
+     * 构建总长为 N 的字符串只需 O(N) 的拷贝。
+     *
+     * 构建完成后可以一次性拷贝为连续字符串（toString/copyTo），
+     * 也可以通过 getSegments()/forEachSegment() 按段输出（类似 iovec），直接写入文件或流而不做拼接。
+     */
+    class StringBuilder : public NonCopyable
+    {
+    public:
+        using value_type = char;
+
+        static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+        // 块的内存统计（TrackMemory）记到创建构建器的位置
+        explicit StringBuilder(size_t chunkSize = DEFAULT_CHUNK_SIZE,
+                               const SourceLocation& location = SourceLocation::current());
+        StringBuilder(StringBuilder&& other) noexcept;
+        StringBuilder& operator=(StringBuilder&& other) noexcept;
+        ~StringBuilder();
+
+        void append(std::string_view str)
+        {
+            // 快速路径：当前块放得下时直接拷贝
+            if (m_tail && str.size() <= m_tail->capacity - m_tail->size)
+            {
+                std::memcpy(m_tail->data() + m_tail->size, str.data(), str.size());
+                m_tail->size += str.size();
+                m_size += str.size();
+                return;
+            }
+            appendSlow(str);
+        }
+
+        void append(const char* str);
+        void append(const std::string& str);
+        void append(const String& str);
+        void append(char c);
+        void append(size_t count, char c);
+
+        // 兼容 std::back_inserter，可直接作为 fmt::format_to 的输出目标
+        void push_back(char c) { append(c); }
+
+        StringBuilder& operator<<(std::string_view str)
+        {
+            append(str);
+            return *this;
+        }
+
+        StringBuilder& operator<<(char c)
+        {
+            append(c);
+            return *this;
+        }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] bool empty() const { return m_size == 0; }
+        [[nodiscard]] size_t getChunkCount() const { return m_chunkCount; }
+
+        // 清空内容，保留第一个块供后续复用
+        void clear();
+
+        // 拷贝为连续字符串，只做一次分配
+        [[nodiscard]] std::string toString() const;
+        [[nodiscard]] String toTinaString(const SourceLocation& location = SourceLocation::current()) const;
+
+        // 拷贝到调用方提供的缓冲区，dest 至少需要 size() 字节（不写入结尾的 '\0'）
+        void copyTo(char* dest) const;
+
+        // 按顺序返回每个块中的有效数据，视图在下一次修改构建器之前有效
+        [[nodiscard]] std::vector<std::string_view> getSegments() const;
+
+        template <typename Func>
+        void forEachSegment(Func&& func) const
+        {
+            for (const Chunk* chunk = m_head; chunk != nullptr; chunk = chunk->next)
+            {
+                if (chunk->size > 0)
+                {
+                    func(std::string_view(chunk->data(), chunk->size));
+                }
+            }
+        }
+
+    private:
+        struct Chunk
+        {
+            Chunk* next;
+            size_t size;
+            size_t capacity;
+
+            char* data() { return reinterpret_cast<char*>(this + 1); }
+            [[nodiscard]] const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+        };
+
+        void appendSlow(std::string_view str);
+        Chunk* allocateChunk(size_t capacity);
+        void releaseChunks(Chunk* chunk);
+
+        Chunk* m_head = nullptr;
+        Chunk* m_tail = nullptr;
+        size_t m_chunkSize;
+        size_t m_size = 0;
+        size_t m_chunkCount = 0;
+        SourceLocation m_location;
+    };
+} // Tina
+
+#endif //TINA_BASE_STRINGBUILDER_HPP
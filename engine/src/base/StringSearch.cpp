@@ -0,0 +1,405 @@
+#include "StringSearch.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "CpuFeatures.hpp"
+
+#if TINA_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+namespace Tina::StringSearch
+{
+    namespace
+    {
+        struct Implementation
+        {
+            SimdLevel level;
+            size_t (*findByte)(const char*, size_t, char);
+            size_t (*rfindByte)(const char*, size_t, char);
+            size_t (*find)(const char*, size_t, const char*, size_t);
+            bool (*equals)(const char*, const char*, size_t);
+        };
+
+        // ---------------------------------------------------------------- 标量实现
+
+        size_t findByteScalar(const char* data, size_t size, char c)
+        {
+            const void* found = std::memchr(data, c, size);
+            return found ? static_cast<size_t>(static_cast<const char*>(found) - data) : npos;
+        }
+
+        size_t rfindByteScalar(const char* data, size_t size, char c)
+        {
+            for (size_t i = size; i-- > 0;)
+            {
+                if (data[i] == c)
+                {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        size_t findScalar(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize)
+        {
+            const size_t last = haystackSize - needleSize;
+            for (size_t i = 0; i <= last;)
+            {
+                const size_t offset = findByteScalar(haystack + i, last - i + 1, needle[0]);
+                if (offset == npos)
+                {
+                    return npos;
+                }
+                i += offset;
+                if (std::memcmp(haystack + i + 1, needle + 1, needleSize - 1) == 0)
+                {
+                    return i;
+                }
+                ++i;
+            }
+            return npos;
+        }
+
+        bool equalsScalar(const char* a, const char* b, size_t size)
+        {
+            return std::memcmp(a, b, size) == 0;
+        }
+
+        constexpr Implementation SCALAR_IMPLEMENTATION{
+            SimdLevel::Scalar, findByteScalar, rfindByteScalar, findScalar, equalsScalar
+        };
+
+#if TINA_SIMD_X86
+        inline uint32_t countTrailingZeros(uint32_t value)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward(&index, value);
+            return index;
+#else
+            return static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+        }
+
+        inline uint32_t highestBit(uint32_t value)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanReverse(&index, value);
+            return index;
+#else
+            return 31u - static_cast<uint32_t>(__builtin_clz(value));
+#endif
+        }
+
+        // ---------------------------------------------------------------- SSE2 实现
+
+        // 候选位置的完整比较，子串通常很短，内联比较比调用 memcmp 便宜
+        inline bool matchesAt(const char* a, const char* b, size_t size)
+        {
+            for (; size >= 16; size -= 16, a += 16, b += 16)
+            {
+                const __m128i blockA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+                const __m128i blockB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB)) != 0xFFFF)
+                {
+                    return false;
+                }
+            }
+            for (; size >= 8; size -= 8, a += 8, b += 8)
+            {
+                uint64_t wordA;
+                uint64_t wordB;
+                std::memcpy(&wordA, a, 8);
+                std::memcpy(&wordB, b, 8);
+                if (wordA != wordB)
+                {
+                    return false;
+                }
+            }
+            for (; size > 0; --size, ++a, ++b)
+            {
+                if (*a != *b)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t rfindByteSSE2(const char* data, size_t size, char c)
+        {
+            const __m128i pattern = _mm_set1_epi8(c);
+            size_t i = size;
+            while (i >= 64)
+            {
+                const char* block = data + i - 64;
+                const __m128i m0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), pattern);
+                const __m128i m1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16)), pattern);
+                const __m128i m2 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32)), pattern);
+                const __m128i m3 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48)), pattern);
+                if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3))) != 0)
+                {
+                    break;
+                }
+                i -= 64;
+            }
+            while (i >= 16)
+            {
+                i -= 16;
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+                if (mask != 0)
+                {
+                    return i + highestBit(mask);
+                }
+            }
+            return rfindByteScalar(data, i, c);
+        }
+
+        // 同时比较子串的首字节、中间字节和末字节，只有三者都命中的位置才做完整比较
+        size_t findSSE2(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize)
+        {
+            const size_t middleOffset = needleSize / 2;
+            const __m128i first = _mm_set1_epi8(needle[0]);
+            const __m128i middle = _mm_set1_epi8(needle[middleOffset]);
+            const __m128i last = _mm_set1_epi8(needle[needleSize - 1]);
+
+            size_t i = 0;
+            for (; i + needleSize - 1 + 16 <= haystackSize; i += 16)
+            {
+                const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+                const __m128i blockMiddle = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(haystack + i + middleOffset));
+                const __m128i blockLast = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(haystack + i + needleSize - 1));
+                auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+                    _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockMiddle, middle)),
+                    _mm_cmpeq_epi8(blockLast, last))));
+                while (mask != 0)
+                {
+                    const size_t candidate = i + countTrailingZeros(mask);
+                    if (needleSize <= 2 || matchesAt(haystack + candidate + 1, needle + 1, needleSize - 2))
+                    {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+
+            if (i + needleSize <= haystackSize)
+            {
+                const size_t offset = findScalar(haystack + i, haystackSize - i, needle, needleSize);
+                return offset == npos ? npos : i + offset;
+            }
+            return npos;
+        }
+
+        // 正向找字节和相等比较直接使用 memchr/memcmp：主流 C 运行库已经做了向量化，实测手写版本并不更快
+        constexpr Implementation SSE2_IMPLEMENTATION{
+            SimdLevel::SSE2, findByteScalar, rfindByteSSE2, findSSE2, equalsScalar
+        };
+
+        // ---------------------------------------------------------------- AVX2 实现
+
+        TINA_TARGET_AVX2 size_t rfindByteAVX2(const char* data, size_t size, char c)
+        {
+            const __m256i pattern = _mm256_set1_epi8(c);
+            size_t i = size;
+            while (i >= 128)
+            {
+                const char* block = data + i - 128;
+                const __m256i m0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), pattern);
+                const __m256i m1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32)), pattern);
+                const __m256i m2 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 64)), pattern);
+                const __m256i m3 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 96)), pattern);
+                if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3)),
+                                        _mm256_set1_epi8(-1)))
+                {
+                    break;
+                }
+                i -= 128;
+            }
+            while (i >= 32)
+            {
+                i -= 32;
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+                if (mask != 0)
+                {
+                    return i + highestBit(mask);
+                }
+            }
+            _mm256_zeroupper();
+            return rfindByteSSE2(data, i, c);
+        }
+
+        TINA_TARGET_AVX2 size_t findAVX2(const char* haystack, size_t haystackSize, const char* needle,
+                                         size_t needleSize)
+        {
+            const size_t middleOffset = needleSize / 2;
+            const __m256i first = _mm256_set1_epi8(needle[0]);
+            const __m256i middle = _mm256_set1_epi8(needle[middleOffset]);
+            const __m256i last = _mm256_set1_epi8(needle[needleSize - 1]);
+
+            size_t i = 0;
+            for (; i + needleSize - 1 + 32 <= haystackSize; i += 32)
+            {
+                const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+                const __m256i blockMiddle = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(haystack + i + middleOffset));
+                const __m256i blockLast = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(haystack + i + needleSize - 1));
+                auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockMiddle, middle)),
+                    _mm256_cmpeq_epi8(blockLast, last))));
+                while (mask != 0)
+                {
+                    const size_t candidate = i + countTrailingZeros(mask);
+                    if (needleSize <= 2 || matchesAt(haystack + candidate + 1, needle + 1, needleSize - 2))
+                    {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+
+            if (i + needleSize <= haystackSize)
+            {
+                _mm256_zeroupper();
+                const size_t offset = findSSE2(haystack + i, haystackSize - i, needle, needleSize);
+                return offset == npos ? npos : i + offset;
+            }
+            return npos;
+        }
+
+        constexpr Implementation AVX2_IMPLEMENTATION{
+            SimdLevel::AVX2, findByteScalar, rfindByteAVX2, findAVX2, equalsScalar
+        };
+#endif
+
+        SimdLevel detectSimdLevel()
+        {
+#if TINA_SIMD_X86
+            return CpuFeatures::hasAVX2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        const Implementation* getImplementationFor(SimdLevel level)
+        {
+#if TINA_SIMD_X86
+            switch (level)
+            {
+            case SimdLevel::AVX2:
+                return &AVX2_IMPLEMENTATION;
+            case SimdLevel::SSE2:
+                return &SSE2_IMPLEMENTATION;
+            default:
+                break;
+            }
+#endif
+            (void)level;
+            return &SCALAR_IMPLEMENTATION;
+        }
+
+        std::atomic<const Implementation*>& currentImplementation()
+        {
+            static std::atomic<const Implementation*> implementation{getImplementationFor(detectSimdLevel())};
+            return implementation;
+        }
+
+        inline const Implementation& impl()
+        {
+            return *currentImplementation().load(std::memory_order_relaxed);
+        }
+    }
+
+    size_t findByte(const char* data, size_t size, char c)
+    {
+        return impl().findByte(data, size, c);
+    }
+
+    size_t rfindByte(const char* data, size_t size, char c)
+    {
+        return impl().rfindByte(data, size, c);
+    }
+
+    size_t find(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize)
+    {
+        if (needleSize == 0)
+        {
+            return 0;
+        }
+        if (needleSize > haystackSize)
+        {
+            return npos;
+        }
+        if (needleSize == 1)
+        {
+            return impl().findByte(haystack, haystackSize, needle[0]);
+        }
+        return impl().find(haystack, haystackSize, needle, needleSize);
+    }
+
+    size_t rfind(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize)
+    {
+        if (needleSize == 0)
+        {
+            return haystackSize;
+        }
+        if (needleSize > haystackSize)
+        {
+            return npos;
+        }
+
+        // 反向扫描首字节，命中后再比较整个子串
+        const Implementation& implementation = impl();
+        size_t limit = haystackSize - needleSize + 1;
+        while (limit > 0)
+        {
+            const size_t candidate = implementation.rfindByte(haystack, limit, needle[0]);
+            if (candidate == npos)
+            {
+                return npos;
+            }
+            if (std::memcmp(haystack + candidate + 1, needle + 1, needleSize - 1) == 0)
+            {
+                return candidate;
+            }
+            limit = candidate;
+        }
+        return npos;
+    }
+
+    bool equals(const char* a, const char* b, size_t size)
+    {
+        return impl().equals(a, b, size);
+    }
+
+    SimdLevel getSimdLevel()
+    {
+        return impl().level;
+    }
+
+    SimdLevel getSupportedSimdLevel()
+    {
+        static const SimdLevel supported = detectSimdLevel();
+        return supported;
+    }
+
+    void setSimdLevel(SimdLevel level)
+    {
+        if (static_cast<int>(level) > static_cast<int>(getSupportedSimdLevel()))
+        {
+            level = getSupportedSimdLevel();
+        }
+        currentImplementation().store(getImplementationFor(level), std::memory_order_relaxed);
+    }
+} // Tina::StringSearch
@@ -0,0 +1,39 @@
+#ifndef TINA_BASE_STRINGSEARCH_HPP
+#define TINA_BASE_STRINGSEARCH_HPP
+
+#include <cstddef>
+
+namespace Tina::StringSearch
+{
+    /**
+     * 字符串查找与比较的底层实现，供 String 使用。
+     * x86 上为反向查找和子串查找提供 SSE2/AVX2 两套实现，首次调用时按 CPU 支持情况选择，其他平台使用标量实现。
+     * 所有函数只按长度访问内存，不依赖 '\0' 结尾，也不会越界读取。
+     */
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    inline constexpr size_t npos = static_cast<size_t>(-1);
+
+    // 返回 size 字节中第一个/最后一个等于 c 的位置，找不到返回 npos
+    size_t findByte(const char* data, size_t size, char c);
+    size_t rfindByte(const char* data, size_t size, char c);
+
+    // 子串查找，needleSize 为 0 时返回 0
+    size_t find(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize);
+    // 返回最后一次出现的位置，needleSize 为 0 时返回 haystackSize
+    size_t rfind(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize);
+
+    bool equals(const char* a, const char* b, size_t size);
+
+    // 当前使用的实现级别；setSimdLevel 用于测试和基准，请求的级别会被限制在 CPU 支持的范围内
+    SimdLevel getSimdLevel();
+    SimdLevel getSupportedSimdLevel();
+    void setSimdLevel(SimdLevel level);
+} // Tina::StringSearch
+
+#endif //TINA_BASE_STRINGSEARCH_HPP
@@ -20,6 +20,7 @@ namespace Tina
             checkFile.close();
 
             m_data.clear();
+            m_lookupCache.clear();
             std::cout << "Cleared existing config data" << std::endl;
 
             try {
@@ -118,8 +119,56 @@ namespace Tina
     }
 
 
+    bool Config::contains(const InternedString& key) const
+    {
+        return findCached(key) != nullptr;
+    }
+
+    YamlValuePtr Config::getValue(const std::string& key) const
+    {
+        return findValue(key);
+    }
+
+    YamlValuePtr Config::findValue(std::string_view key) const
+    {
+        const std::unordered_map<std::string, YamlValuePtr>* currentMap = &m_data;
+        size_t start = 0;
+        while (true)
+        {
+            const size_t end = key.find('.', start);
+            const std::string part(key.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+
+            const auto it = currentMap->find(part);
+            if (it == currentMap->end() || !it->second)
+            {
+                return nullptr;
+            }
+            if (end == std::string_view::npos)
+            {
+                return it->second;
+            }
+            if (!std::holds_alternative<std::unordered_map<std::string, YamlValuePtr>>(it->second->data))
+            {
+                return nullptr;
+            }
+            currentMap = &std::get<std::unordered_map<std::string, YamlValuePtr>>(it->second->data);
+            start = end + 1;
+        }
+    }
+
+    const YamlValuePtr& Config::findCached(const InternedString& key) const
+    {
+        if (const auto it = m_lookupCache.find(key); it != m_lookupCache.end())
+        {
+            return it->second;
+        }
+        // 不存在的键同样缓存（值为空），避免反复解析
+        return m_lookupCache.emplace(key, findValue(key.view())).first->second;
+    }
+
     void Config::setNested(const std::vector<std::string>& keys, const YamlValue& value)
     {
+        m_lookupCache.clear();
         std::unordered_map<std::string, YamlValuePtr>* currentMap = &m_data;
         for (size_t i = 0; i < keys.size() - 1; ++i)
         {
@@ -2,6 +2,7 @@
 #define TINA_CORE_CONFIG_HPP
 
 #include "YamlParser.hpp"
+#include "base/InternedString.hpp"
 
 namespace Tina
 {
@@ -24,8 +25,23 @@ namespace Tina
 
         bool contains(const std::string& key) const;
 
+        // 热路径查询：解析结果按驻留键缓存，重复查询只是一次整数键的哈希查找
+        template <typename T>
+        T get(const InternedString& key) const;
+
+        bool contains(const InternedString& key) const;
+
+        // 原始的 YAML 值，用于遍历某一节下的所有键；不存在时返回 nullptr
+        YamlValuePtr getValue(const std::string& key) const;
+
     protected:
         std::unordered_map<std::string, YamlValuePtr> m_data;
+        // 完整键（如 "window.width"）到值的缓存，加载或修改配置时清空
+        mutable std::unordered_map<InternedString, YamlValuePtr> m_lookupCache;
+
+        // 按 '.' 分割的路径查找值，不存在时返回 nullptr
+        YamlValuePtr findValue(std::string_view key) const;
+        const YamlValuePtr& findCached(const InternedString& key) const;
 
         // Helper functions to get nested values and convert YamlValue to T
         template <typename T>
@@ -67,6 +83,17 @@ namespace Tina
         throw std::runtime_error("Key not found: " + key);
     }
 
+    template <typename T>
+    T Config::get(const InternedString& key) const
+    {
+        const YamlValuePtr& value = findCached(key);
+        if (!value)
+        {
+            throw std::runtime_error("Key not found: " + std::string(key.view()));
+        }
+        return convertTo<T>(value);
+    }
+
     template <typename T>
     void Config::set(const std::string& key, const T& value)
     {
@@ -8,6 +8,7 @@
 #include "graphics/Color.hpp"
 #include "window/GLFWWindow.hpp"
 #include "core/Config.hpp"
+#include "memory/TrackMemory.hpp"
 #include <bgfx/bgfx.h>
 #include <fmt/format.h>
 
@@ -15,12 +16,14 @@
 
 namespace Tina
 {
-    GameApplication::GameApplication() : m_lastFrameTime(0.0f), m_configPath("")
+    GameApplication::GameApplication() : m_frameAllocator(std::make_unique<LinearAllocator>(FRAME_ALLOCATOR_SIZE, SourceLocation::current())),
+                                         m_lastFrameTime(0.0f), m_configPath("")
     {
     }
 
     GameApplication::GameApplication(const Path& configPath)
-        : m_lastFrameTime(0.0f)
+        : m_frameAllocator(std::make_unique<LinearAllocator>(FRAME_ALLOCATOR_SIZE, SourceLocation::current()))
+        , m_lastFrameTime(0.0f)
         , m_configPath(configPath)
     {
     }
@@ -42,11 +45,11 @@ namespace Tina
         windowConfig.vsync = true;
 
         // 如果有配置文件，从配置文件读取配置
+        Config config;
         if (m_configPath.exists())
         {
             try 
             {
-                Config config;
                 config.loadFromFile(m_configPath.toString());
 
                 if (config.contains("window.title"))
@@ -75,9 +78,33 @@ namespace Tina
         // 创建GUI系统
         // m_guiSystem = std::make_unique<GuiSystem>();
 
+        // 资源管理器需要在 bgfx 初始化之后创建
+        m_resourceManager = std::make_unique<ResourceManager>();
+#ifdef DEBUG
+        // 调试构建中修改资源文件后自动重新加载
+        m_resourceManager->setHotReloadEnabled(true);
+#else
+        // 发布构建中存在资源包（resource_pack 目标生成）时优先从包中加载
+        if (Path(RESOURCE_PACK_PATH).exists())
+        {
+            m_resourceManager->mountPack(RESOURCE_PACK_PATH);
+        }
+#endif
+        // 小的精灵纹理合并到图集中，交错绘制时不必切换纹理。
+        // sprites 目录不参与构建时的纹理转换（见 cmake/CompileTextures.cmake），运行时解码得到图集需要的 RGBA8
+        m_resourceManager->enableTextureAtlas("../resources/textures/sprites/");
+        // 配置中的资源组，由游戏代码按需调用 loadResourceGroup
+        m_resourceManager->defineResourceGroups(config);
+
         // 创建2D渲染器
         m_renderer2D = std::make_unique<Renderer2D>(0);  // 使用视图0
         m_renderer2D->initialize();
+        // 整帧排序后按实例提交，不同纹理交错绘制时也只按状态切换的次数提交；不支持实例化时退回 Sorted
+        m_renderer2D->setBatchMode(Renderer2D::BatchMode::Instanced);
+        // 工作线程各自录制到一个上下文，大量精灵的顶点数据也由这些线程分段写出
+        m_threadPool = std::make_unique<ThreadPool>();
+        m_renderer2D->setThreadPool(m_threadPool.get());
+        m_renderer2D->setRecordContextCount(m_threadPool->getThreadCount());
 
         // 创建正交相机
         float width = static_cast<float>(windowConfig.resolution.width);
@@ -109,10 +136,16 @@ namespace Tina
     {
         while (m_window && !m_window->shouldClose())
         {
+            // 上一帧的临时分配全部作废
+            m_frameAllocator->reset();
+
             float currentTime = static_cast<float>(glfwGetTime());
             float deltaTime = currentTime - m_lastFrameTime;
             m_lastFrameTime = currentTime;
 
+            // 上传后台线程已解码完成的资源，重新加载修改过的资源文件
+            m_resourceManager->update();
+
             update(deltaTime);
             render();
 
@@ -120,6 +153,11 @@ namespace Tina
             bgfx::frame();
 
             m_window->pollEvents();
+
+#ifdef TRACK_MEMORY
+            // 每帧汇总一次各线程的计数，用于记录峰值
+            TrackMemory::sample();
+#endif
         }
     }
 
@@ -188,11 +226,27 @@ namespace Tina
 
     void GameApplication::shutdown()
     {
+#ifdef TRACK_MEMORY
+        TrackMemory::dumpStats();
+        TrackMemory::dumpTopCallSites();
+#endif
+
         if (m_renderer2D)
         {
             m_renderer2D.reset();
         }
 
+        if (m_threadPool)
+        {
+            m_threadPool.reset();
+        }
+
+        // 必须在窗口（以及 bgfx）销毁之前释放 GPU 资源
+        if (m_resourceManager)
+        {
+            m_resourceManager.reset();
+        }
+
         // if (m_guiSystem)
         // {
         //     m_guiSystem.reset();
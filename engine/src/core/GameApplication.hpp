@@ -9,6 +9,9 @@
 #include "graphics/Renderer2D.hpp"
 #include "graphics/Camera.hpp"
 #include "filesystem/Path.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "core/ThreadPool.hpp"
+#include "resource/ResourceManager.hpp"
 
 namespace Tina
 {
@@ -21,6 +24,19 @@ namespace Tina
 
         void run();
 
+        // 每帧临时内存，在主循环每次迭代开始时整体回收
+        LinearAllocator& getFrameAllocator() { return *m_frameAllocator; }
+
+        // 在 initialize() 之后可用，异步加载的资源在每帧开始时上传
+        ResourceManager& getResourceManager() { return *m_resourceManager; }
+
+        // 帧内并行任务使用的工作线程，Renderer2D 为每个线程准备了一个录制上下文
+        ThreadPool& getThreadPool() { return *m_threadPool; }
+
+        // 相对于运行目录，与 "../resources/" 下的资源路径对应
+        static constexpr const char* RESOURCE_PACK_PATH = "../resources.pak";
+        static constexpr size_t FRAME_ALLOCATOR_SIZE = 4 * 1024 * 1024;
+
     protected:
         virtual void initialize();
         virtual void update(float deltaTime);
@@ -30,9 +46,13 @@ namespace Tina
         void mainLoop();
 
         std::unique_ptr<IWindow> m_window;
+        // Renderer2D 持有它的指针，需要在 Renderer2D 之后销毁
+        std::unique_ptr<ThreadPool> m_threadPool;
         // std::unique_ptr<GuiSystem> m_guiSystem;
         std::unique_ptr<Renderer2D> m_renderer2D;
         std::unique_ptr<OrthographicCamera> m_camera;  // 默认使用正交相机
+        std::unique_ptr<LinearAllocator> m_frameAllocator;
+        std::unique_ptr<ResourceManager> m_resourceManager;
         float m_lastFrameTime;
         Path m_configPath;
     };
@@ -2,6 +2,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <utility>
 
 namespace Tina {
     Shader::Shader(const std::string &name) {
@@ -12,7 +13,7 @@ namespace Tina {
         destory();
     }
 
-    void Shader::loadFromFile(const std::string &name) {
+    std::string Shader::getBinaryPath(const std::string &name, const char *stage) const {
         std::string suffix;
         switch (bgfx::getRendererType()) {
             case bgfx::RendererType::OpenGL:
@@ -34,9 +35,12 @@ namespace Tina {
             default:
                 suffix = "dx10";
         }
+        return SHADER_PATH + suffix + "/" + name + "." + stage + ".bin";
+    }
 
-        std::string vsPath = SHADER_PATH + suffix + "/" + name + ".vs.bin";
-        std::string fsPath = SHADER_PATH + suffix + "/" + name + ".fs.bin";
+    void Shader::loadFromFile(const std::string &name) {
+        std::string vsPath = getBinaryPath(name, "vs");
+        std::string fsPath = getBinaryPath(name, "fs");
 
         std::cout << "Loading vertex shader from: " << vsPath << std::endl;
         std::cout << "Loading fragment shader from: " << fsPath << std::endl;
@@ -54,6 +58,9 @@ namespace Tina {
         }
 
         m_program = bgfx::createProgram(m_vertexShader, m_fragmentShader, true);
+        // destroyShaders 为 true 时着色器归程序所有，destory 中不能再销毁一次
+        m_vertexShader = BGFX_INVALID_HANDLE;
+        m_fragmentShader = BGFX_INVALID_HANDLE;
         if (!bgfx::isValid(m_program)) {
             std::cerr << "Failed to create shader program" << std::endl;
         }
@@ -83,10 +90,35 @@ namespace Tina {
         return bgfx::createShader(mem);
     }
 
-    bool Shader::isValid() const {
+    bool Shader::createFromMemory(const bgfx::Memory *vertex, const bgfx::Memory *fragment) {
+        m_vertexShader = bgfx::createShader(vertex);
+        m_fragmentShader = bgfx::createShader(fragment);
+        if (!bgfx::isValid(m_vertexShader) || !bgfx::isValid(m_fragmentShader)) {
+            std::cerr << "Failed to create shader from memory" << std::endl;
+            destory();
+            return false;
+        }
+
+        m_program = bgfx::createProgram(m_vertexShader, m_fragmentShader, true);
+        m_vertexShader = BGFX_INVALID_HANDLE;
+        m_fragmentShader = BGFX_INVALID_HANDLE;
+        if (!bgfx::isValid(m_program)) {
+            std::cerr << "Failed to create shader program" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+        bool Shader::isValid() const {
         return bgfx::isValid(m_program);
     }
 
+    void Shader::swap(Shader &other) noexcept {
+        std::swap(m_vertexShader, other.m_vertexShader);
+        std::swap(m_fragmentShader, other.m_fragmentShader);
+        std::swap(m_program, other.m_program);
+    }
+
     void Shader::destory() {
         if (bgfx::isValid(m_vertexShader)) {
             bgfx::destroy(m_vertexShader);
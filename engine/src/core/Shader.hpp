@@ -23,6 +23,12 @@ namespace Tina {
 
         bgfx::ShaderHandle loadShader(const std::string &path);
 
+        // 指定阶段（"vs"/"fs"）着色器二进制的路径，目录按当前渲染后端选择
+        [[nodiscard]] std::string getBinaryPath(const std::string &name, const char *stage) const;
+
+        // 用已读入内存的着色器二进制创建程序，供异步加载在渲染线程调用
+        bool createFromMemory(const bgfx::Memory *vertex, const bgfx::Memory *fragment);
+
         [[nodiscard]] bool isValid() const;
 
         [[nodiscard]] const bgfx::ProgramHandle &getProgram() const {
@@ -31,6 +37,9 @@ namespace Tina {
 
         void destory();
 
+        // 交换两个着色器持有的 bgfx 句柄，用于热重载时替换程序
+        void swap(Shader &other) noexcept;
+
     private:
         const std::string SHADER_PATH = "../resources/shaders/";
         bgfx::ShaderHandle m_vertexShader = BGFX_INVALID_HANDLE;
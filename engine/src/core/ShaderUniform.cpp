@@ -8,18 +8,18 @@
 namespace Tina {
     ShaderUniform::ShaderUniform(ShaderUniform &&other) noexcept {
         this->m_handle = other.m_handle;
-        this->m_uniformName = other.m_uniformName;
+        this->m_name = other.m_name;
         other.m_handle.idx = bgfx::kInvalidHandle;
-        other.m_uniformName = nullptr;
+        other.m_name = InternedString();
     }
 
     ShaderUniform & ShaderUniform::operator=(ShaderUniform &&other) noexcept {
         if (this != &other) {
             this->free();  // 使用this->来明确调用成员函数
             this->m_handle = other.m_handle;
-            this->m_uniformName = other.m_uniformName;
+            this->m_name = other.m_name;
             other.m_handle.idx = bgfx::kInvalidHandle;
-            other.m_uniformName = nullptr;
+            other.m_name = InternedString();
         }
         return *this;
     }
@@ -33,14 +33,13 @@ namespace Tina {
             this->free();
         }
         m_handle = handle;
-        m_uniformName = uniformName;
+        // 驻留名字，调用方传入的临时字符串释放后依然有效
+        m_name = InternedString(uniformName);
         
         if (!bgfx::isValid(m_handle)) {
-            fmt::print("Warning: Setting invalid uniform handle for '{}'\n", 
-                m_uniformName ? m_uniformName : "unknown");
+            fmt::print("Warning: Setting invalid uniform handle for '{}'\n", getDisplayName());
         } else {
-            fmt::print("Successfully set uniform handle for '{}'\n", 
-                m_uniformName ? m_uniformName : "unknown");
+            fmt::print("Successfully set uniform handle for '{}'\n", getDisplayName());
         }
     }
 
@@ -49,7 +48,7 @@ namespace Tina {
             this->free();
         }
         
-        this->m_uniformName = uniformName;
+        this->m_name = InternedString(uniformName);
         this->m_handle = bgfx::createUniform(uniformName, type, num);
         
         if (!bgfx::isValid(m_handle)) {
@@ -65,12 +64,12 @@ namespace Tina {
             bgfx::destroy(m_handle);
             m_handle.idx = bgfx::kInvalidHandle;
         }
-        m_uniformName = nullptr;
+        m_name = InternedString();
     }
 
     void ShaderUniform::setValue(float x, float y, float z, float w) const {
         if (!bgfx::isValid(m_handle)) {
-            fmt::print("Attempting to set value for invalid uniform '{}'\n", m_uniformName ? m_uniformName : "unknown");
+            fmt::print("Attempting to set value for invalid uniform '{}'\n", getDisplayName());
             return;
         }
         float value[4] = { x, y, z, w };
@@ -79,7 +78,7 @@ namespace Tina {
 
     void ShaderUniform::setValue(const Color &color, bool needsRounding) const {
         if (!bgfx::isValid(m_handle)) {
-            fmt::print("Attempting to set color for invalid uniform '{}'\n", m_uniformName ? m_uniformName : "unknown");
+            fmt::print("Attempting to set color for invalid uniform '{}'\n", getDisplayName());
             return;
         }
         if (!needsRounding) {
@@ -94,20 +93,20 @@ namespace Tina {
 
     void ShaderUniform::setMatrix4(const float* matrix) const {
         if (!bgfx::isValid(m_handle)) {
-            fmt::print("Attempting to set matrix for invalid uniform '{}'\n", m_uniformName ? m_uniformName : "unknown");
+            fmt::print("Attempting to set matrix for invalid uniform '{}'\n", getDisplayName());
             throw std::runtime_error("Invalid uniform handle");
         }
         
         if (matrix == nullptr) {
-            fmt::print("Attempting to set null matrix for uniform '{}'\n", m_uniformName ? m_uniformName : "unknown");
+            fmt::print("Attempting to set null matrix for uniform '{}'\n", getDisplayName());
             throw std::runtime_error("Null matrix pointer");
         }
 
         try {
             bgfx::setUniform(m_handle, matrix);
-            fmt::print("Successfully set matrix for uniform '{}'\n", m_uniformName ? m_uniformName : "unknown");
+            fmt::print("Successfully set matrix for uniform '{}'\n", getDisplayName());
         } catch (const std::exception& e) {
-            fmt::print("Failed to set matrix for uniform '{}': {}\n", m_uniformName ? m_uniformName : "unknown", e.what());
+            fmt::print("Failed to set matrix for uniform '{}': {}\n", getDisplayName(), e.what());
             throw;
         }
     }
@@ -2,6 +2,7 @@
 #define TINA_CORE_SHADERUNIFORM_HPP
 
 #include <bgfx/bgfx.h>
+#include "base/InternedString.hpp"
 #include "base/NonCopyable.hpp"
 
 namespace Tina {
@@ -33,8 +34,12 @@ namespace Tina {
 
         [[nodiscard]] const bgfx::UniformHandle &getHandle() const { return m_handle; };
 
+        [[nodiscard]] const InternedString &getName() const { return m_name; }
+
     private:
-        const char *m_uniformName = nullptr;
+        [[nodiscard]] const char *getDisplayName() const { return m_name.empty() ? "unknown" : m_name.c_str(); }
+
+        InternedString m_name;
         bgfx::UniformHandle m_handle = BGFX_INVALID_HANDLE;
     };
 }
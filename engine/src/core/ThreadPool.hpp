@@ -0,0 +1,60 @@
+#ifndef TINA_CORE_THREADPOOL_HPP
+#define TINA_CORE_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "base/NonCopyable.hpp"
+
+namespace Tina
+{
+    /**
+     * 固定线程数的工作线程池，任务按提交顺序先进先出执行。
+     * 析构时会先执行完队列中剩余的任务再退出。
+     */
+    class ThreadPool : public NonCopyable
+    {
+    public:
+        // threadCount 为 0 时使用硬件线程数减一（至少一个），给主线程留出一个核心
+        explicit ThreadPool(size_t threadCount = 0);
+        ~ThreadPool();
+
+        void enqueue(std::function<void()> task);
+
+        template <typename Func>
+        auto submit(Func&& func) -> std::future<std::invoke_result_t<std::decay_t<Func>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<Func>>;
+            // std::function 要求可拷贝，packaged_task 只能移动，因此放在 shared_ptr 中
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+            std::future<Result> future = task->get_future();
+            enqueue([task]() { (*task)(); });
+            return future;
+        }
+
+        // 阻塞直到队列为空且没有正在执行的任务
+        void waitIdle();
+
+        [[nodiscard]] size_t getThreadCount() const { return m_threads.size(); }
+        [[nodiscard]] size_t getPendingCount() const;
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread> m_threads;
+        std::deque<std::function<void()>> m_tasks;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_taskAvailable;
+        std::condition_variable m_idle;
+        size_t m_activeCount = 0;
+        bool m_stopping = false;
+    };
+} // Tina
+
+#endif //TINA_CORE_THREADPOOL_HPP
@@ -9,10 +9,13 @@
 #define TINA_FILESYSTEM_BYTEBUFFER_HPP
 
 #include <cstdint>
+#include <limits>
 #include <stdexcept>
 #include <string.h>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "ByteView.hpp"
 #include "tool/Endianness.hpp"
 
 namespace Tina {
@@ -114,27 +117,34 @@ namespace Tina {
         }
 
 
+        // 读取到 '\0' 为止（结束符会被跳过）
         std::string readString() const {
-            std::string str{};
-
-            size_t pos = rPos_;
+            return std::string(readStringView());
+        }
 
-            // 确保当前读位置有效
-            while (pos < buffer_.size()) {
-                // 从当前读位置读取char
-                // 如果读取到字符串结束符，退出循环
-                if (const char byte = read<char>(pos); byte == '\0') {
-                    break;
-                }
-                pos++;
-            }
+        // 与 readString 相同，但返回指向缓冲区的视图，在下一次写入缓冲区之前有效
+        std::string_view readStringView() const {
+            ByteView reader = view();
+            const std::string_view str = reader.readString();
+            rPos_ += reader.getReadPos();
+            return str;
+        }
 
-            // 创建从开始位置到结束符之前的字符串
-            str.assign(reinterpret_cast<const char *>(&buffer_[rPos_]), pos - rPos_);
-            rPos_ = (pos < buffer_.size()) ? pos : buffer_.size();
+        std::string_view readStringView(size_t length) const {
+            ByteView reader = view();
+            const std::string_view str = reader.readString(length);
+            rPos_ += reader.getReadPos();
             return str;
         }
 
+        // 从当前读位置开始的只读视图，不拷贝数据
+        ByteView view() const {
+            if (rPos_ >= buffer_.size()) {
+                return {};
+            }
+            return {buffer_.data() + rPos_, buffer_.size() - rPos_};
+        }
+
 
         void writeString(const std::string &str) {
             if (!str.empty()) {
@@ -183,6 +193,15 @@ namespace Tina {
             }
         }
 
+        // 批量写入 count 个元素，与逐个 put 的结果相同
+        template<typename T>
+        void put(size_t pos, const T *src, size_t count) {
+            static_assert(std::is_fundamental_v<T>, "put(compound)");
+            if (pos <= size() && count <= (size() - pos) / sizeof(T) && src && count) {
+                Tool::EndianConvert(src, reinterpret_cast<T *>(&buffer_[pos]), count);
+            }
+        }
+
 
         template<typename T>
         T read() const {
@@ -196,16 +215,33 @@ namespace Tina {
         T read(size_t pos) const {
             T value{};
             if (pos + sizeof(T) <= buffer_.size()) {
-                value = *reinterpret_cast<const T *>(&buffer_[pos]);
+                memcpy(&value, &buffer_[pos], sizeof(T));
                 value = Tool::EndianConvert(value); // 执行大小端转
                 return value;
             }
             return value;
         }
 
+        // 批量读取 count 个元素，只做一次 memcpy，剩余数据不足时不读取并返回 false
+        template<typename T>
+        bool read(T *dest, size_t count) const {
+            ByteView reader = view();
+            if (!reader.read(dest, count)) {
+                return false;
+            }
+            rPos_ += reader.getReadPos();
+            return true;
+        }
+
+#ifdef __cpp_lib_span
+        template<typename T>
+        bool read(std::span<T> dest) const {
+            return read(dest.data(), dest.size());
+        }
+#endif
 
         void read(uint8_t *dest, size_t len) const {
-            if ((rPos_ + len) < buffer_.size()) {
+            if ((rPos_ + len) <= buffer_.size()) {
                 memcpy(dest, &buffer_[rPos_], len);
                 rPos_ += len;
             }
@@ -213,6 +249,10 @@ namespace Tina {
 
         void append(const uint8_t *src, size_t cnt) {
             if (src && cnt) {
+                // 与 vector 本身超出上限时相同，抛出 length_error 而不是让 wPos_ + cnt 回绕
+                if (cnt > std::numeric_limits<size_t>::max() - wPos_) {
+                    throw std::length_error("ByteBuffer::append");
+                }
                 if (buffer_.size() < (wPos_ + cnt)) {
                     buffer_.resize(wPos_ + cnt);
                 }
@@ -222,9 +262,21 @@ namespace Tina {
             }
         }
 
+        // 批量追加 cnt 个元素，与逐个 append 的结果相同
         template<typename T>
         void append(const T *src, size_t cnt) {
-            return append(reinterpret_cast<const uint8_t *>(src), cnt * sizeof(T));
+            static_assert(std::is_fundamental_v<T>, "append(compound)");
+            if (src && cnt) {
+                if (cnt > (std::numeric_limits<size_t>::max() - wPos_) / sizeof(T)) {
+                    throw std::length_error("ByteBuffer::append");
+                }
+                if (buffer_.size() < (wPos_ + cnt * sizeof(T))) {
+                    buffer_.resize(wPos_ + cnt * sizeof(T));
+                }
+
+                Tool::EndianConvert(src, reinterpret_cast<T *>(&buffer_[wPos_]), cnt);
+                wPos_ += cnt * sizeof(T);
+            }
         }
 
         template<typename T>
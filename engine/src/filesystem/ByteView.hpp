@@ -0,0 +1,149 @@
+#ifndef TINA_FILESYSTEM_BYTEVIEW_HPP
+#define TINA_FILESYSTEM_BYTEVIEW_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "tool/Endianness.hpp"
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+namespace Tina {
+    /**
+     * 不持有内存的只读字节视图，带读位置，读取规则与 ByteBuffer 一致（数值按 EndianConvert 转换）。
+     * 用于直接解析映射的文件、bgfx::Memory 或接收缓冲区，readString/readBytes 返回指向原数据的视图，
+     * 整个解析过程不产生中间分配。调用方需保证底层内存在视图使用期间有效。
+     */
+    class ByteView {
+    public:
+        ByteView() = default;
+
+        ByteView(const void *data, size_t size) : data_(static_cast<const uint8_t *>(data)), size_(size) {
+        }
+
+        explicit ByteView(const std::vector<uint8_t> &buffer) : ByteView(buffer.data(), buffer.size()) {
+        }
+
+        [[nodiscard]] const uint8_t *data() const {
+            return data_;
+        }
+
+        [[nodiscard]] size_t size() const {
+            return size_;
+        }
+
+        [[nodiscard]] bool isEmpty() const {
+            return size_ == 0;
+        }
+
+        void setReadPos(size_t pos) {
+            rPos_ = pos < size_ ? pos : size_;
+        }
+
+        [[nodiscard]] size_t getReadPos() const {
+            return rPos_;
+        }
+
+        [[nodiscard]] size_t bytesRemaining() const {
+            return size_ - rPos_;
+        }
+
+        void skipBytes(size_t count) {
+            rPos_ += count < bytesRemaining() ? count : bytesRemaining();
+        }
+
+        [[nodiscard]] const uint8_t *peek() const {
+            return data_ + rPos_;
+        }
+
+        // 返回 [offset, offset + count) 的子视图，超出范围的部分会被截断
+        [[nodiscard]] ByteView subView(size_t offset, size_t count) const {
+            if (offset > size_) {
+                return {};
+            }
+            return {data_ + offset, count < size_ - offset ? count : size_ - offset};
+        }
+
+        template<typename T>
+        T read() {
+            T value = read<T>(rPos_);
+            if (rPos_ + sizeof(T) <= size_) {
+                rPos_ += sizeof(T);
+            }
+            return value;
+        }
+
+        template<typename T>
+        T read(size_t pos) const {
+            static_assert(std::is_fundamental_v<T>, "read(compound)");
+            T value{};
+            if (pos <= size_ && sizeof(T) <= size_ - pos) {
+                memcpy(&value, data_ + pos, sizeof(T));
+                value = Tool::EndianConvert(value);
+            }
+            return value;
+        }
+
+        // 批量读取 count 个元素，拷贝与字节序转换一次完成，剩余数据不足时不读取并返回 false
+        template<typename T>
+        bool read(T *dest, size_t count) {
+            static_assert(std::is_fundamental_v<T>, "read(compound)");
+            // count 可能来自不可信的资源头，先除再比较，避免 count * sizeof(T) 溢出
+            if (count > bytesRemaining() / sizeof(T)) {
+                return false;
+            }
+            Tool::EndianConvert(reinterpret_cast<const T *>(data_ + rPos_), dest, count);
+            rPos_ += count * sizeof(T);
+            return true;
+        }
+
+#ifdef __cpp_lib_span
+        template<typename T>
+        bool read(std::span<T> dest) {
+            return read(dest.data(), dest.size());
+        }
+#endif
+
+        // 读取到 '\0' 为止（结束符会被跳过），返回指向原数据的视图；没有结束符时读到末尾
+        std::string_view readString() {
+            const auto *begin = reinterpret_cast<const char *>(data_ + rPos_);
+            const size_t remaining = bytesRemaining();
+            // 空视图的 data_ 可能为空指针，不能传给 memchr
+            const auto *end = remaining ? static_cast<const char *>(memchr(begin, '\0', remaining)) : nullptr;
+            const size_t length = end ? static_cast<size_t>(end - begin) : remaining;
+            rPos_ += end ? length + 1 : length;
+            return {begin, length};
+        }
+
+        // 读取固定长度的字符串，剩余数据不足时返回空视图且不移动读位置
+        std::string_view readString(size_t length) {
+            if (length > bytesRemaining()) {
+                return {};
+            }
+            const auto *begin = reinterpret_cast<const char *>(data_ + rPos_);
+            rPos_ += length;
+            return {begin, length};
+        }
+
+        // 读取 count 字节作为子视图，不拷贝数据
+        ByteView readBytes(size_t count) {
+            if (count > bytesRemaining()) {
+                return {};
+            }
+            ByteView view(data_ + rPos_, count);
+            rPos_ += count;
+            return view;
+        }
+
+    private:
+        const uint8_t *data_ = nullptr;
+        size_t size_ = 0;
+        size_t rPos_ = 0;
+    };
+} // Tina
+
+#endif //TINA_FILESYSTEM_BYTEVIEW_HPP
@@ -97,6 +97,11 @@ namespace Tina
         return m_fileStream.eof();
     }
 
+    MappedFile File::map(MappedFile::AccessPattern pattern) const
+    {
+        return MappedFile(m_path, pattern);
+    }
+
     bool File::write(const std::string& data, const bool append) const
     {
         if (!m_isOpen || !(m_mode & Write))
@@ -3,6 +3,7 @@
 
 #include <fstream>
 #include <vector>
+#include "MappedFile.hpp"
 #include "Path.hpp"
 #include "io/Closeable.hpp"
 
@@ -30,6 +31,8 @@ namespace Tina
         File& operator=(File&& other) noexcept;
 
         [[nodiscard]] bool read(std::string& data) const;
+        // 以内存映射方式只读访问文件内容，不经过 fstream 拷贝；失败时抛出 std::runtime_error
+        [[nodiscard]] MappedFile map(MappedFile::AccessPattern pattern = MappedFile::AccessPattern::Sequential) const;
         [[nodiscard]] bool write(const std::string& data, bool append = false) const;
         void close() override;
 
@@ -0,0 +1,271 @@
+#include "FileWatcher.hpp"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#define TINA_HAS_INOTIFY 1
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#define TINA_HAS_INOTIFY 0
+#endif
+
+namespace Tina
+{
+    namespace
+    {
+        // 后台线程检查停止标志的间隔，也是没有 inotify 时比较修改时间的间隔
+        constexpr int POLL_INTERVAL_MS = 100;
+
+        std::filesystem::file_time_type getLastWriteTime(const std::string& path)
+        {
+            std::error_code error;
+            const auto time = std::filesystem::last_write_time(path, error);
+            return error ? std::filesystem::file_time_type::min() : time;
+        }
+    }
+
+    FileWatcher::FileWatcher(std::chrono::milliseconds debounce) : m_debounce(debounce)
+    {
+#if TINA_HAS_INOTIFY
+        m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+        m_running = true;
+        m_thread = std::thread(&FileWatcher::run, this);
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        m_running = false;
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+#if TINA_HAS_INOTIFY
+        if (m_inotify >= 0)
+        {
+            close(m_inotify);
+        }
+#endif
+    }
+
+    bool FileWatcher::watch(const std::string& path)
+    {
+        std::string directory;
+        const std::string location = getLocation(path, directory);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_files.find(location);
+        if (it == m_files.end())
+        {
+            if (!addDirectory(directory))
+            {
+                return false;
+            }
+            it = m_files.emplace(location, WatchedFile{directory, {}, getLastWriteTime(location)}).first;
+        }
+
+        auto& paths = it->second.paths;
+        if (std::find(paths.begin(), paths.end(), path) == paths.end())
+        {
+            paths.push_back(path);
+        }
+        return true;
+    }
+
+    void FileWatcher::unwatch(const std::string& path)
+    {
+        std::string directory;
+        const std::string location = getLocation(path, directory);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_files.find(location);
+        if (it == m_files.end())
+        {
+            return;
+        }
+
+        auto& paths = it->second.paths;
+        paths.erase(std::remove(paths.begin(), paths.end(), path), paths.end());
+        if (paths.empty())
+        {
+            m_files.erase(it);
+            m_pending.erase(location);
+            removeDirectory(directory);
+        }
+    }
+
+    bool FileWatcher::isWatching(const std::string& path) const
+    {
+        std::string directory;
+        const std::string location = getLocation(path, directory);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_files.find(location);
+        return it != m_files.end() &&
+            std::find(it->second.paths.begin(), it->second.paths.end(), path) != it->second.paths.end();
+    }
+
+    size_t FileWatcher::getWatchCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_files.size();
+    }
+
+    void FileWatcher::poll(std::vector<std::string>& changed)
+    {
+        const auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_pending.begin(); it != m_pending.end();)
+        {
+            if (now - it->second < m_debounce)
+            {
+                ++it;
+                continue;
+            }
+
+            if (const auto file = m_files.find(it->first); file != m_files.end())
+            {
+                changed.insert(changed.end(), file->second.paths.begin(), file->second.paths.end());
+            }
+            it = m_pending.erase(it);
+        }
+    }
+
+    void FileWatcher::run()
+    {
+#if TINA_HAS_INOTIFY
+        if (m_inotify >= 0)
+        {
+            alignas(inotify_event) char buffer[4096];
+            pollfd descriptor{m_inotify, POLLIN, 0};
+            while (m_running)
+            {
+                if (::poll(&descriptor, 1, POLL_INTERVAL_MS) <= 0)
+                {
+                    continue;
+                }
+
+                const ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+                if (length <= 0)
+                {
+                    continue;
+                }
+
+                const auto now = Clock::now();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (ssize_t offset = 0; offset < length;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        // 事件队列溢出，无法知道哪些文件变了，全部重新加载
+                        for (const auto& file : m_files)
+                        {
+                            markChanged(file.first, now);
+                        }
+                        continue;
+                    }
+
+                    const auto directory = m_descriptorDirectories.find(event->wd);
+                    if (event->len == 0 || directory == m_descriptorDirectories.end())
+                    {
+                        continue;
+                    }
+                    markChanged(directory->second + "/" + event->name, now);
+                }
+            }
+            return;
+        }
+#endif
+
+        // 没有 inotify 时定时比较修改时间
+        while (m_running)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+
+            const auto now = Clock::now();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& file : m_files)
+            {
+                const auto lastWrite = getLastWriteTime(file.first);
+                if (lastWrite != file.second.lastWrite)
+                {
+                    file.second.lastWrite = lastWrite;
+                    markChanged(file.first, now);
+                }
+            }
+        }
+    }
+
+    void FileWatcher::markChanged(const std::string& location, Clock::time_point time)
+    {
+        if (m_files.find(location) != m_files.end())
+        {
+            m_pending[location] = time;
+        }
+    }
+
+    bool FileWatcher::addDirectory(const std::string& directory)
+    {
+        auto it = m_directories.find(directory);
+        if (it == m_directories.end())
+        {
+            WatchedDirectory watched;
+#if TINA_HAS_INOTIFY
+            if (m_inotify >= 0)
+            {
+                watched.descriptor = inotify_add_watch(m_inotify, directory.c_str(),
+                                                       IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+                if (watched.descriptor < 0)
+                {
+                    return false;
+                }
+                m_descriptorDirectories[watched.descriptor] = directory;
+            }
+#else
+            std::error_code error;
+            if (!std::filesystem::is_directory(directory, error))
+            {
+                return false;
+            }
+#endif
+            it = m_directories.emplace(directory, watched).first;
+        }
+        ++it->second.fileCount;
+        return true;
+    }
+
+    void FileWatcher::removeDirectory(const std::string& directory)
+    {
+        const auto it = m_directories.find(directory);
+        if (it == m_directories.end() || --it->second.fileCount > 0)
+        {
+            return;
+        }
+#if TINA_HAS_INOTIFY
+        if (it->second.descriptor >= 0)
+        {
+            inotify_rm_watch(m_inotify, it->second.descriptor);
+            m_descriptorDirectories.erase(it->second.descriptor);
+        }
+#endif
+        m_directories.erase(it);
+    }
+
+    std::string FileWatcher::getLocation(const std::string& path, std::string& directory)
+    {
+        std::error_code error;
+        std::filesystem::path absolute = std::filesystem::absolute(path, error);
+        if (error)
+        {
+            absolute = path;
+        }
+        absolute = absolute.lexically_normal();
+        directory = absolute.parent_path().generic_string();
+        return directory + "/" + absolute.filename().generic_string();
+    }
+} // Tina
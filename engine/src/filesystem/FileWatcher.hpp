@@ -0,0 +1,78 @@
+#ifndef TINA_FILESYSTEM_FILEWATCHER_HPP
+#define TINA_FILESYSTEM_FILEWATCHER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "base/NonCopyable.hpp"
+
+namespace Tina
+{
+    /**
+     * 监视文件修改的后台线程。
+     * Linux 上用 inotify 监视文件所在的目录（编辑器常用"写临时文件再重命名"的方式保存，直接监视文件会丢失事件），
+     * 其他平台上退化为定时比较修改时间。
+     * 变化先记录下来，poll 只返回最后一次变化已经超过 debounce 的文件，连续保存只会报告一次。
+     */
+    class FileWatcher : public NonCopyable
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit FileWatcher(std::chrono::milliseconds debounce = std::chrono::milliseconds(200));
+        ~FileWatcher();
+
+        // 开始监视 path，所在目录无法监视时返回 false；同一文件可以用不同写法的路径多次监视
+        bool watch(const std::string& path);
+        void unwatch(const std::string& path);
+        [[nodiscard]] bool isWatching(const std::string& path) const;
+        [[nodiscard]] size_t getWatchCount() const;
+
+        // 取出已经稳定下来的变化文件，追加到 changed，路径与 watch 时传入的相同
+        void poll(std::vector<std::string>& changed);
+
+        [[nodiscard]] std::chrono::milliseconds getDebounce() const { return m_debounce; }
+
+    private:
+        struct WatchedFile
+        {
+            std::string directory;
+            std::vector<std::string> paths;
+            std::filesystem::file_time_type lastWrite;
+        };
+
+        struct WatchedDirectory
+        {
+            int descriptor = -1;
+            size_t fileCount = 0;
+        };
+
+        void run();
+        // 由后台线程调用，location 为 "目录/文件名"，调用方需持有 m_mutex
+        void markChanged(const std::string& location, Clock::time_point time);
+        bool addDirectory(const std::string& directory);
+        void removeDirectory(const std::string& directory);
+
+        static std::string getLocation(const std::string& path, std::string& directory);
+
+        const std::chrono::milliseconds m_debounce;
+        mutable std::mutex m_mutex;
+        // 以 "目录/文件名" 为键
+        std::unordered_map<std::string, WatchedFile> m_files;
+        std::unordered_map<std::string, WatchedDirectory> m_directories;
+        std::unordered_map<int, std::string> m_descriptorDirectories;
+        // 已变化但还在等待 debounce 的文件及其最后一次变化的时间
+        std::unordered_map<std::string, Clock::time_point> m_pending;
+
+        int m_inotify = -1;
+        std::atomic<bool> m_running{false};
+        std::thread m_thread;
+    };
+} // Tina
+
+#endif //TINA_FILESYSTEM_FILEWATCHER_HPP
@@ -0,0 +1,170 @@
+#include "MappedFile.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TINA_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define TINA_HAS_MMAP 0
+#endif
+
+namespace Tina
+{
+    MappedFile::MappedFile(const Path& path, AccessPattern pattern)
+    {
+        if (!open(path, pattern))
+        {
+            throw std::runtime_error("Failed to map file: " + path.toString());
+        }
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_mapping(std::exchange(other.m_mapping, nullptr))
+        , m_fallback(std::move(other.m_fallback))
+        , m_isOpen(std::exchange(other.m_isOpen, false))
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+            m_fallback = std::move(other.m_fallback);
+            m_isOpen = std::exchange(other.m_isOpen, false);
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const Path& path, AccessPattern pattern)
+    {
+        close();
+
+#if TINA_HAS_MMAP
+        const std::string fileName = path.toString();
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size == 0)
+        {
+            // 空文件无法映射，视为打开成功的空数据
+            ::close(fd);
+            m_isOpen = true;
+            return true;
+        }
+
+        void* mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // 映射建立后文件描述符就不再需要了
+        ::close(fd);
+        if (mapping != MAP_FAILED)
+        {
+            m_mapping = mapping;
+            m_data = static_cast<const uint8_t*>(mapping);
+            m_isOpen = true;
+            advise(pattern);
+            return true;
+        }
+        m_size = 0;
+#else
+        (void)pattern;
+#endif
+        return openFallback(path);
+    }
+
+    bool MappedFile::openFallback(const Path& path)
+    {
+        std::ifstream stream(path.toString(), std::ios::binary | std::ios::ate);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        const auto size = static_cast<size_t>(stream.tellg());
+        stream.seekg(0, std::ios::beg);
+        if (size > 0)
+        {
+            m_fallback = std::make_unique<uint8_t[]>(size);
+            if (!stream.read(reinterpret_cast<char*>(m_fallback.get()), static_cast<std::streamsize>(size)))
+            {
+                m_fallback.reset();
+                return false;
+            }
+        }
+        m_data = m_fallback.get();
+        m_size = size;
+        m_isOpen = true;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+#if TINA_HAS_MMAP
+        if (m_mapping)
+        {
+            ::munmap(m_mapping, m_size);
+        }
+#endif
+        m_mapping = nullptr;
+        m_fallback.reset();
+        m_data = nullptr;
+        m_size = 0;
+        m_isOpen = false;
+    }
+
+    void MappedFile::advise(AccessPattern pattern) const
+    {
+#if TINA_HAS_MMAP
+        if (!m_mapping)
+        {
+            return;
+        }
+
+        int advice = MADV_NORMAL;
+        switch (pattern)
+        {
+        case AccessPattern::Sequential:
+            advice = MADV_SEQUENTIAL;
+            break;
+        case AccessPattern::Random:
+            advice = MADV_RANDOM;
+            break;
+        case AccessPattern::WillNeed:
+            advice = MADV_WILLNEED;
+            break;
+        default:
+            break;
+        }
+        // 提示失败不影响正确性，忽略返回值
+        ::madvise(m_mapping, m_size, advice);
+#else
+        (void)pattern;
+#endif
+    }
+} // Tina
@@ -0,0 +1,64 @@
+#ifndef TINA_FILESYSTEM_MAPPEDFILE_HPP
+#define TINA_FILESYSTEM_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "ByteView.hpp"
+#include "Path.hpp"
+#include "base/NonCopyable.hpp"
+
+namespace Tina
+{
+    /**
+     * 只读的内存映射文件，析构时解除映射。
+     * Linux/macOS 上使用 mmap 直接映射页缓存，不额外拷贝；映射失败或其他平台上退化为一次性读入堆内存，
+     * 调用方无需区分两种情况。
+     */
+    class MappedFile : public NonCopyable
+    {
+    public:
+        // 访问模式提示，映射成功时通过 madvise 告知内核预读策略
+        enum class AccessPattern
+        {
+            Normal,
+            Sequential,
+            Random,
+            // 立即预读整个文件，适合马上要完整使用的小文件
+            WillNeed
+        };
+
+        MappedFile() = default;
+        // 打开失败时抛出 std::runtime_error
+        explicit MappedFile(const Path& path, AccessPattern pattern = AccessPattern::Sequential);
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        ~MappedFile();
+
+        // 打开失败时返回 false，不抛出异常
+        bool open(const Path& path, AccessPattern pattern = AccessPattern::Sequential);
+        void close();
+
+        [[nodiscard]] bool isOpen() const { return m_isOpen; }
+        // 是否真正使用了内存映射（false 表示使用的是读入堆内存的后备路径）
+        [[nodiscard]] bool isMapped() const { return m_mapping != nullptr; }
+
+        [[nodiscard]] const uint8_t* data() const { return m_data; }
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] ByteView view() const { return {m_data, m_size}; }
+
+        // 修改访问模式提示，例如先顺序解析文件头，再随机访问数据块
+        void advise(AccessPattern pattern) const;
+
+    private:
+        bool openFallback(const Path& path);
+
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        void* m_mapping = nullptr;
+        std::unique_ptr<uint8_t[]> m_fallback;
+        bool m_isOpen = false;
+    };
+} // Tina
+
+#endif //TINA_FILESYSTEM_MAPPEDFILE_HPP
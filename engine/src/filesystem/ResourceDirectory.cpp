@@ -0,0 +1,51 @@
+#include "ResourceDirectory.hpp"
+#include <filesystem>
+
+namespace Tina {
+    // 静态成员初始化
+    Path ResourceDirectory::s_rootPath("");
+    const String ResourceDirectory::DEFAULT_ROOT_PATH("../resources");
+
+    // 资源子目录
+    const String ResourceDirectory::SHADER_PATH("shaders");
+    const String ResourceDirectory::CONFIG_PATH("config");
+    const String ResourceDirectory::TEXTURE_PATH("textures");
+    const String ResourceDirectory::MODEL_PATH("models");
+    const String ResourceDirectory::FONT_PATH("fonts");
+    const String ResourceDirectory::AUDIO_PATH("audio");
+
+    void ResourceDirectory::setRootPath(const String& path) {
+        s_rootPath = Path(path);
+    }
+
+    Path ResourceDirectory::getRootPath() {
+        if (s_rootPath.isEmpty()) {
+            s_rootPath = Path(DEFAULT_ROOT_PATH);
+        }
+        return s_rootPath;
+    }
+
+    Path ResourceDirectory::getShaderPath() {
+        return getRootPath().getChildFile(SHADER_PATH);
+    }
+
+    Path ResourceDirectory::getConfigPath() {
+        return getRootPath().getChildFile(CONFIG_PATH);
+    }
+
+    Path ResourceDirectory::getTexturePath() {
+        return getRootPath().getChildFile(TEXTURE_PATH);
+    }
+
+    Path ResourceDirectory::getModelPath() {
+        return getRootPath().getChildFile(MODEL_PATH);
+    }
+
+    Path ResourceDirectory::getFontPath() {
+        return getRootPath().getChildFile(FONT_PATH);
+    }
+
+    Path ResourceDirectory::getAudioPath() {
+        return getRootPath().getChildFile(AUDIO_PATH);
+    }
+} 
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include "filesystem/Path.hpp"
 
 namespace Tina {
-    class ResourcePath {
+    class ResourceDirectory {
     public:
         static void setRootPath(const String& path);
         static Path getRootPath();
@@ -1,28 +1,72 @@
 #include "graphics/Renderer2D.hpp"
+#include "resource/TextureResource.hpp"
 #include "tool/BgfxUtils.hpp"
 #include <bgfx/bgfx.h>
 #include <bx/math.h>
 #include <fmt/format.h>
+#include <algorithm>
+#include <cmath>
 #include <glm/glm.hpp>
 
 namespace Tina
 {
     bgfx::VertexLayout PosColorTexCoordVertex::ms_layout;
 
+    static_assert(sizeof(PosColorTexCoordVertex) == sizeof(SpriteVertex), "SpriteBatch writes PosColorTexCoordVertex directly");
+
+    namespace
+    {
+        // 不支持 32 位索引时，一次分配最多容纳的精灵数
+        constexpr uint32_t MAX_SPRITES_INDEX16 = 65536 / SpriteBatch::VERTICES_PER_SPRITE;
+
+        uint64_t getBlendState(Renderer2D::BlendMode mode)
+        {
+            const uint64_t write = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A;
+            switch (mode)
+            {
+            case Renderer2D::BlendMode::Additive:
+                return write | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
+            case Renderer2D::BlendMode::Opaque:
+                return write;
+            case Renderer2D::BlendMode::Alpha:
+            default:
+                // 纹理和顶点颜色都是预乘 alpha 的
+                return write | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_INV_SRC_ALPHA);
+            }
+        }
+
+        // 一次分配的缓冲区内的 count 个精灵可能跨越多个绘制段，按段依次回调 submit(draw, 块内偏移, 数量)
+        template <typename Submit>
+        void submitChunk(const std::vector<SpriteBatch::Draw>& draws, size_t& drawIndex, uint32_t& drawOffset,
+                         uint32_t count, Submit&& submit)
+        {
+            for (uint32_t submitted = 0; submitted < count;) {
+                const SpriteBatch::Draw& draw = draws[drawIndex];
+                const uint32_t drawCount = std::min(draw.spriteCount - drawOffset, count - submitted);
+                submit(draw, submitted, drawCount);
+                submitted += drawCount;
+                drawOffset += drawCount;
+                if (drawOffset == draw.spriteCount) {
+                    ++drawIndex;
+                    drawOffset = 0;
+                }
+            }
+        }
+    }
+
     Renderer2D::Renderer2D(uint16_t viewId)
         : m_viewId(viewId)
         , m_program(BGFX_INVALID_HANDLE)
         , m_vbh(BGFX_INVALID_HANDLE)
         , m_ibh(BGFX_INVALID_HANDLE)
-        , m_s_texColor(BGFX_INVALID_HANDLE)
         , m_vertices(nullptr)
         , m_indices(nullptr)
         , m_currentVertex(0)
         , m_currentIndex(0)
-        , m_currentTexture(BGFX_INVALID_HANDLE)
         , m_isDrawing(false)
         , m_camera(nullptr)
     {
+        std::fill(std::begin(m_textureSamplers), std::end(m_textureSamplers), bgfx::UniformHandle{bgfx::kInvalidHandle});
     }
 
     Renderer2D::~Renderer2D()
@@ -33,8 +77,16 @@ namespace Tina
             bgfx::destroy(m_vbh);
         if (bgfx::isValid(m_program))
             bgfx::destroy(m_program);
-        if (bgfx::isValid(m_s_texColor))
-            bgfx::destroy(m_s_texColor);
+        for (bgfx::UniformHandle sampler : m_textureSamplers) {
+            if (bgfx::isValid(sampler))
+                bgfx::destroy(sampler);
+        }
+        if (bgfx::isValid(m_instancedProgram))
+            bgfx::destroy(m_instancedProgram);
+        if (bgfx::isValid(m_quadVbh))
+            bgfx::destroy(m_quadVbh);
+        if (bgfx::isValid(m_quadIbh))
+            bgfx::destroy(m_quadIbh);
 
         delete[] m_vertices;
         delete[] m_indices;
@@ -92,11 +144,36 @@ namespace Tina
         }
         fmt::print("Successfully loaded shader program, handle: {}\n", m_program.idx);
 
-        // 创建纹理采样器uniform
-        m_s_texColor = bgfx::createUniform("s_texColor", bgfx::UniformType::Sampler);
-        if (!bgfx::isValid(m_s_texColor)) {
-            fmt::print("Failed to create texture sampler uniform\n");
-            throw std::runtime_error("Failed to create texture sampler uniform");
+        // 创建各纹理槽位的采样器uniform
+        for (uint8_t stage = 0; stage < SpriteBatch::MAX_TEXTURE_STAGES; ++stage) {
+            const std::string name = stage == 0 ? "s_texColor" : fmt::format("s_texColor{}", stage);
+            m_textureSamplers[stage] = bgfx::createUniform(name.c_str(), bgfx::UniformType::Sampler);
+            if (!bgfx::isValid(m_textureSamplers[stage])) {
+                fmt::print("Failed to create texture sampler uniform {}\n", name);
+                throw std::runtime_error("Failed to create texture sampler uniform");
+            }
+        }
+        setMaxTextureStages(SpriteBatch::MAX_TEXTURE_STAGES);
+
+        // Instanced 模式使用的单位四边形，顶点只有 0 ~ 1 的位置，其余数据来自实例缓冲区
+        static const float quadVertices[] = {
+            0.0f, 0.0f,
+            1.0f, 0.0f,
+            0.0f, 1.0f,
+            1.0f, 1.0f,
+        };
+        static const uint16_t quadIndices[] = {0, 1, 2, 1, 3, 2};
+        bgfx::VertexLayout quadLayout;
+        quadLayout.begin()
+            .add(bgfx::Attrib::Position, 2, bgfx::AttribType::Float)
+            .end();
+        m_quadVbh = bgfx::createVertexBuffer(bgfx::makeRef(quadVertices, sizeof(quadVertices)), quadLayout);
+        m_quadIbh = bgfx::createIndexBuffer(bgfx::makeRef(quadIndices, sizeof(quadIndices)));
+
+        // 实例化着色器缺失时只影响 Instanced 模式，退回 Sorted
+        m_instancedProgram = BgfxUtils::loadProgram("sprite_instanced.vs", "sprite_instanced.fs");
+        if (!bgfx::isValid(m_instancedProgram)) {
+            fmt::print("Warning: failed to load instanced sprite program, Instanced mode will use sorted batching\n");
         }
 
         fmt::print("Renderer2D initialization completed\n");
@@ -125,6 +202,8 @@ namespace Tina
         uint16_t width = uint16_t(bgfx::getStats()->width);
         uint16_t height = uint16_t(bgfx::getStats()->height);
         bgfx::setViewRect(m_viewId, 0, 0, width, height);
+        // 正交投影的 proj[0][0] 为 2 / (right - left)；透视投影下得到的是距离为 1 处的值，只作近似
+        m_pixelsPerUnit = std::abs(proj[0][0]) * 0.5f * static_cast<float>(width);
 
         // 设置视图清除标志
         bgfx::setViewClear(m_viewId,
@@ -138,13 +217,18 @@ namespace Tina
         uint64_t state = 0
             | BGFX_STATE_WRITE_RGB
             | BGFX_STATE_WRITE_A
-            | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
+            // 纹理和顶点颜色都是预乘 alpha 的
+            | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_INV_SRC_ALPHA);
         bgfx::setState(state);
 
         m_isDrawing = true;
         m_currentVertex = 0;
         m_currentIndex = 0;
-        m_currentTexture = BGFX_INVALID_HANDLE;
+        m_stageCount = 0;
+        m_batch.clear();
+        for (auto& context : m_contexts) {
+            context->m_batch.clear();
+        }
     }
 
     void Renderer2D::end()
@@ -153,10 +237,69 @@ namespace Tina
             fmt::print("Warning: end() called while not drawing\n");
             return;
         }
-        flush();
+        mergeRecordContexts();
+        if (m_batchMode == BatchMode::Instanced && bgfx::isValid(m_instancedProgram)) {
+            flushInstanced();
+        } else if (m_batchMode != BatchMode::Immediate) {
+            flushSorted();
+        } else {
+            flush();
+            // 录制上下文的精灵
+            flushSorted();
+        }
         m_isDrawing = false;
     }
 
+    void Renderer2D::setBatchMode(BatchMode mode)
+    {
+        if (m_isDrawing) {
+            fmt::print("Warning: setBatchMode() called while drawing\n");
+            return;
+        }
+        if (mode == BatchMode::Instanced && !(bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING)) {
+            fmt::print("Warning: instancing is not supported, falling back to sorted batching\n");
+            mode = BatchMode::Sorted;
+        }
+        m_batchMode = mode;
+    }
+
+    void Renderer2D::setMaxTextureStages(uint8_t count)
+    {
+        if (m_isDrawing) {
+            fmt::print("Warning: setMaxTextureStages() called while drawing\n");
+            return;
+        }
+        const auto samplers = static_cast<uint8_t>(std::min<uint32_t>(
+            bgfx::getCaps()->limits.maxTextureSamplers, SpriteBatch::MAX_TEXTURE_STAGES));
+        m_maxTextureStages = std::clamp<uint8_t>(count, 1, std::max<uint8_t>(samplers, 1));
+    }
+
+    void Renderer2D::setRecordContextCount(size_t count)
+    {
+        if (m_isDrawing) {
+            fmt::print("Warning: setRecordContextCount() called while drawing\n");
+            return;
+        }
+        m_contexts.resize(std::min(count, m_contexts.size()));
+        while (m_contexts.size() < count) {
+            m_contexts.push_back(std::unique_ptr<RecordContext>(new RecordContext(this)));
+        }
+    }
+
+    void Renderer2D::mergeRecordContexts()
+    {
+        size_t spriteCount = m_batch.getSpriteCount();
+        for (const auto& context : m_contexts) {
+            spriteCount += context->m_batch.getSpriteCount();
+        }
+        m_batch.reserve(spriteCount);
+        // 按上下文编号而不是完成顺序追加，排序时相同状态的精灵依次保持这个顺序
+        for (auto& context : m_contexts) {
+            m_batch.append(context->m_batch);
+            context->m_batch.clear();
+        }
+    }
+
     bool Renderer2D::checkFlush(uint16_t vertexCount, uint16_t indexCount)
     {
         return (m_currentVertex + vertexCount > MAX_VERTICES) || 
@@ -183,7 +326,8 @@ namespace Tina
         uint64_t state = 0
             | BGFX_STATE_WRITE_RGB
             | BGFX_STATE_WRITE_A
-            | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
+            // 纹理和顶点颜色都是预乘 alpha 的
+            | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_INV_SRC_ALPHA);
 
         bgfx::setState(state);
 
@@ -192,10 +336,8 @@ namespace Tina
         bx::mtxIdentity(mtx);
         bgfx::setTransform(mtx);
         
-        // 如果有纹理，设置纹理
-        if (bgfx::isValid(m_currentTexture)) {
-            bgfx::setTexture(0, m_s_texColor, m_currentTexture);
-        }
+        // 绑定本批次用到的纹理
+        setTextures(m_stageTextures, m_stageCount);
 
         // 设置顶点和索引缓冲
         bgfx::setVertexBuffer(0, m_vbh, 0, m_currentVertex);
@@ -207,6 +349,154 @@ namespace Tina
         // 重置计数器
         m_currentVertex = 0;
         m_currentIndex = 0;
+        m_stageCount = 0;
+    }
+
+    uint8_t Renderer2D::acquireTextureStage(bgfx::TextureHandle texture)
+    {
+        if (!bgfx::isValid(texture))
+            return SpriteBatch::NO_TEXTURE_STAGE;
+
+        for (uint8_t stage = 0; stage < m_stageCount; ++stage) {
+            if (m_stageTextures[stage] == texture.idx) {
+                return stage;
+            }
+        }
+        if (m_stageCount == m_maxTextureStages) {
+            flush();
+        }
+        m_stageTextures[m_stageCount] = texture.idx;
+        return m_stageCount++;
+    }
+
+    void Renderer2D::setTextures(const uint16_t* textures, uint8_t count)
+    {
+        for (uint8_t stage = 0; stage < count; ++stage) {
+            bgfx::setTexture(stage, m_textureSamplers[stage], bgfx::TextureHandle{textures[stage]});
+        }
+    }
+
+    bgfx::ProgramHandle Renderer2D::resolveProgram(bgfx::ProgramHandle program) const
+    {
+        if (bgfx::isValid(program)) {
+            return program;
+        }
+        return m_batchMode == BatchMode::Instanced && bgfx::isValid(m_instancedProgram) ? m_instancedProgram : m_program;
+    }
+
+    void Renderer2D::addSprite(const Vector2f& position, const Vector2f& size, const TextureRegion& region,
+                               const Color& color, float rotation)
+    {
+        const SpriteBatchState state{
+            region.texture.idx, resolveProgram(m_batchProgram).idx, static_cast<uint8_t>(m_blendMode)
+        };
+        m_batch.add(m_layer, state, {
+            position.x, position.y, size.x, size.y,
+            region.u0, region.v0, region.u1, region.v1,
+            color.toABGR(), rotation
+        });
+    }
+
+    void Renderer2D::flushSorted()
+    {
+        if (m_batch.empty())
+            return;
+
+        m_batch.sort(m_maxTextureStages);
+
+        const bool index32Supported = (bgfx::getCaps()->supported & BGFX_CAPS_INDEX32) != 0;
+        const auto& draws = m_batch.getDraws();
+        const auto spriteCount = static_cast<uint32_t>(m_batch.getSpriteCount());
+        size_t drawIndex = 0;
+        uint32_t drawOffset = 0;
+
+        // 每次分配尽量多的精灵，一块 transient 缓冲区内可能包含多个绘制段，各段只是索引范围不同
+        while (drawIndex < draws.size()) {
+            const uint32_t first = draws[drawIndex].firstSprite + drawOffset;
+            uint32_t count = spriteCount - first;
+            if (!index32Supported) {
+                count = std::min(count, MAX_SPRITES_INDEX16);
+            }
+            const bool index32 = count > MAX_SPRITES_INDEX16;
+            count = std::min(count, bgfx::getAvailTransientVertexBuffer(
+                count * SpriteBatch::VERTICES_PER_SPRITE, PosColorTexCoordVertex::ms_layout) / SpriteBatch::VERTICES_PER_SPRITE);
+            count = std::min(count, bgfx::getAvailTransientIndexBuffer(
+                count * SpriteBatch::INDICES_PER_SPRITE, index32) / SpriteBatch::INDICES_PER_SPRITE);
+            if (count == 0) {
+                fmt::print("Warning: transient buffers exhausted, dropped {} sprites (limit is {} per frame)\n",
+                           spriteCount - first, SpriteBatch::MAX_SPRITES_PER_FRAME);
+                break;
+            }
+
+            bgfx::TransientVertexBuffer vertices;
+            bgfx::TransientIndexBuffer indices;
+            bgfx::allocTransientVertexBuffer(&vertices, count * SpriteBatch::VERTICES_PER_SPRITE,
+                                             PosColorTexCoordVertex::ms_layout);
+            bgfx::allocTransientIndexBuffer(&indices, count * SpriteBatch::INDICES_PER_SPRITE, index32);
+
+            m_batch.writeVertices(first, count, reinterpret_cast<SpriteVertex*>(vertices.data), m_threadPool);
+            if (index32) {
+                SpriteBatch::writeIndices(count, reinterpret_cast<uint32_t*>(indices.data));
+            } else {
+                SpriteBatch::writeIndices(count, reinterpret_cast<uint16_t*>(indices.data));
+            }
+
+            submitChunk(draws, drawIndex, drawOffset, count,
+                        [&](const SpriteBatch::Draw& draw, uint32_t offset, uint32_t drawCount) {
+                            submitSorted(draw, vertices, indices, offset, drawCount);
+                        });
+        }
+        m_batch.clear();
+    }
+
+    void Renderer2D::flushInstanced()
+    {
+        if (m_batch.empty())
+            return;
+
+        m_batch.sort(m_maxTextureStages);
+
+        constexpr uint16_t stride = sizeof(SpriteInstance);
+        const auto& draws = m_batch.getDraws();
+        const auto spriteCount = static_cast<uint32_t>(m_batch.getSpriteCount());
+        size_t drawIndex = 0;
+        uint32_t drawOffset = 0;
+
+        while (drawIndex < draws.size()) {
+            const uint32_t first = draws[drawIndex].firstSprite + drawOffset;
+            const uint32_t count = bgfx::getAvailInstanceDataBuffer(spriteCount - first, stride);
+            if (count == 0) {
+                fmt::print("Warning: instance data buffer exhausted, dropped {} sprites (limit is {} per frame)\n",
+                           spriteCount - first, SpriteBatch::MAX_SPRITES_PER_FRAME);
+                break;
+            }
+
+            bgfx::InstanceDataBuffer instances;
+            bgfx::allocInstanceDataBuffer(&instances, count, stride);
+            m_batch.writeInstances(first, count, reinterpret_cast<SpriteInstance*>(instances.data), m_threadPool);
+
+            submitChunk(draws, drawIndex, drawOffset, count,
+                        [&](const SpriteBatch::Draw& draw, uint32_t offset, uint32_t drawCount) {
+                            bgfx::setState(getBlendState(static_cast<BlendMode>(draw.blend)));
+                            setTextures(draw.textures, draw.textureCount);
+                            bgfx::setVertexBuffer(0, m_quadVbh);
+                            bgfx::setIndexBuffer(m_quadIbh);
+                            bgfx::setInstanceDataBuffer(&instances, offset, drawCount);
+                            bgfx::submit(m_viewId, bgfx::ProgramHandle{draw.program});
+                        });
+        }
+        m_batch.clear();
+    }
+
+    void Renderer2D::submitSorted(const SpriteBatch::Draw& draw, const bgfx::TransientVertexBuffer& vertices,
+                                  const bgfx::TransientIndexBuffer& indices, uint32_t first, uint32_t count)
+    {
+        bgfx::setState(getBlendState(static_cast<BlendMode>(draw.blend)));
+        setTextures(draw.textures, draw.textureCount);
+
+        bgfx::setVertexBuffer(0, &vertices);
+        bgfx::setIndexBuffer(&indices, first * SpriteBatch::INDICES_PER_SPRITE, count * SpriteBatch::INDICES_PER_SPRITE);
+        bgfx::submit(m_viewId, bgfx::ProgramHandle{draw.program});
     }
 
     void Renderer2D::drawRect(const Vector2f& position, const Vector2f& size, const Color& color)
@@ -216,8 +506,22 @@ namespace Tina
             return;
         }
 
+        if (m_batchMode != BatchMode::Immediate) {
+            addSprite(position, size, TextureRegion{}, color);
+            return;
+        }
+        writeQuad(position, size, color, TextureRegion{}, SpriteBatch::NO_TEXTURE_STAGE);
+    }
+
+    void Renderer2D::writeQuad(const Vector2f& position, const Vector2f& size, const Color& color,
+                               const TextureRegion& region, uint8_t stage)
+    {
         if (checkFlush(4, 6)) {
             flush();
+            // 提交后槽位表被清空，重新登记本四边形的纹理
+            if (stage != SpriteBatch::NO_TEXTURE_STAGE) {
+                stage = acquireTextureStage(region.texture);
+            }
         }
 
         fmt::print("Drawing rect at position ({}, {}), size ({}, {})\n",
@@ -238,8 +542,9 @@ namespace Tina
         m_vertices[m_currentVertex].m_y = y;
         m_vertices[m_currentVertex].m_z = 0.0f;
         m_vertices[m_currentVertex].m_rgba = abgr;
-        m_vertices[m_currentVertex].m_u = 0.0f;
-        m_vertices[m_currentVertex].m_v = 0.0f;
+        m_vertices[m_currentVertex].m_u = region.u0;
+        m_vertices[m_currentVertex].m_v = region.v0;
+        m_vertices[m_currentVertex].m_texture = stage;
         m_currentVertex++;
 
         // 右上
@@ -247,8 +552,9 @@ namespace Tina
         m_vertices[m_currentVertex].m_y = y;
         m_vertices[m_currentVertex].m_z = 0.0f;
         m_vertices[m_currentVertex].m_rgba = abgr;
-        m_vertices[m_currentVertex].m_u = 1.0f;
-        m_vertices[m_currentVertex].m_v = 0.0f;
+        m_vertices[m_currentVertex].m_u = region.u1;
+        m_vertices[m_currentVertex].m_v = region.v0;
+        m_vertices[m_currentVertex].m_texture = stage;
         m_currentVertex++;
 
         // 左下
@@ -256,8 +562,9 @@ namespace Tina
         m_vertices[m_currentVertex].m_y = y + h;
         m_vertices[m_currentVertex].m_z = 0.0f;
         m_vertices[m_currentVertex].m_rgba = abgr;
-        m_vertices[m_currentVertex].m_u = 0.0f;
-        m_vertices[m_currentVertex].m_v = 1.0f;
+        m_vertices[m_currentVertex].m_u = region.u0;
+        m_vertices[m_currentVertex].m_v = region.v1;
+        m_vertices[m_currentVertex].m_texture = stage;
         m_currentVertex++;
 
         // 右下
@@ -265,8 +572,9 @@ namespace Tina
         m_vertices[m_currentVertex].m_y = y + h;
         m_vertices[m_currentVertex].m_z = 0.0f;
         m_vertices[m_currentVertex].m_rgba = abgr;
-        m_vertices[m_currentVertex].m_u = 1.0f;
-        m_vertices[m_currentVertex].m_v = 1.0f;
+        m_vertices[m_currentVertex].m_u = region.u1;
+        m_vertices[m_currentVertex].m_v = region.v1;
+        m_vertices[m_currentVertex].m_texture = stage;
         m_currentVertex++;
 
         // 添加索引 (顺时针顺序)
@@ -281,11 +589,81 @@ namespace Tina
     void Renderer2D::drawTexturedRect(const Vector2f& position, const Vector2f& size,
                                       bgfx::TextureHandle texture, const Color& color)
     {
-        if (m_currentTexture.idx != texture.idx) {
-            flush();
-            m_currentTexture = texture;
+        drawTexturedRect(position, size, TextureRegion{texture}, color);
+    }
+
+    void Renderer2D::drawTexturedRect(const Vector2f& position, const Vector2f& size,
+                                      const TextureRegion& region, const Color& color)
+    {
+        if (!m_isDrawing) {
+            fmt::print("Warning: drawTexturedRect() called without begin()\n");
+            return;
+        }
+
+        if (m_batchMode != BatchMode::Immediate) {
+            addSprite(position, size, region, color);
+            return;
         }
-        drawRect(position, size, color);
+
+        writeQuad(position, size, color, region, acquireTextureStage(region.texture));
+    }
+
+    void Renderer2D::drawRotatedRect(const Vector2f& position, const Vector2f& size, float rotation,
+                                     bgfx::TextureHandle texture, const Color& color)
+    {
+        drawRotatedRect(position, size, rotation, TextureRegion{texture}, color);
+    }
+
+    void Renderer2D::drawRotatedRect(const Vector2f& position, const Vector2f& size, float rotation,
+                                     const TextureRegion& region, const Color& color)
+    {
+        if (m_batchMode == BatchMode::Immediate) {
+            drawTexturedRect(position, size, region, color);
+            return;
+        }
+        if (!m_isDrawing) {
+            fmt::print("Warning: drawRotatedRect() called without begin()\n");
+            return;
+        }
+        addSprite(position, size, region, color, rotation);
+    }
+
+    void Renderer2D::drawTexturedRect(const Vector2f& position, const Vector2f& size,
+                                      TextureResource& texture, const Color& color)
+    {
+        texture.requestScreenSize(std::max(std::abs(size.x), std::abs(size.y)) * m_pixelsPerUnit);
+        drawTexturedRect(position, size, texture.getRegion(), color);
+    }
+
+    void Renderer2D::drawRotatedRect(const Vector2f& position, const Vector2f& size, float rotation,
+                                     TextureResource& texture, const Color& color)
+    {
+        texture.requestScreenSize(std::max(std::abs(size.x), std::abs(size.y)) * m_pixelsPerUnit);
+        drawRotatedRect(position, size, rotation, texture.getRegion(), color);
+    }
+
+    void Renderer2D::RecordContext::drawRect(const Vector2f& position, const Vector2f& size, const Color& color)
+    {
+        drawRotatedRect(position, size, 0.0f, TextureRegion{}, color);
+    }
+
+    void Renderer2D::RecordContext::drawTexturedRect(const Vector2f& position, const Vector2f& size,
+                                                     const TextureRegion& region, const Color& color)
+    {
+        drawRotatedRect(position, size, 0.0f, region, color);
+    }
+
+    void Renderer2D::RecordContext::drawRotatedRect(const Vector2f& position, const Vector2f& size, float rotation,
+                                                    const TextureRegion& region, const Color& color)
+    {
+        const SpriteBatchState state{
+            region.texture.idx, m_renderer->resolveProgram(m_program).idx, static_cast<uint8_t>(m_blendMode)
+        };
+        m_batch.add(m_layer, state, {
+            position.x, position.y, size.x, size.y,
+            region.u0, region.v0, region.u1, region.v1,
+            color.toABGR(), rotation
+        });
     }
 
     void Renderer2D::render()
@@ -1,23 +1,23 @@
 #pragma once
 
 #include <bgfx/bgfx.h>
+#include <memory>
+#include <vector>
 
 #include "Color.hpp"
 #include "math/Vector.hpp"
 #include "Camera.hpp"
+#include "core/ThreadPool.hpp"
+#include "SpriteBatch.hpp"
+#include "Texture.hpp"
 
 namespace Tina
 {
-    // 顶点结构体，包含位置、颜色和纹理坐标
-    struct PosColorTexCoordVertex
-    {
-        float m_x;
-        float m_y;
-        float m_z;
-        uint32_t m_rgba;
-        float m_u;
-        float m_v;
+    class TextureResource;
 
+    // 顶点结构体，包含位置、颜色、纹理坐标和纹理槽位
+    struct PosColorTexCoordVertex : SpriteVertex
+    {
         static void init()
         {
             ms_layout
@@ -25,6 +25,7 @@ namespace Tina
                 .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
                 .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
                 .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+                .add(bgfx::Attrib::TexCoord1, 1, bgfx::AttribType::Float)
                 .end();
         }
 
@@ -34,6 +35,57 @@ namespace Tina
     class Renderer2D
     {
     public:
+        enum class BatchMode
+        {
+            // 立即写入固定大小的缓冲区，纹理槽位用完或缓冲区写满时提交
+            Immediate,
+            // 整帧记录后在 end() 中按层和状态排序，用 transient 缓冲区一次性提交
+            Sorted,
+            // 与 Sorted 相同地排序，但每个精灵只写一份实例数据，由 GPU 展开静态的单位四边形；
+            // 不支持实例化的设备上退回 Sorted
+            Instanced,
+        };
+
+        enum class BlendMode : uint8_t
+        {
+            // 预乘 alpha
+            Alpha,
+            Additive,
+            Opaque,
+        };
+
+        /**
+         * 供工作线程使用的录制上下文：在 begin() 和 end() 之间记录精灵，不调用 bgfx。
+         * 每个上下文同一时间只能由一个线程使用，所有线程必须在 end() 之前完成录制；
+         * end() 按上下文编号的顺序把它们追加在主线程记录的精灵之后，再与主线程的精灵一起排序提交，
+         * 因此结果与各线程的执行先后无关。层、混合模式和程序各上下文独立设置。
+         */
+        class RecordContext
+        {
+        public:
+            void setLayer(int16_t layer) { m_layer = layer; }
+            void setBlendMode(BlendMode mode) { m_blendMode = mode; }
+            void setProgram(bgfx::ProgramHandle program) { m_program = program; }
+            void reserve(size_t spriteCount) { m_batch.reserve(spriteCount); }
+
+            void drawRect(const Vector2f& position, const Vector2f& size, const Color& color);
+            void drawTexturedRect(const Vector2f& position, const Vector2f& size,
+                                  const TextureRegion& region, const Color& color = Color::White);
+            void drawRotatedRect(const Vector2f& position, const Vector2f& size, float rotation,
+                                 const TextureRegion& region, const Color& color = Color::White);
+
+        private:
+            friend class Renderer2D;
+
+            explicit RecordContext(const Renderer2D* renderer) : m_renderer(renderer) {}
+
+            const Renderer2D* m_renderer;
+            SpriteBatch m_batch;
+            int16_t m_layer = 0;
+            BlendMode m_blendMode = BlendMode::Alpha;
+            bgfx::ProgramHandle m_program = BGFX_INVALID_HANDLE;
+        };
+
         explicit Renderer2D(uint16_t viewId = 0);
         ~Renderer2D();
 
@@ -46,12 +98,52 @@ namespace Tina
         // 设置相机
         void setCamera(const Camera* camera) { m_camera = camera; }
 
+        // 只能在 begin() 之前切换
+        void setBatchMode(BatchMode mode);
+        [[nodiscard]] BatchMode getBatchMode() const { return m_batchMode; }
+
+        // 以下状态只影响 Sorted 模式：层小的先绘制，同一层内按程序、混合模式和纹理合并
+        void setLayer(int16_t layer) { m_layer = layer; }
+        void setBlendMode(BlendMode mode) { m_blendMode = mode; }
+        // 无效句柄表示使用默认的精灵着色器；自定义程序需要按顶点（或实例数据）中的槽位选择 s_texColor ~ s_texColor7，
+        // Instanced 模式下的程序需要读取与 sprite_instanced 相同的实例数据
+        void setProgram(bgfx::ProgramHandle program) { m_batchProgram = program; }
+
+        // 一次绘制最多同时绑定的纹理数，不超过 SpriteBatch::MAX_TEXTURE_STAGES 和设备的采样器数量；
+        // 设为 1 时每次切换纹理都提交一次。只能在 begin() 之前修改
+        void setMaxTextureStages(uint8_t count);
+        [[nodiscard]] uint8_t getMaxTextureStages() const { return m_maxTextureStages; }
+
+        // 录制上下文的数量，通常每个工作线程一个；只能在 begin() 之前修改。
+        // 上下文记录的精灵总是排序提交，Immediate 模式下在主线程的四边形之后绘制
+        void setRecordContextCount(size_t count);
+        [[nodiscard]] size_t getRecordContextCount() const { return m_contexts.size(); }
+        [[nodiscard]] RecordContext& getRecordContext(size_t index) { return *m_contexts[index]; }
+
+        // 设置后 end() 中的顶点和实例数据由线程池与主线程分段并行写出，为空时在主线程写出
+        void setThreadPool(ThreadPool* pool) { m_threadPool = pool; }
+
         // 绘制纯色矩形
         void drawRect(const Vector2f& position, const Vector2f& size, const Color& color);
 
         // 绘制纹理矩形
         void drawTexturedRect(const Vector2f& position, const Vector2f& size, 
                             bgfx::TextureHandle texture, const Color& color = Color::White);
+        // 绘制纹理的一部分，例如 TextureAtlas 中的子图；同一图集页的精灵可以合并到同一次绘制
+        void drawTexturedRect(const Vector2f& position, const Vector2f& size,
+                              const TextureRegion& region, const Color& color = Color::White);
+
+        // 绕矩形中心旋转 rotation 弧度后绘制，Immediate 模式下忽略旋转
+        void drawRotatedRect(const Vector2f& position, const Vector2f& size, float rotation,
+                             bgfx::TextureHandle texture, const Color& color = Color::White);
+        void drawRotatedRect(const Vector2f& position, const Vector2f& size, float rotation,
+                             const TextureRegion& region, const Color& color = Color::White);
+
+        // 绘制纹理资源，同时把绘制的屏幕尺寸报告给它，流式加载的纹理据此选择需要的 mip
+        void drawTexturedRect(const Vector2f& position, const Vector2f& size,
+                              TextureResource& texture, const Color& color = Color::White);
+        void drawRotatedRect(const Vector2f& position, const Vector2f& size, float rotation,
+                             TextureResource& texture, const Color& color = Color::White);
 
         // 开始和结束批处理
         void begin();
@@ -67,12 +159,34 @@ namespace Tina
         // 检查是否需要刷新批处理
         bool checkFlush(uint16_t vertexCount, uint16_t indexCount);
 
+        // Sorted 模式：记录一个精灵，end() 时排序提交
+        // Immediate 模式：写入一个四边形，缓冲区满时先提交
+        void writeQuad(const Vector2f& position, const Vector2f& size, const Color& color, const TextureRegion& region,
+                       uint8_t stage);
+        // Immediate 模式：返回纹理所在的槽位，槽位用完时先提交
+        uint8_t acquireTextureStage(bgfx::TextureHandle texture);
+        void setTextures(const uint16_t* textures, uint8_t count);
+
+        void addSprite(const Vector2f& position, const Vector2f& size, const TextureRegion& region, const Color& color,
+                       float rotation = 0.0f);
+        // 无效句柄时返回当前批处理模式的默认程序，录制上下文在工作线程中调用
+        bgfx::ProgramHandle resolveProgram(bgfx::ProgramHandle program) const;
+        // 把各录制上下文的精灵追加到 m_batch
+        void mergeRecordContexts();
+        void flushSorted();
+        void flushInstanced();
+        void submitSorted(const SpriteBatch::Draw& draw, const bgfx::TransientVertexBuffer& vertices,
+                          const bgfx::TransientIndexBuffer& indices, uint32_t first, uint32_t count);
+
         uint16_t m_viewId;  // 视图ID
         const Camera* m_camera;  // 当前相机
+        // begin() 时按相机投影和视口宽度算出的每单位长度对应的像素数，用于估计纹理的屏幕尺寸
+        float m_pixelsPerUnit = 1.0f;
         bgfx::ProgramHandle m_program;
         bgfx::DynamicVertexBufferHandle m_vbh;
         bgfx::DynamicIndexBufferHandle m_ibh;
-        bgfx::UniformHandle m_s_texColor; // 纹理采样器uniform
+        // 各纹理槽位的采样器 uniform，槽位 0 为 s_texColor
+        bgfx::UniformHandle m_textureSamplers[SpriteBatch::MAX_TEXTURE_STAGES];
 
         // 批处理相关
         static const uint16_t MAX_VERTICES = 1024;
@@ -83,7 +197,23 @@ namespace Tina
         uint16_t m_currentVertex;
         uint16_t m_currentIndex;
 
-        bgfx::TextureHandle m_currentTexture;
+        // Immediate 模式当前批次绑定的纹理
+        uint16_t m_stageTextures[SpriteBatch::MAX_TEXTURE_STAGES];
+        uint8_t m_stageCount = 0;
+        uint8_t m_maxTextureStages = SpriteBatch::MAX_TEXTURE_STAGES;
         bool m_isDrawing;
+
+        BatchMode m_batchMode = BatchMode::Immediate;
+        SpriteBatch m_batch;
+        int16_t m_layer = 0;
+        BlendMode m_blendMode = BlendMode::Alpha;
+        bgfx::ProgramHandle m_batchProgram = BGFX_INVALID_HANDLE;
+        // Instanced 模式：单位四边形和对应的着色器程序
+        bgfx::ProgramHandle m_instancedProgram = BGFX_INVALID_HANDLE;
+        bgfx::VertexBufferHandle m_quadVbh = BGFX_INVALID_HANDLE;
+        bgfx::IndexBufferHandle m_quadIbh = BGFX_INVALID_HANDLE;
+
+        std::vector<std::unique_ptr<RecordContext>> m_contexts;
+        ThreadPool* m_threadPool = nullptr;
     };
 }
\ No newline at end of file
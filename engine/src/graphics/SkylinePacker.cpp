@@ -0,0 +1,179 @@
+#include "SkylinePacker.hpp"
+
+#include <algorithm>
+#include <climits>
+
+namespace Tina
+{
+    SkylinePacker::SkylinePacker(uint16_t width, uint16_t height)
+    {
+        reset(width, height);
+    }
+
+    void SkylinePacker::reset(uint16_t width, uint16_t height)
+    {
+        m_width = width;
+        m_height = height;
+        m_usedArea = 0;
+        m_skyline.clear();
+        m_skyline.push_back({0, 0, width});
+        m_freeRects.clear();
+    }
+
+    bool SkylinePacker::insert(uint16_t width, uint16_t height, Rect& out)
+    {
+        if (width == 0 || height == 0)
+        {
+            return false;
+        }
+        if (insertFree(width, height, out))
+        {
+            return true;
+        }
+
+        size_t bestIndex = SIZE_MAX;
+        int bestBottom = INT_MAX;
+        int bestWidth = INT_MAX;
+        int bestY = 0;
+        for (size_t i = 0; i < m_skyline.size(); ++i)
+        {
+            const int y = fit(i, width, height);
+            if (y < 0)
+            {
+                continue;
+            }
+            const int bottom = y + height;
+            if (bottom < bestBottom || (bottom == bestBottom && m_skyline[i].width < bestWidth))
+            {
+                bestIndex = i;
+                bestBottom = bottom;
+                bestWidth = m_skyline[i].width;
+                bestY = y;
+            }
+        }
+        if (bestIndex == SIZE_MAX)
+        {
+            return false;
+        }
+
+        const int x = m_skyline[bestIndex].x;
+        m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), {x, bestBottom, width});
+
+        // 新段覆盖的部分从后面的段中去掉
+        const int right = x + width;
+        for (size_t i = bestIndex + 1; i < m_skyline.size();)
+        {
+            Segment& segment = m_skyline[i];
+            if (segment.x >= right)
+            {
+                break;
+            }
+            const int overlap = right - segment.x;
+            if (overlap >= segment.width)
+            {
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+            segment.x += overlap;
+            segment.width -= overlap;
+            break;
+        }
+
+        // 合并高度相同的相邻段
+        for (size_t i = 0; i + 1 < m_skyline.size();)
+        {
+            if (m_skyline[i].y == m_skyline[i + 1].y)
+            {
+                m_skyline[i].width += m_skyline[i + 1].width;
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        out = {static_cast<uint16_t>(x), static_cast<uint16_t>(bestY), width, height};
+        m_usedArea += static_cast<uint64_t>(width) * height;
+        return true;
+    }
+
+    void SkylinePacker::remove(const Rect& rect)
+    {
+        const uint64_t area = static_cast<uint64_t>(rect.width) * rect.height;
+        m_usedArea -= std::min(area, m_usedArea);
+        if (m_usedArea == 0)
+        {
+            reset(m_width, m_height);
+            return;
+        }
+        m_freeRects.push_back(rect);
+    }
+
+    bool SkylinePacker::insertFree(uint16_t width, uint16_t height, Rect& out)
+    {
+        size_t bestIndex = SIZE_MAX;
+        uint64_t bestArea = UINT64_MAX;
+        for (size_t i = 0; i < m_freeRects.size(); ++i)
+        {
+            const Rect& rect = m_freeRects[i];
+            const uint64_t area = static_cast<uint64_t>(rect.width) * rect.height;
+            if (rect.width >= width && rect.height >= height && area < bestArea)
+            {
+                bestIndex = i;
+                bestArea = area;
+            }
+        }
+        if (bestIndex == SIZE_MAX)
+        {
+            return false;
+        }
+
+        const Rect rect = m_freeRects[bestIndex];
+        m_freeRects.erase(m_freeRects.begin() + static_cast<std::ptrdiff_t>(bestIndex));
+
+        // 剩余部分切成右侧（与新矩形同高）和下方（整个宽度）两块
+        if (rect.width > width)
+        {
+            m_freeRects.push_back({static_cast<uint16_t>(rect.x + width), rect.y,
+                                   static_cast<uint16_t>(rect.width - width), height});
+        }
+        if (rect.height > height)
+        {
+            m_freeRects.push_back({rect.x, static_cast<uint16_t>(rect.y + height),
+                                   rect.width, static_cast<uint16_t>(rect.height - height)});
+        }
+
+        out = {rect.x, rect.y, width, height};
+        m_usedArea += static_cast<uint64_t>(width) * height;
+        return true;
+    }
+
+    float SkylinePacker::getOccupancy() const
+    {
+        const uint64_t area = static_cast<uint64_t>(m_width) * m_height;
+        return area > 0 ? static_cast<float>(m_usedArea) / static_cast<float>(area) : 0.0f;
+    }
+
+    int SkylinePacker::fit(size_t index, int width, int height) const
+    {
+        if (m_skyline[index].x + width > m_width)
+        {
+            return -1;
+        }
+
+        // 矩形跨过的各段中最高的一段决定放置高度
+        int y = 0;
+        int remaining = width;
+        for (size_t i = index; remaining > 0; ++i)
+        {
+            y = std::max(y, m_skyline[i].y);
+            if (y + height > m_height)
+            {
+                return -1;
+            }
+            remaining -= m_skyline[i].width;
+        }
+        return y;
+    }
+}
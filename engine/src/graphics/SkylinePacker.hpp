@@ -0,0 +1,64 @@
+#ifndef TINA_GRAPHICS_SKYLINE_PACKER_HPP
+#define TINA_GRAPHICS_SKYLINE_PACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Tina
+{
+    /**
+     * 天际线矩形装箱：记录已放置区域的上轮廓，新矩形放在使其底边最低的位置（bottom-left），
+     * 相同时选择更窄的轮廓段以减少碎片。
+     * remove 释放的矩形进入空闲列表，insert 优先从中选择剩余面积最小的一块并把多出的部分切分后放回；
+     * 所有矩形都释放后整体重置。空闲块之间不合并。
+     */
+    class SkylinePacker
+    {
+    public:
+        struct Rect
+        {
+            uint16_t x;
+            uint16_t y;
+            uint16_t width;
+            uint16_t height;
+        };
+
+        SkylinePacker() = default;
+        SkylinePacker(uint16_t width, uint16_t height);
+
+        void reset(uint16_t width, uint16_t height);
+
+        // 空间不足时返回 false
+        bool insert(uint16_t width, uint16_t height, Rect& out);
+        // 释放 insert 返回的矩形，之后可以被新的矩形复用
+        void remove(const Rect& rect);
+
+        [[nodiscard]] uint16_t getWidth() const { return m_width; }
+        [[nodiscard]] uint16_t getHeight() const { return m_height; }
+        // 已放置矩形的面积占比
+        [[nodiscard]] float getOccupancy() const;
+
+    private:
+        // 轮廓上的一段，从 x 开始宽 width，高度为 y
+        struct Segment
+        {
+            int x;
+            int y;
+            int width;
+        };
+
+        // 以第 index 段为左端放置矩形时的高度，放不下时返回 -1
+        [[nodiscard]] int fit(size_t index, int width, int height) const;
+        // 从空闲列表中分配，没有合适的空闲块时返回 false
+        bool insertFree(uint16_t width, uint16_t height, Rect& out);
+
+        uint16_t m_width = 0;
+        uint16_t m_height = 0;
+        uint64_t m_usedArea = 0;
+        std::vector<Segment> m_skyline;
+        std::vector<Rect> m_freeRects;
+    };
+}
+
+#endif //TINA_GRAPHICS_SKYLINE_PACKER_HPP
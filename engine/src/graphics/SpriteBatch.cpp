@@ -0,0 +1,235 @@
+#include "SpriteBatch.hpp"
+#include "core/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+namespace Tina
+{
+    namespace
+    {
+        template <typename Index>
+        void writeQuadIndices(uint32_t spriteCount, Index* out)
+        {
+            for (uint32_t i = 0; i < spriteCount; ++i)
+            {
+                const auto base = static_cast<Index>(i * SpriteBatch::VERTICES_PER_SPRITE);
+                // 与 Renderer2D::drawRect 相同的顺时针顺序：左上、右上、左下 / 右上、右下、左下
+                *out++ = base + 0;
+                *out++ = base + 1;
+                *out++ = base + 2;
+                *out++ = base + 1;
+                *out++ = base + 3;
+                *out++ = base + 2;
+            }
+        }
+
+        // 把 count 个精灵平均分成若干段，除第一段外提交到线程池，第一段由调用线程写出；
+        // write(段起点相对 first 的偏移, 段内数量)
+        template <typename Write>
+        void writeParallel(ThreadPool* pool, uint32_t count, Write&& write)
+        {
+            uint32_t taskCount = 1;
+            if (pool)
+            {
+                taskCount = static_cast<uint32_t>(std::min<size_t>(pool->getThreadCount() + 1,
+                                                                   count / SpriteBatch::MIN_SPRITES_PER_TASK));
+            }
+            if (taskCount <= 1)
+            {
+                write(0, count);
+                return;
+            }
+
+            const uint32_t perTask = (count + taskCount - 1) / taskCount;
+            std::vector<std::future<void>> futures;
+            futures.reserve(taskCount - 1);
+            for (uint32_t offset = perTask; offset < count; offset += perTask)
+            {
+                const uint32_t taskSprites = std::min(perTask, count - offset);
+                futures.push_back(pool->submit([&write, offset, taskSprites]() { write(offset, taskSprites); }));
+            }
+            write(0, perTask);
+            for (auto& future : futures)
+            {
+                future.get();
+            }
+        }
+    }
+
+    void SpriteBatch::clear()
+    {
+        m_sprites.clear();
+        m_entries.clear();
+        m_draws.clear();
+    }
+
+    void SpriteBatch::reserve(size_t spriteCount)
+    {
+        m_sprites.reserve(spriteCount);
+        m_entries.reserve(spriteCount);
+    }
+
+    void SpriteBatch::add(int16_t layer, const SpriteBatchState& state, const Sprite& sprite)
+    {
+        m_entries.push_back({makeKey(layer, state), static_cast<uint32_t>(m_sprites.size()), NO_TEXTURE_STAGE});
+        m_sprites.push_back(sprite);
+    }
+
+    void SpriteBatch::append(const SpriteBatch& other)
+    {
+        const auto base = static_cast<uint32_t>(m_sprites.size());
+        m_sprites.insert(m_sprites.end(), other.m_sprites.begin(), other.m_sprites.end());
+        m_entries.reserve(m_entries.size() + other.m_entries.size());
+        for (const Entry& entry : other.m_entries)
+        {
+            m_entries.push_back({entry.key, base + entry.index, NO_TEXTURE_STAGE});
+        }
+    }
+
+    void SpriteBatch::sort(uint8_t maxTextures)
+    {
+        maxTextures = std::clamp<uint8_t>(maxTextures, 1, MAX_TEXTURE_STAGES);
+
+        // 键相同时按提交顺序，结果与 stable_sort 相同但不需要额外的缓冲区
+        std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b)
+        {
+            return a.key != b.key ? a.key < b.key : a.index < b.index;
+        });
+
+        m_draws.clear();
+        for (uint32_t i = 0; i < m_entries.size(); ++i)
+        {
+            Entry& entry = m_entries[i];
+            const auto program = static_cast<uint16_t>(entry.key >> 24);
+            const auto blend = static_cast<uint8_t>(entry.key >> 16);
+            const auto texture = static_cast<uint16_t>(entry.key);
+            const bool textured = texture != UINT16_MAX;
+
+            if (!m_draws.empty() && m_draws.back().program == program && m_draws.back().blend == blend)
+            {
+                Draw& draw = m_draws.back();
+                // 同一层内纹理是有序的，通常就是最后一个槽位；跨层时才需要查找
+                uint8_t stage = draw.textureCount;
+                for (uint8_t s = draw.textureCount; textured && s > 0; --s)
+                {
+                    if (draw.textures[s - 1] == texture)
+                    {
+                        stage = s - 1;
+                        break;
+                    }
+                }
+                if (textured && stage == draw.textureCount && draw.textureCount < maxTextures)
+                {
+                    draw.textures[draw.textureCount++] = texture;
+                }
+                if (!textured || stage < draw.textureCount)
+                {
+                    entry.stage = textured ? stage : NO_TEXTURE_STAGE;
+                    ++draw.spriteCount;
+                    continue;
+                }
+            }
+
+            Draw draw{program, blend, 0, {}, i, 1};
+            if (textured)
+            {
+                draw.textures[draw.textureCount++] = texture;
+            }
+            entry.stage = textured ? 0 : NO_TEXTURE_STAGE;
+            m_draws.push_back(draw);
+        }
+    }
+
+    void SpriteBatch::writeVertices(uint32_t first, uint32_t count, SpriteVertex* out, ThreadPool* pool) const
+    {
+        writeParallel(pool, count, [&](uint32_t offset, uint32_t taskCount)
+        {
+            writeVerticesRange(first + offset, taskCount, out + offset * VERTICES_PER_SPRITE);
+        });
+    }
+
+    void SpriteBatch::writeInstances(uint32_t first, uint32_t count, SpriteInstance* out, ThreadPool* pool) const
+    {
+        writeParallel(pool, count, [&](uint32_t offset, uint32_t taskCount)
+        {
+            writeInstancesRange(first + offset, taskCount, out + offset);
+        });
+    }
+
+    void SpriteBatch::writeVerticesRange(uint32_t first, uint32_t count, SpriteVertex* out) const
+    {
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            const Sprite& sprite = m_sprites[m_entries[i].index];
+            const auto stage = static_cast<float>(m_entries[i].stage);
+            if (sprite.rotation == 0.0f)
+            {
+                const float x0 = sprite.x;
+                const float y0 = sprite.y;
+                const float x1 = sprite.x + sprite.width;
+                const float y1 = sprite.y + sprite.height;
+
+                *out++ = {x0, y0, 0.0f, sprite.abgr, sprite.u0, sprite.v0, stage}; // 左上
+                *out++ = {x1, y0, 0.0f, sprite.abgr, sprite.u1, sprite.v0, stage}; // 右上
+                *out++ = {x0, y1, 0.0f, sprite.abgr, sprite.u0, sprite.v1, stage}; // 左下
+                *out++ = {x1, y1, 0.0f, sprite.abgr, sprite.u1, sprite.v1, stage}; // 右下
+                continue;
+            }
+
+            // 与 sprite_instanced.vs.sc 相同：四个角相对中心旋转
+            const float halfWidth = sprite.width * 0.5f;
+            const float halfHeight = sprite.height * 0.5f;
+            const float centerX = sprite.x + halfWidth;
+            const float centerY = sprite.y + halfHeight;
+            const float c = std::cos(sprite.rotation);
+            const float s = std::sin(sprite.rotation);
+            const auto corner = [&](float dx, float dy, float u, float v)
+            {
+                return SpriteVertex{centerX + dx * c - dy * s, centerY + dx * s + dy * c, 0.0f, sprite.abgr, u, v, stage};
+            };
+
+            *out++ = corner(-halfWidth, -halfHeight, sprite.u0, sprite.v0);
+            *out++ = corner(halfWidth, -halfHeight, sprite.u1, sprite.v0);
+            *out++ = corner(-halfWidth, halfHeight, sprite.u0, sprite.v1);
+            *out++ = corner(halfWidth, halfHeight, sprite.u1, sprite.v1);
+        }
+    }
+
+    void SpriteBatch::writeInstancesRange(uint32_t first, uint32_t count, SpriteInstance* out) const
+    {
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            const Sprite& sprite = m_sprites[m_entries[i].index];
+            // ABGR 的低 16 位为 r、g，高 16 位为 b、a，正好是 r + g * 256 和 b + a * 256
+            *out++ = {
+                sprite.x, sprite.y, sprite.width, sprite.height,
+                sprite.u0, sprite.v0, sprite.u1, sprite.v1,
+                static_cast<float>(sprite.abgr & 0xffff),
+                static_cast<float>(sprite.abgr >> 16),
+                sprite.rotation, static_cast<float>(m_entries[i].stage)
+            };
+        }
+    }
+
+    void SpriteBatch::writeIndices(uint32_t spriteCount, uint16_t* out)
+    {
+        writeQuadIndices(spriteCount, out);
+    }
+
+    void SpriteBatch::writeIndices(uint32_t spriteCount, uint32_t* out)
+    {
+        writeQuadIndices(spriteCount, out);
+    }
+
+    uint64_t SpriteBatch::makeKey(int16_t layer, const SpriteBatchState& state)
+    {
+        // 翻转符号位，使负的层排在前面
+        const uint64_t biasedLayer = static_cast<uint16_t>(layer) ^ 0x8000u;
+        return biasedLayer << 40
+            | static_cast<uint64_t>(state.program) << 24
+            | static_cast<uint64_t>(state.blend) << 16
+            | state.texture;
+    }
+}
@@ -0,0 +1,160 @@
+#ifndef TINA_GRAPHICS_SPRITE_BATCH_HPP
+#define TINA_GRAPHICS_SPRITE_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Tina
+{
+    class ThreadPool;
+
+    // 2D 四边形的顶点数据，Renderer2D 的 PosColorTexCoordVertex 在此基础上加上 bgfx 顶点布局
+    struct SpriteVertex
+    {
+        float m_x;
+        float m_y;
+        float m_z;
+        uint32_t m_rgba;
+        float m_u;
+        float m_v;
+        // 采样的纹理槽位，不小于绘制段的纹理数时只使用顶点颜色
+        float m_texture;
+    };
+
+    // 实例化绘制时每个精灵的数据，依次对应 sprite_instanced 着色器的 i_data0 ~ i_data2。
+    // bgfx 的实例数据总是按 float4 读取，不能声明 Uint8 归一化属性，GLSL 120 也没有 floatBitsToUint，
+    // 因此颜色的 4 个 8 位通道两两合成一个 0 ~ 65535 的整数存入 float（可以精确表示），由着色器拆开
+    struct SpriteInstance
+    {
+        float x;
+        float y;
+        float width;
+        float height;
+        float u0;
+        float v0;
+        float u1;
+        float v1;
+        // r + g * 256 和 b + a * 256，各通道为 0 ~ 255
+        float colorRG;
+        float colorBA;
+        float rotation;
+        // 与 SpriteVertex::m_texture 相同的纹理槽位。Renderer2D 绑定的是尺寸各异的普通 2D 纹理（图集页和独立纹理），
+        // 无法放进同一个纹理数组，因此这里不是纹理数组的层，而是同一次绘制中 s_texColor ~ s_texColor7 的编号
+        float texture;
+    };
+
+    static_assert(sizeof(SpriteInstance) == 48, "Instance data stride must be a multiple of 16 bytes");
+
+    // 决定能否合并到同一次绘制的状态，纹理和着色器程序为 bgfx 句柄的 idx
+    struct SpriteBatchState
+    {
+        uint16_t texture;
+        uint16_t program;
+        uint8_t blend;
+    };
+
+    /**
+     * 按帧记录的精灵命令列表：整帧的精灵先记录下来，按 (layer, program, blend, texture) 排序后
+     * 合并成尽量少的绘制段，再整体写出顶点和索引。
+     * 程序和混合模式相同的相邻精灵最多可以使用 maxTextures 张不同的纹理，各自绑定到一个槽位，
+     * 顶点中记录槽位，由着色器选择采样器；槽位用完时才开始新的绘制段。
+     * 同一层内不同状态的精灵之间不保证绘制顺序，需要确定前后关系时使用不同的层；
+     * 状态相同的精灵保持提交顺序。
+     * 每个线程各自记录到一个 SpriteBatch，再按固定顺序 append 到一起，结果与线程的执行先后无关。
+     */
+    class SpriteBatch
+    {
+    public:
+        static constexpr uint32_t VERTICES_PER_SPRITE = 4;
+        static constexpr uint32_t INDICES_PER_SPRITE = 6;
+        // 一个绘制段最多绑定的纹理数，与 sprite.fs.sc 中的采样器数量一致
+        static constexpr uint8_t MAX_TEXTURE_STAGES = 8;
+        // 没有纹理的精灵使用的槽位，着色器对超出范围的槽位不采样
+        static constexpr uint8_t NO_TEXTURE_STAGE = 0xff;
+        // 并行写出时每个任务至少处理的精灵数，太少时分发任务的开销超过收益
+        static constexpr uint32_t MIN_SPRITES_PER_TASK = 4096;
+        // 每帧保证能完整绘制的精灵数，超出时 Renderer2D 丢弃放不下的精灵
+        static constexpr uint32_t MAX_SPRITES_PER_FRAME = 100000;
+        // 容纳 MAX_SPRITES_PER_FRAME 个精灵所需的 transient 缓冲区大小（排序批处理、32 位索引），
+        // bgfx 初始化时在默认大小之上加上这部分，见 GLFWWindow
+        static constexpr uint32_t TRANSIENT_VERTEX_BUFFER_SIZE =
+            MAX_SPRITES_PER_FRAME * VERTICES_PER_SPRITE * sizeof(SpriteVertex);
+        static constexpr uint32_t TRANSIENT_INDEX_BUFFER_SIZE =
+            MAX_SPRITES_PER_FRAME * INDICES_PER_SPRITE * sizeof(uint32_t);
+
+        struct Sprite
+        {
+            float x;
+            float y;
+            float width;
+            float height;
+            float u0;
+            float v0;
+            float u1;
+            float v1;
+            uint32_t abgr;
+            // 绕矩形中心顺时针旋转的弧度
+            float rotation = 0.0f;
+        };
+
+        // 排序后连续、程序和混合模式相同的一段精灵，textures[i] 绑定到槽位 i
+        struct Draw
+        {
+            uint16_t program;
+            uint8_t blend;
+            uint8_t textureCount;
+            uint16_t textures[MAX_TEXTURE_STAGES];
+            uint32_t firstSprite;
+            uint32_t spriteCount;
+        };
+
+        void clear();
+        void reserve(size_t spriteCount);
+        void add(int16_t layer, const SpriteBatchState& state, const Sprite& sprite);
+        // 追加另一个批次记录的精灵，排在本批次已有的精灵之后；other 需要尚未排序
+        void append(const SpriteBatch& other);
+
+        // 排序并生成绘制段，之后按排序后的下标访问精灵；maxTextures 为一个绘制段可用的纹理槽位数
+        void sort(uint8_t maxTextures = 1);
+
+        [[nodiscard]] size_t getSpriteCount() const { return m_sprites.size(); }
+        [[nodiscard]] bool empty() const { return m_sprites.empty(); }
+        [[nodiscard]] const std::vector<Draw>& getDraws() const { return m_draws; }
+
+        // 写出排序后第 first 个起 count 个精灵的顶点，每个精灵 VERTICES_PER_SPRITE 个；
+        // pool 不为空且精灵足够多时分段由线程池和调用线程并行写出，输出与串行时相同
+        void writeVertices(uint32_t first, uint32_t count, SpriteVertex* out, ThreadPool* pool = nullptr) const;
+
+        // 写出排序后第 first 个起 count 个精灵的实例数据，每个精灵一个
+        void writeInstances(uint32_t first, uint32_t count, SpriteInstance* out, ThreadPool* pool = nullptr) const;
+
+        // 写出 spriteCount 个四边形的索引，顶点从 0 开始编号
+        static void writeIndices(uint32_t spriteCount, uint16_t* out);
+        static void writeIndices(uint32_t spriteCount, uint32_t* out);
+
+        // 高位到低位依次为层、程序、混合模式、纹理，层按有符号数排序
+        static uint64_t makeKey(int16_t layer, const SpriteBatchState& state);
+
+    private:
+        void writeVerticesRange(uint32_t first, uint32_t count, SpriteVertex* out) const;
+        void writeInstancesRange(uint32_t first, uint32_t count, SpriteInstance* out) const;
+
+        struct Entry
+        {
+            uint64_t key;
+            uint32_t index;
+            uint8_t stage;
+        };
+
+        std::vector<Sprite> m_sprites;
+        std::vector<Entry> m_entries;
+        std::vector<Draw> m_draws;
+    };
+
+    // 实例数据同样分配自 transient 顶点缓冲区
+    static_assert(SpriteBatch::MAX_SPRITES_PER_FRAME * sizeof(SpriteInstance) <= SpriteBatch::TRANSIENT_VERTEX_BUFFER_SIZE,
+                  "Instanced batching must fit in the transient vertex buffer reserved for sorted batching");
+}
+
+#endif //TINA_GRAPHICS_SPRITE_BATCH_HPP
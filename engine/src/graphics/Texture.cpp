@@ -1,4 +1,5 @@
 #include "Texture.hpp"
+#include "tool/BgfxUtils.hpp"
 #include <bimg/decode.h>
 #include <bx/file.h>
 #include <bx/allocator.h>
@@ -6,9 +7,6 @@
 #include <bx/bx.h>
 
 namespace Tina {
-    
-    static bx::DefaultAllocator s_allocator;
-    static bx::Error s_error;
 
     Texture::Texture() : m_handle(BGFX_INVALID_HANDLE) {
     }
@@ -50,41 +48,12 @@ namespace Tina {
     }
 
     TextureHandle Texture::loadFromFile(const std::string& filename) {
-        bx::FileReader reader;
-        if (!bx::open(&reader, filename.c_str(), &s_error)) {
-            return BGFX_INVALID_HANDLE;
-        }
-
-        uint32_t size = (uint32_t)bx::getSize(&reader);
-        void* data = bx::alloc(&s_allocator, size);
-        bx::read(&reader, data, size, &s_error);
-        bx::close(&reader);
-
-        TextureHandle handle = loadFromMemory(data, size);
-        bx::free(&s_allocator, data);
-
-        return handle;
+        // 与资源管理器走同一条路径：优先使用构建时生成的 .ktx，并保证 alpha 已预乘
+        return BgfxUtils::createTexture(BgfxUtils::decodeImage(filename.c_str()), BGFX_TEXTURE_NONE | BGFX_SAMPLER_NONE);
     }
 
     TextureHandle Texture::loadFromMemory(const void* data, uint32_t size) {
-        bimg::ImageContainer* imageContainer = bimg::imageParse(&s_allocator, data, size);
-        if (!imageContainer) {
-            return BGFX_INVALID_HANDLE;
-        }
-
-        const bgfx::Memory* mem = bgfx::copy(imageContainer->m_data, imageContainer->m_size);
-
-        TextureHandle handle = bgfx::createTexture2D(
-            uint16_t(imageContainer->m_width),
-            uint16_t(imageContainer->m_height),
-            1 < imageContainer->m_numMips,
-            imageContainer->m_numLayers,
-            bgfx::TextureFormat::Enum(imageContainer->m_format),
-            BGFX_TEXTURE_NONE | BGFX_SAMPLER_NONE,
-            mem
-        );
-
-        bimg::imageFree(imageContainer);
-        return handle;
+        // 与 loadFromFile 相同，源图片数据在解码时预乘 alpha
+        return BgfxUtils::createTexture(BgfxUtils::decodeImage(data, size), BGFX_TEXTURE_NONE | BGFX_SAMPLER_NONE);
     }
 }
@@ -6,6 +6,15 @@
 namespace Tina {
     using TextureHandle = bgfx::TextureHandle;
 
+    // 纹理中的一块矩形区域，例如图集中的一个子图；独立的纹理为整张 0 ~ 1
+    struct TextureRegion {
+        TextureHandle texture = BGFX_INVALID_HANDLE;
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 1.0f;
+        float v1 = 1.0f;
+    };
+
     class Texture {
     public:
         Texture();
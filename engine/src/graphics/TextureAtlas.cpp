@@ -0,0 +1,127 @@
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fmt/format.h>
+
+namespace Tina {
+    namespace {
+        constexpr uint32_t BYTES_PER_PIXEL = 4;
+
+        // 生成四周各扩出 padding 像素的副本，扩出的部分重复最近的边缘像素
+        const bgfx::Memory *createPadded(const uint8_t *pixels, uint16_t width, uint16_t height, uint16_t padding) {
+            const uint32_t paddedWidth = width + padding * 2u;
+            const uint32_t paddedHeight = height + padding * 2u;
+            const bgfx::Memory *mem = bgfx::alloc(paddedWidth * paddedHeight * BYTES_PER_PIXEL);
+
+            for (uint32_t y = 0; y < paddedHeight; ++y) {
+                const uint32_t sourceY = static_cast<uint32_t>(std::clamp<int>(int(y) - padding, 0, height - 1));
+                const uint8_t *source = pixels + sourceY * width * BYTES_PER_PIXEL;
+                uint8_t *row = mem->data + y * paddedWidth * BYTES_PER_PIXEL;
+
+                for (uint32_t x = 0; x < padding; ++x) {
+                    memcpy(row + x * BYTES_PER_PIXEL, source, BYTES_PER_PIXEL);
+                    memcpy(row + (padding + width + x) * BYTES_PER_PIXEL, source + (width - 1) * BYTES_PER_PIXEL,
+                           BYTES_PER_PIXEL);
+                }
+                memcpy(row + padding * BYTES_PER_PIXEL, source, width * BYTES_PER_PIXEL);
+            }
+            return mem;
+        }
+    }
+
+    TextureAtlas::TextureAtlas(const uint16_t pageSize, const uint16_t maxEntrySize, const uint16_t padding)
+        : m_pageSize(pageSize), m_maxEntrySize(std::min(maxEntrySize, pageSize)), m_padding(padding) {
+    }
+
+    TextureAtlas::~TextureAtlas() {
+        clear();
+    }
+
+    bool TextureAtlas::accepts(const uint16_t width, const uint16_t height) const {
+        return width > 0 && height > 0 && width <= m_maxEntrySize && height <= m_maxEntrySize &&
+               width + m_padding * 2 <= m_pageSize && height + m_padding * 2 <= m_pageSize;
+    }
+
+    bool TextureAtlas::add(const uint16_t width, const uint16_t height, const void *rgba8, TextureRegion &region) {
+        if (!accepts(width, height)) {
+            return false;
+        }
+
+        const auto paddedWidth = static_cast<uint16_t>(width + m_padding * 2);
+        const auto paddedHeight = static_cast<uint16_t>(height + m_padding * 2);
+        SkylinePacker::Rect rect{};
+        auto page = std::find_if(m_pages.begin(), m_pages.end(), [&](Page &candidate) {
+            return candidate.packer.insert(paddedWidth, paddedHeight, rect);
+        });
+        if (page == m_pages.end()) {
+            if (!addPage() || !m_pages.back().packer.insert(paddedWidth, paddedHeight, rect)) {
+                return false;
+            }
+            page = m_pages.end() - 1;
+        }
+
+        bgfx::updateTexture2D(page->texture, 0, 0, rect.x, rect.y, paddedWidth, paddedHeight,
+                              createPadded(static_cast<const uint8_t *>(rgba8), width, height, m_padding));
+
+        const float scale = 1.0f / static_cast<float>(m_pageSize);
+        region.texture = page->texture;
+        region.u0 = static_cast<float>(rect.x + m_padding) * scale;
+        region.v0 = static_cast<float>(rect.y + m_padding) * scale;
+        region.u1 = static_cast<float>(rect.x + m_padding + width) * scale;
+        region.v1 = static_cast<float>(rect.y + m_padding + height) * scale;
+        return true;
+    }
+
+    void TextureAtlas::remove(const TextureRegion &region) {
+        m_pendingRemovals.push_back(region);
+    }
+
+    void TextureAtlas::endFrame() {
+        for (const auto &region: m_pendingRemovals) {
+            release(region);
+        }
+        m_pendingRemovals.clear();
+    }
+
+    void TextureAtlas::release(const TextureRegion &region) {
+        const auto page = std::find_if(m_pages.begin(), m_pages.end(), [&](const Page &candidate) {
+            return candidate.texture.idx == region.texture.idx;
+        });
+        if (page == m_pages.end()) {
+            return;
+        }
+
+        // 由纹理坐标还原 add 时分配的矩形（含 padding）
+        const auto toPixel = [this](float coord) {
+            return static_cast<int>(std::lround(coord * static_cast<float>(m_pageSize)));
+        };
+        const int x = toPixel(region.u0);
+        const int y = toPixel(region.v0);
+        page->packer.remove({static_cast<uint16_t>(x - m_padding), static_cast<uint16_t>(y - m_padding),
+                             static_cast<uint16_t>(toPixel(region.u1) - x + m_padding * 2),
+                             static_cast<uint16_t>(toPixel(region.v1) - y + m_padding * 2)});
+    }
+
+    void TextureAtlas::clear() {
+        for (const auto &page: m_pages) {
+            bgfx::destroy(page.texture);
+        }
+        m_pages.clear();
+        m_pendingRemovals.clear();
+    }
+
+    bool TextureAtlas::addPage() {
+        // 不带初始数据创建的纹理才允许 updateTexture2D
+        const TextureHandle texture = bgfx::createTexture2D(m_pageSize, m_pageSize, false, 1,
+                                                            bgfx::TextureFormat::RGBA8, BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
+        if (!bgfx::isValid(texture)) {
+            fmt::print("Failed to create texture atlas page {}x{}\n", m_pageSize, m_pageSize);
+            return false;
+        }
+        bgfx::setName(texture, "TextureAtlas");
+        m_pages.push_back({texture, SkylinePacker(m_pageSize, m_pageSize)});
+        return true;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef TINA_GRAPHICS_TEXTURE_ATLAS_HPP
+#define TINA_GRAPHICS_TEXTURE_ATLAS_HPP
+
+#include <cstdint>
+#include <vector>
+#include "SkylinePacker.hpp"
+#include "Texture.hpp"
+#include "base/NonCopyable.hpp"
+
+namespace Tina {
+    /**
+     * 运行时纹理图集：把小纹理的像素复制到若干张大的 RGBA8 页纹理中，页满时新建一页。
+     * 同一页中的精灵共用一张纹理，Renderer2D 可以把它们合并到同一次绘制。
+     * 每个子图四周留出 padding 像素并复制边缘像素填充，避免线性过滤时采样到相邻子图。
+     * remove 释放的区域在 endFrame() 之后才能被新加入的子图复用，页本身直到 clear() 才销毁。只能在渲染线程使用。
+     */
+    class TextureAtlas : public NonCopyable {
+    public:
+        static constexpr uint16_t DEFAULT_PAGE_SIZE = 2048;
+        static constexpr uint16_t DEFAULT_MAX_ENTRY_SIZE = 256;
+
+        explicit TextureAtlas(uint16_t pageSize = DEFAULT_PAGE_SIZE, uint16_t maxEntrySize = DEFAULT_MAX_ENTRY_SIZE,
+                              uint16_t padding = 1);
+        ~TextureAtlas();
+
+        // 尺寸是否适合放入图集
+        [[nodiscard]] bool accepts(uint16_t width, uint16_t height) const;
+
+        // 复制紧密排列的 RGBA8 像素并上传，region 返回所在的页纹理和纹理坐标。
+        // 尺寸不适合或页纹理创建失败时返回 false
+        bool add(uint16_t width, uint16_t height, const void *rgba8, TextureRegion &region);
+
+        // 释放 add 返回的区域，调用后不能再用它绘制。本帧已提交的绘制可能仍在采样这块区域，
+        // 因此它先进入待释放列表，到 endFrame() 时才交还给页，期间不会被覆盖
+        void remove(const TextureRegion &region);
+
+        // 在 bgfx::frame() 之后调用：之前各帧的绘制都已提交，待释放的区域可以复用
+        void endFrame();
+
+        // 销毁所有页，之前返回的区域全部失效
+        void clear();
+
+        [[nodiscard]] size_t getPageCount() const { return m_pages.size(); }
+        [[nodiscard]] uint16_t getPageSize() const { return m_pageSize; }
+
+    private:
+        struct Page {
+            TextureHandle texture;
+            SkylinePacker packer;
+        };
+
+        bool addPage();
+        void release(const TextureRegion &region);
+
+        uint16_t m_pageSize;
+        uint16_t m_maxEntrySize;
+        uint16_t m_padding;
+        std::vector<Page> m_pages;
+        std::vector<TextureRegion> m_pendingRemovals;
+    };
+}
+
+#endif //TINA_GRAPHICS_TEXTURE_ATLAS_HPP
@@ -54,12 +54,12 @@ void GuiSystem::Update(entt::registry& registry, float deltaTime) {
         float nw = (w / m_width) * 2.0f;
         float nh = (h / m_height) * 2.0f;
         
-        // 添加矩形顶点
+        // 添加矩形顶点，颜色与引擎中的纹理一样使用预乘 alpha
         uint32_t color = 
             ((uint32_t)(gui.color.a * 255.0f) << 24) |
-            ((uint32_t)(gui.color.b * 255.0f) << 16) |
-            ((uint32_t)(gui.color.g * 255.0f) << 8) |
-            ((uint32_t)(gui.color.r * 255.0f));
+            ((uint32_t)(gui.color.b * gui.color.a * 255.0f) << 16) |
+            ((uint32_t)(gui.color.g * gui.color.a * 255.0f) << 8) |
+            ((uint32_t)(gui.color.r * gui.color.a * 255.0f));
             
         uint16_t startIdx = static_cast<uint16_t>(m_vertices.size());
         
@@ -91,7 +91,7 @@ void GuiSystem::Render(entt::registry& registry) {
     // 设置渲染状态
     bgfx::setState(BGFX_STATE_WRITE_RGB 
                 | BGFX_STATE_WRITE_A 
-                | BGFX_STATE_BLEND_ALPHA
+                | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_INV_SRC_ALPHA)  // 预乘 alpha
                 | BGFX_STATE_DEPTH_TEST_LESS  // 添加深度测试
                 | BGFX_STATE_MSAA);           // 添加多重采样
                 
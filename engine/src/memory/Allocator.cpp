@@ -4,5 +4,43 @@
 
 #include "Allocator.hpp"
 
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
 namespace Tina {
-} // Tina
\ No newline at end of file
+    // 在用户指针前面保存 malloc 返回的原始指针，deallocate 时据此释放
+    void* MallocAllocator::allocate(size_t arg_size, size_t arg_alignment)
+    {
+        if (arg_alignment < alignof(void*))
+        {
+            arg_alignment = alignof(void*);
+        }
+
+        // 额外空间加上 arg_size 溢出时返回 nullptr，而不是申请一块过小的内存
+        constexpr size_t maxSize = std::numeric_limits<size_t>::max();
+        if (arg_alignment > maxSize - sizeof(void*) || arg_size > maxSize - sizeof(void*) - arg_alignment)
+        {
+            return nullptr;
+        }
+
+        void* raw = std::malloc(arg_size + arg_alignment + sizeof(void*));
+        if (raw == nullptr)
+        {
+            return nullptr;
+        }
+
+        const auto start = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+        const uintptr_t aligned = (start + arg_alignment - 1) & ~static_cast<uintptr_t>(arg_alignment - 1);
+        reinterpret_cast<void**>(aligned)[-1] = raw;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void MallocAllocator::deallocate(void* arg_ptr)
+    {
+        if (arg_ptr != nullptr)
+        {
+            std::free(static_cast<void**>(arg_ptr)[-1]);
+        }
+    }
+} // Tina
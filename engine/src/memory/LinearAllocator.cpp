@@ -0,0 +1,102 @@
+#include "LinearAllocator.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <new>
+#include "TrackMemory.hpp"
+
+namespace Tina
+{
+    LinearAllocator::LinearAllocator(size_t capacity, const SourceLocation& location)
+        : m_buffer(nullptr), m_capacity(capacity), m_offset(0), m_peak(0)
+#ifdef DEBUG
+        , m_poisonEnabled(true)
+#else
+        , m_poisonEnabled(false)
+#endif
+    {
+        if (m_capacity > 0)
+        {
+            m_buffer = static_cast<uint8_t*>(::operator new(m_capacity, std::align_val_t(DEFAULT_ALIGNMENT)));
+            TINA_TRACK_ALLOC(MemoryTag::Frame, m_capacity, location);
+        }
+        (void)location;
+    }
+
+    LinearAllocator::~LinearAllocator()
+    {
+        if (m_buffer)
+        {
+            ::operator delete(m_buffer, std::align_val_t(DEFAULT_ALIGNMENT));
+            TINA_TRACK_FREE(MemoryTag::Frame, m_capacity);
+            m_buffer = nullptr;
+        }
+    }
+
+    void* LinearAllocator::allocate(size_t arg_size, size_t arg_alignment)
+    {
+        if (arg_alignment == 0)
+        {
+            arg_alignment = DEFAULT_ALIGNMENT;
+        }
+        assert((arg_alignment & (arg_alignment - 1)) == 0 && "Alignment must be a power of two");
+
+        // 对齐的是真实地址而不是偏移量，这样超过缓冲区自身对齐的请求也能满足
+        if (m_buffer == nullptr)
+        {
+            return nullptr;
+        }
+        const auto base = reinterpret_cast<uintptr_t>(m_buffer);
+        const uintptr_t current = base + m_offset;
+        const size_t padding = (arg_alignment - (current & (arg_alignment - 1))) & (arg_alignment - 1);
+
+        // 先比较剩余空间再相加，过大的 arg_size 或 arg_alignment 不会回绕成较小的偏移量
+        if (padding > m_capacity - m_offset || arg_size > m_capacity - m_offset - padding)
+        {
+            return nullptr;
+        }
+
+        const uintptr_t aligned = current + padding;
+        m_offset += padding + arg_size;
+        if (m_offset > m_peak)
+        {
+            m_peak = m_offset;
+        }
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void LinearAllocator::deallocate(void* arg_ptr)
+    {
+        // 单个分配不回收，统一由 reset()/rollback() 处理
+        (void)arg_ptr;
+    }
+
+    void LinearAllocator::rollback(Marker marker)
+    {
+        assert(marker <= m_offset && "Rolling back to a marker past the current offset");
+        if (marker < m_offset)
+        {
+            poison(marker, m_offset);
+            m_offset = marker;
+        }
+    }
+
+    void LinearAllocator::reset()
+    {
+        rollback(0);
+    }
+
+    bool LinearAllocator::owns(const void* ptr) const
+    {
+        const auto* p = static_cast<const uint8_t*>(ptr);
+        return m_buffer != nullptr && p >= m_buffer && p < m_buffer + m_capacity;
+    }
+
+    void LinearAllocator::poison(size_t from, size_t to)
+    {
+        if (m_poisonEnabled && m_buffer && from < to)
+        {
+            std::memset(m_buffer + from, POISON_BYTE, to - from);
+        }
+    }
+} // Tina
@@ -0,0 +1,106 @@
+#ifndef TINA_MEMORY_LINEARALLOCATOR_HPP
+#define TINA_MEMORY_LINEARALLOCATOR_HPP
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "Allocator.hpp"
+#include "base/SourceLocation.hpp"
+#include "base/NonCopyable.hpp"
+
+namespace Tina
+{
+    /**
+     * 线性（bump-pointer）分配器，适合作为每帧的临时内存区。
+     * 分配只是移动偏移量，deallocate 为空操作，内存通过 reset() 整体回收，
+     * 或者通过 getMarker()/rollback()（以及 ScopedMarker）回滚到某个位置。
+     *
+     * 调试构建下被回收的区域会填充 POISON_BYTE，方便发现悬空引用。
+     * 分配器不调用析构函数，create<T>() 只接受可平凡析构的类型。
+     */
+    class LinearAllocator : public Allocator, public NonCopyable
+    {
+    public:
+        using Marker = size_t;
+
+        static constexpr uint8_t POISON_BYTE = 0xDD;
+        static constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+        // 缓冲区的内存统计（TrackMemory）记到 location，默认为创建分配器的位置
+        explicit LinearAllocator(size_t capacity, const SourceLocation& location = SourceLocation::current());
+        ~LinearAllocator();
+
+        // 空间不足时返回 nullptr
+        void* allocate(size_t arg_size, size_t arg_alignment) override;
+        void deallocate(void* arg_ptr) override;
+
+        template <typename T, typename... Args>
+        T* create(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>,
+                          "LinearAllocator never runs destructors.");
+            void* memory = allocate(sizeof(T), alignof(T));
+            return memory ? ::new(memory) T(std::forward<Args>(args)...) : nullptr;
+        }
+
+        template <typename T>
+        T* allocateArray(size_t count)
+        {
+            static_assert(std::is_trivially_destructible_v<T>,
+                          "LinearAllocator never runs destructors.");
+            if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+            {
+                return nullptr;
+            }
+            return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        [[nodiscard]] Marker getMarker() const { return m_offset; }
+
+        // 回滚到之前记录的位置，之后分配的内存全部失效
+        void rollback(Marker marker);
+
+        // 回收全部内存，一般在每帧开始时调用
+        void reset();
+
+        [[nodiscard]] size_t getCapacity() const { return m_capacity; }
+        [[nodiscard]] size_t getUsed() const { return m_offset; }
+        [[nodiscard]] size_t getRemaining() const { return m_capacity - m_offset; }
+        [[nodiscard]] size_t getPeak() const { return m_peak; }
+        [[nodiscard]] bool owns(const void* ptr) const;
+
+        void setPoisonEnabled(bool enabled) { m_poisonEnabled = enabled; }
+        [[nodiscard]] bool isPoisonEnabled() const { return m_poisonEnabled; }
+
+        // 作用域结束时自动回滚到构造时的位置
+        class ScopedMarker : public NonCopyable
+        {
+        public:
+            explicit ScopedMarker(LinearAllocator& allocator)
+                : m_allocator(allocator), m_marker(allocator.getMarker())
+            {
+            }
+
+            ~ScopedMarker()
+            {
+                m_allocator.rollback(m_marker);
+            }
+
+        private:
+            LinearAllocator& m_allocator;
+            Marker m_marker;
+        };
+
+    private:
+        void poison(size_t from, size_t to);
+
+        uint8_t* m_buffer;
+        size_t m_capacity;
+        size_t m_offset;
+        size_t m_peak;
+        bool m_poisonEnabled;
+    };
+} // Tina
+
+#endif //TINA_MEMORY_LINEARALLOCATOR_HPP
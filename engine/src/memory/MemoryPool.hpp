@@ -1,17 +1,346 @@
 //
 // Created by wuxianggujun on 2024/8/7.
 // https://github.com/cacay/MemoryPool
-// 
+//
 
 #ifndef TINA_MEMORY_MEMORYPOOL_HPP
 #define TINA_MEMORY_MEMORYPOOL_HPP
 
-namespace Tina {
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "TrackMemory.hpp"
+
+namespace Tina
+{
+    /**
+     * 固定大小槽位的内存池。
+     * 空闲槽位以侵入式单链表串联，allocate/deallocate 均为 O(1)。
+     * 内存以 BlockSize 字节的块为单位增长，块在池析构前不会被移动或释放，
+     * 因此已分配对象的地址在整个生命周期内保持稳定。
+     *
+     * 块的内存统计（TrackMemory）记到创建池的位置。
+     *
+     * MemoryPool 本身不是线程安全的，也不作为 STL 容器的分配器使用（容器会拷贝/重绑定分配器，
+     * 有状态的池无法满足这些要求），容器请使用下方的 PoolAllocator。
+     */
+    template <typename T, size_t BlockSize = 4096>
+    class MemoryPool
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using reference = T&;
+        using const_pointer = const T*;
+        using const_reference = const T&;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        MemoryPool(const SourceLocation& location = SourceLocation::current()) noexcept
+            : m_location(location)
+        {
+        }
+
+        MemoryPool(const MemoryPool&) = delete;
+
+        MemoryPool(MemoryPool&& other) noexcept
+            : m_location(other.m_location)
+        {
+            moveFrom(other);
+        }
+
+        ~MemoryPool() noexcept
+        {
+            releaseBlocks();
+        }
+
+        MemoryPool& operator=(const MemoryPool&) = delete;
+
+        MemoryPool& operator=(MemoryPool&& other) noexcept
+        {
+            if (this != &other)
+            {
+                releaseBlocks();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        pointer address(reference x) const noexcept
+        {
+            return &x;
+        }
+
+        const_pointer address(const_reference x) const noexcept
+        {
+            return &x;
+        }
+
+        // 分配一个槽位：优先复用空闲链表，其次从当前块中切分，块用尽时申请新块
+        pointer allocate(size_type n = 1, const_pointer hint = nullptr)
+        {
+            (void)hint;
+            if (n != 1)
+            {
+                return allocateFallback(n);
+            }
+
+            if (m_freeSlots != nullptr)
+            {
+                Slot* slot = m_freeSlots;
+                m_freeSlots = slot->next;
+                ++m_allocatedCount;
+                return reinterpret_cast<pointer>(slot);
+            }
+
+            if (m_currentSlot >= m_lastSlot)
+            {
+                allocateBlock();
+            }
+            ++m_allocatedCount;
+            return reinterpret_cast<pointer>(m_currentSlot++);
+        }
+
+        // 归还槽位：直接压入空闲链表头部
+        void deallocate(pointer p, size_type n = 1)
+        {
+            if (p == nullptr)
+            {
+                return;
+            }
+            if (n != 1)
+            {
+                deallocateFallback(p, n);
+                return;
+            }
+
+            Slot* slot = reinterpret_cast<Slot*>(p);
+            slot->next = m_freeSlots;
+            m_freeSlots = slot;
+            --m_allocatedCount;
+        }
+
+        [[nodiscard]] size_type max_size() const noexcept
+        {
+            const size_type maxBlocks = std::numeric_limits<size_type>::max() / BlockSize;
+            return (BlockSize - HEADER_SIZE) / sizeof(Slot) * maxBlocks;
+        }
+
+        template <class U, class... Args>
+        void construct(U* p, Args&&... args)
+        {
+            ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        }
+
+        template <class U>
+        void destroy(U* p)
+        {
+            p->~U();
+        }
+
+        template <class... Args>
+        pointer newElement(Args&&... args)
+        {
+            pointer result = allocate();
+            try
+            {
+                construct<value_type>(result, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                deallocate(result);
+                throw;
+            }
+            return result;
+        }
+
+        void deleteElement(pointer p)
+        {
+            if (p != nullptr)
+            {
+                p->~value_type();
+                deallocate(p);
+            }
+        }
+
+        // 当前由池分配且尚未归还的槽位数量
+        [[nodiscard]] size_type allocatedCount() const noexcept
+        {
+            return m_allocatedCount;
+        }
+
+        // 已向系统申请的块数量
+        [[nodiscard]] size_type blockCount() const noexcept
+        {
+            return m_blockCount;
+        }
+
+        // 每个块可容纳的槽位数量
+        static constexpr size_type slotsPerBlock() noexcept
+        {
+            return (BlockSize - HEADER_SIZE) / sizeof(Slot);
+        }
+
+    private:
+        union Slot
+        {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        // 块头部只存放指向上一个块的指针，之后按 Slot 的对齐要求排列槽位
+        static constexpr size_t HEADER_SIZE = (sizeof(Slot*) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+        static constexpr size_t BLOCK_ALIGNMENT = alignof(Slot) > alignof(Slot*) ? alignof(Slot) : alignof(Slot*);
+
+        static_assert(BlockSize >= HEADER_SIZE + 2 * sizeof(Slot), "BlockSize too small.");
+
+        Slot* m_currentBlock = nullptr;
+        Slot* m_currentSlot = nullptr;
+        Slot* m_lastSlot = nullptr;
+        Slot* m_freeSlots = nullptr;
+        size_type m_allocatedCount = 0;
+        size_type m_blockCount = 0;
+        SourceLocation m_location;
+
+        void allocateBlock()
+        {
+            auto* newBlock = static_cast<unsigned char*>(
+                ::operator new(BlockSize, std::align_val_t(BLOCK_ALIGNMENT)));
+            *reinterpret_cast<Slot**>(newBlock) = m_currentBlock;
+            m_currentBlock = reinterpret_cast<Slot*>(newBlock);
+
+            m_currentSlot = reinterpret_cast<Slot*>(newBlock + HEADER_SIZE);
+            m_lastSlot = m_currentSlot + slotsPerBlock();
+            ++m_blockCount;
+            TINA_TRACK_ALLOC(MemoryTag::Pool, BlockSize, m_location);
+        }
+
+        void releaseBlocks() noexcept
+        {
+            Slot* block = m_currentBlock;
+            while (block != nullptr)
+            {
+                Slot* previous = *reinterpret_cast<Slot**>(block);
+                ::operator delete(static_cast<void*>(block), std::align_val_t(BLOCK_ALIGNMENT));
+                TINA_TRACK_FREE(MemoryTag::Pool, BlockSize);
+                block = previous;
+            }
+            m_currentBlock = nullptr;
+            m_currentSlot = nullptr;
+            m_lastSlot = nullptr;
+            m_freeSlots = nullptr;
+            m_allocatedCount = 0;
+            m_blockCount = 0;
+        }
+
+        void moveFrom(MemoryPool& other) noexcept
+        {
+            m_currentBlock = std::exchange(other.m_currentBlock, nullptr);
+            m_currentSlot = std::exchange(other.m_currentSlot, nullptr);
+            m_lastSlot = std::exchange(other.m_lastSlot, nullptr);
+            m_freeSlots = std::exchange(other.m_freeSlots, nullptr);
+            m_allocatedCount = std::exchange(other.m_allocatedCount, 0);
+            m_blockCount = std::exchange(other.m_blockCount, 0);
+        }
+
+        static pointer allocateFallback(size_type n)
+        {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<pointer>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        static void deallocateFallback(pointer p, size_type) noexcept
+        {
+            ::operator delete(static_cast<void*>(p), std::align_val_t(alignof(T)));
+        }
+    };
+
+    /**
+     * 基于 MemoryPool 的 STL 分配器。
+     * 分配器本身无状态，同一 (T, BlockSize) 的所有实例共享一个进程级的池，
+     * 因此容器之间的拷贝、移动、splice 都是安全的。共享池由互斥锁保护，可跨线程使用。
+     *
+     * 用法：std::list<Event, PoolAllocator<Event>>、std::map<K, V, std::less<>, PoolAllocator<std::pair<const K, V>>>
+     */
+    template <typename T, size_t BlockSize = 4096>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = PoolAllocator<U, BlockSize>;
+        };
+
+        PoolAllocator() noexcept = default;
+
+        template <class U>
+        PoolAllocator(const PoolAllocator<U, BlockSize>&) noexcept
+        {
+        }
+
+        pointer allocate(size_type n)
+        {
+            SharedPool& shared = getSharedPool();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            return shared.pool.allocate(n);
+        }
+
+        void deallocate(pointer p, size_type n)
+        {
+            SharedPool& shared = getSharedPool();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.pool.deallocate(p, n);
+        }
+
+        // 共享池中尚未归还的槽位数量
+        static size_type allocatedCount()
+        {
+            SharedPool& shared = getSharedPool();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            return shared.pool.allocatedCount();
+        }
+
+        template <class U>
+        bool operator==(const PoolAllocator<U, BlockSize>&) const noexcept
+        {
+            return true;
+        }
 
-class MemoryPool {
+        template <class U>
+        bool operator!=(const PoolAllocator<U, BlockSize>&) const noexcept
+        {
+            return false;
+        }
 
-};
+    private:
+        struct SharedPool
+        {
+            MemoryPool<T, BlockSize> pool;
+            std::mutex mutex;
+        };
 
+        // 共享池刻意不析构，避免静态容器在池销毁后才释放节点
+        static SharedPool& getSharedPool()
+        {
+            static auto* shared = new SharedPool();
+            return *shared;
+        }
+    };
 } // Tina
 
 #endif //TINA_MEMORY_MEMORYPOOL_HPP
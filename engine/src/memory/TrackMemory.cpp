@@ -0,0 +1,398 @@
+#include "TrackMemory.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <fmt/base.h>
+
+namespace Tina
+{
+    namespace
+    {
+        constexpr size_t TAG_COUNT = TrackMemory::TAG_COUNT;
+
+        // 单个线程的计数器，只由拥有它的线程写入
+        struct ThreadRecord
+        {
+            std::array<std::atomic<int64_t>, TAG_COUNT> bytes{};
+            std::array<std::atomic<int64_t>, TAG_COUNT> allocations{};
+            std::array<std::atomic<uint64_t>, TAG_COUNT> totalAllocations{};
+            // 上次汇总以来 bytes 的最大值，分配时更新，汇总时重置为当前值
+            std::array<std::atomic<int64_t>, TAG_COUNT> highWater{};
+            // 上次汇总时的 bytes，只在持有 g_sampleMutex 时读写
+            std::array<int64_t, TAG_COUNT> sampledBytes{};
+            std::atomic<bool> active{false};
+            ThreadRecord* next = nullptr;
+        };
+
+        enum class ThreadState : uint8_t
+        {
+            Uninitialized,
+            Active,
+            Destroyed
+        };
+
+        // 记录只增不删，遍历时无需加锁
+        std::atomic<ThreadRecord*> g_records{nullptr};
+        // 分配点表：以位置为键的开放寻址哈希表，槽位只会从空变为非空，查找和插入都不加锁
+        constexpr size_t CALL_SITE_CAPACITY = 4096;
+        std::array<std::atomic<TrackMemory::CallSite*>, CALL_SITE_CAPACITY> g_callSites{};
+        std::array<std::atomic<int64_t>, TAG_COUNT> g_peakBytes{};
+        std::array<std::atomic<uint64_t>, TAG_COUNT> g_budgets{};
+        // 汇总只在统计和检查预算时发生，用锁串行化即可
+        std::mutex g_sampleMutex;
+        // 上次汇总时各标签的总字节数
+        std::array<int64_t, TAG_COUNT> g_sampledTotal{};
+
+        // 线程局部对象析构之后（例如其他 thread_local 的析构函数中）发生的分配记到这里，由多个线程共享
+        ThreadRecord g_orphanRecord;
+
+        ThreadRecord* acquireRecord()
+        {
+            for (ThreadRecord* record = g_records.load(std::memory_order_acquire); record; record = record->next)
+            {
+                bool expected = false;
+                if (!record->active.load(std::memory_order_relaxed) &&
+                    record->active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    return record;
+                }
+            }
+
+            auto* record = new ThreadRecord();
+            record->active.store(true, std::memory_order_relaxed);
+            record->next = g_records.load(std::memory_order_relaxed);
+            while (!g_records.compare_exchange_weak(record->next, record,
+                                                    std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+            return record;
+        }
+
+        // 状态标志可平凡析构，线程退出的任何阶段都可以安全读取
+        thread_local ThreadState t_state = ThreadState::Uninitialized;
+
+        struct RecordHolder
+        {
+            ThreadRecord* record = nullptr;
+
+            ~RecordHolder()
+            {
+                if (record)
+                {
+                    record->active.store(false, std::memory_order_release);
+                }
+                t_state = ThreadState::Destroyed;
+            }
+        };
+
+        thread_local RecordHolder t_holder;
+
+        ThreadRecord* getThreadRecord()
+        {
+            if (t_state == ThreadState::Active)
+            {
+                return t_holder.record;
+            }
+            if (t_state == ThreadState::Destroyed)
+            {
+                return nullptr;
+            }
+            t_holder.record = acquireRecord();
+            t_state = ThreadState::Active;
+            return t_holder.record;
+        }
+
+        template <typename T>
+        void addLocal(std::atomic<T>& counter, T delta)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+
+        void raise(std::atomic<int64_t>& maximum, int64_t value)
+        {
+            int64_t current = maximum.load(std::memory_order_relaxed);
+            while (value > current &&
+                   !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        // 同一位置在不同编译单元中可能是不同的字符串指针，按内容计算哈希和比较
+        size_t hashLocation(const SourceLocation& location)
+        {
+            size_t hash = 14695981039346656037ull ^ static_cast<size_t>(location.line);
+            for (const char* c = location.file; *c; ++c)
+            {
+                hash = (hash ^ static_cast<unsigned char>(*c)) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        bool isSameLocation(const TrackMemory::CallSite& site, const SourceLocation& location)
+        {
+            return site.line == location.line &&
+                (site.file == location.file || std::strcmp(site.file, location.file) == 0) &&
+                (site.function == location.function || std::strcmp(site.function, location.function) == 0);
+        }
+
+        // 表满时返回 nullptr，这次分配只计入标签统计
+        TrackMemory::CallSite* findCallSite(const SourceLocation& location)
+        {
+            size_t index = hashLocation(location);
+            for (size_t probe = 0; probe < CALL_SITE_CAPACITY; ++probe, ++index)
+            {
+                std::atomic<TrackMemory::CallSite*>& slot = g_callSites[index % CALL_SITE_CAPACITY];
+                TrackMemory::CallSite* site = slot.load(std::memory_order_acquire);
+                if (site == nullptr)
+                {
+                    auto* created = new TrackMemory::CallSite(location.file, location.line, location.function);
+                    if (slot.compare_exchange_strong(site, created, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire))
+                    {
+                        return created;
+                    }
+                    // 其他线程抢先占用了这个槽位，site 为它写入的分配点
+                    delete created;
+                }
+                if (isSameLocation(*site, location))
+                {
+                    return site;
+                }
+            }
+            return nullptr;
+        }
+
+        // rises 累加各线程自上次汇总以来的增长量
+        void accumulate(ThreadRecord& record, std::array<TrackMemory::TagStats, TAG_COUNT>& stats,
+                        std::array<int64_t, TAG_COUNT>& rises)
+        {
+            for (size_t i = 0; i < TAG_COUNT; ++i)
+            {
+                const int64_t bytes = record.bytes[i].load(std::memory_order_relaxed);
+                const int64_t high = std::max(record.highWater[i].exchange(bytes, std::memory_order_relaxed), bytes);
+                rises[i] += std::max<int64_t>(high - record.sampledBytes[i], 0);
+                record.sampledBytes[i] = bytes;
+
+                stats[i].currentBytes += bytes;
+                stats[i].currentAllocations += record.allocations[i].load(std::memory_order_relaxed);
+                stats[i].totalAllocations += record.totalAllocations[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void TrackMemory::recordAlloc(MemoryTag tag, size_t bytes, const SourceLocation& location)
+    {
+        const auto index = static_cast<size_t>(tag);
+        const auto size = static_cast<int64_t>(bytes);
+
+        // 只有超过本线程上次汇总以来的最大值时才需要更新高水位，通常只是一次读取和比较
+        if (ThreadRecord* record = getThreadRecord())
+        {
+            const int64_t current = record->bytes[index].load(std::memory_order_relaxed) + size;
+            record->bytes[index].store(current, std::memory_order_relaxed);
+            addLocal(record->allocations[index], int64_t{1});
+            addLocal(record->totalAllocations[index], uint64_t{1});
+            raise(record->highWater[index], current);
+        }
+        else
+        {
+            const int64_t current = g_orphanRecord.bytes[index].fetch_add(size, std::memory_order_relaxed) + size;
+            g_orphanRecord.allocations[index].fetch_add(1, std::memory_order_relaxed);
+            g_orphanRecord.totalAllocations[index].fetch_add(1, std::memory_order_relaxed);
+            raise(g_orphanRecord.highWater[index], current);
+        }
+
+        if (CallSite* site = findCallSite(location))
+        {
+            site->bytes.fetch_add(bytes, std::memory_order_relaxed);
+            site->count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void TrackMemory::recordFree(MemoryTag tag, size_t bytes)
+    {
+        const auto index = static_cast<size_t>(tag);
+        const auto size = static_cast<int64_t>(bytes);
+
+        // 释放可能发生在另一个线程上，该线程的计数会变为负数，汇总后结果仍然正确
+        if (ThreadRecord* record = getThreadRecord())
+        {
+            addLocal(record->bytes[index], -size);
+            addLocal(record->allocations[index], int64_t{-1});
+        }
+        else
+        {
+            g_orphanRecord.bytes[index].fetch_sub(size, std::memory_order_relaxed);
+            g_orphanRecord.allocations[index].fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::array<TrackMemory::TagStats, TrackMemory::TAG_COUNT> TrackMemory::sample()
+    {
+        std::lock_guard<std::mutex> lock(g_sampleMutex);
+
+        std::array<TagStats, TAG_COUNT> stats{};
+        std::array<int64_t, TAG_COUNT> rises{};
+        for (ThreadRecord* record = g_records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            accumulate(*record, stats, rises);
+        }
+        accumulate(g_orphanRecord, stats, rises);
+
+        for (size_t i = 0; i < TAG_COUNT; ++i)
+        {
+            // 两次汇总之间的峰值不超过上次的总量加上各线程各自的增长量；只有一个线程分配时两者相等
+            raise(g_peakBytes[i], std::max(stats[i].currentBytes, g_sampledTotal[i] + rises[i]));
+            g_sampledTotal[i] = stats[i].currentBytes;
+            stats[i].peakBytes = g_peakBytes[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    TrackMemory::TagStats TrackMemory::getStats(MemoryTag tag)
+    {
+        return sample()[static_cast<size_t>(tag)];
+    }
+
+    void TrackMemory::setBudget(MemoryTag tag, uint64_t bytes)
+    {
+        g_budgets[static_cast<size_t>(tag)].store(bytes, std::memory_order_relaxed);
+    }
+
+    uint64_t TrackMemory::getBudget(MemoryTag tag)
+    {
+        return g_budgets[static_cast<size_t>(tag)].load(std::memory_order_relaxed);
+    }
+
+    std::vector<TrackMemory::BudgetViolation> TrackMemory::checkBudgets()
+    {
+        const auto stats = sample();
+
+        std::vector<BudgetViolation> violations;
+        for (size_t i = 0; i < TAG_COUNT; ++i)
+        {
+            const uint64_t budget = g_budgets[i].load(std::memory_order_relaxed);
+            if (budget > 0 && stats[i].peakBytes > static_cast<int64_t>(budget))
+            {
+                violations.push_back({static_cast<MemoryTag>(i), budget, stats[i].peakBytes});
+            }
+        }
+        return violations;
+    }
+
+    std::vector<const TrackMemory::CallSite*> TrackMemory::getTopCallSites(size_t count)
+    {
+        std::vector<const CallSite*> sites;
+        for (const auto& slot : g_callSites)
+        {
+            // reset() 之后没有再分配的分配点不列出
+            const CallSite* site = slot.load(std::memory_order_acquire);
+            if (site && site->count.load(std::memory_order_relaxed) > 0)
+            {
+                sites.push_back(site);
+            }
+        }
+
+        const size_t resultCount = std::min(count, sites.size());
+        std::partial_sort(sites.begin(), sites.begin() + static_cast<ptrdiff_t>(resultCount), sites.end(),
+                          [](const CallSite* a, const CallSite* b)
+                          {
+                              return a->bytes.load(std::memory_order_relaxed) >
+                                  b->bytes.load(std::memory_order_relaxed);
+                          });
+        sites.resize(resultCount);
+        return sites;
+    }
+
+    void TrackMemory::dumpTopCallSites(size_t count)
+    {
+        fmt::print("Top {} allocation call sites:\n", count);
+        for (const CallSite* site : getTopCallSites(count))
+        {
+            fmt::print("  {} bytes in {} allocations at {}:{} ({})\n",
+                       site->bytes.load(std::memory_order_relaxed),
+                       site->count.load(std::memory_order_relaxed),
+                       site->file, site->line, site->function);
+        }
+    }
+
+    void TrackMemory::dumpStats()
+    {
+        const auto stats = sample();
+
+        fmt::print("Memory Tracking Statistics:\n");
+        for (size_t i = 0; i < TAG_COUNT; ++i)
+        {
+            const uint64_t budget = g_budgets[i].load(std::memory_order_relaxed);
+            fmt::print("  {:<10} current: {} bytes ({} allocations), peak: {} bytes, total allocations: {}",
+                       getTagName(static_cast<MemoryTag>(i)), stats[i].currentBytes,
+                       stats[i].currentAllocations, stats[i].peakBytes, stats[i].totalAllocations);
+            if (budget > 0)
+            {
+                fmt::print(", budget: {} bytes", budget);
+            }
+            fmt::print("\n");
+        }
+    }
+
+    void TrackMemory::reset()
+    {
+        std::lock_guard<std::mutex> lock(g_sampleMutex);
+
+        auto clear = [](ThreadRecord& record)
+        {
+            for (size_t i = 0; i < TAG_COUNT; ++i)
+            {
+                record.bytes[i].store(0, std::memory_order_relaxed);
+                record.allocations[i].store(0, std::memory_order_relaxed);
+                record.totalAllocations[i].store(0, std::memory_order_relaxed);
+                record.highWater[i].store(0, std::memory_order_relaxed);
+                record.sampledBytes[i] = 0;
+            }
+        };
+
+        for (ThreadRecord* record = g_records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            clear(*record);
+        }
+        clear(g_orphanRecord);
+
+        for (const auto& slot : g_callSites)
+        {
+            if (CallSite* site = slot.load(std::memory_order_acquire))
+            {
+                site->bytes.store(0, std::memory_order_relaxed);
+                site->count.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        for (size_t i = 0; i < TAG_COUNT; ++i)
+        {
+            g_peakBytes[i].store(0, std::memory_order_relaxed);
+            g_budgets[i].store(0, std::memory_order_relaxed);
+            g_sampledTotal[i] = 0;
+        }
+    }
+
+    const char* TrackMemory::getTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::General:
+            return "General";
+        case MemoryTag::String:
+            return "String";
+        case MemoryTag::Pool:
+            return "Pool";
+        case MemoryTag::Frame:
+            return "Frame";
+        case MemoryTag::Resource:
+            return "Resource";
+        case MemoryTag::Renderer:
+            return "Renderer";
+        default:
+            return "Unknown";
+        }
+    }
+} // Tina
@@ -6,22 +6,109 @@
 #ifndef TRACKMEMORY_HPP
 #define TRACKMEMORY_HPP
 
-#include <cassert>
-#include <cstdio>
-#include <cstdlib>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "base/SourceLocation.hpp"
 
-// #ifdef TRACK_MEMORY
-#include <map>
+namespace Tina
+{
+    // 内存统计按子系统划分，新增标签时同步修改 TrackMemory::getTagName()
+    enum class MemoryTag : uint8_t
+    {
+        General,
+        String,
+        Pool,
+        Frame,
+        Resource,
+        Renderer,
+        Count
+    };
 
+    /**
+     * 内存分配跟踪。
+     * 每个线程写自己的一组计数器（单写者，relaxed 原子读写即可），读取统计时再把所有线程的计数器汇总，
+     * 因此开启跟踪后分配路径上没有全局锁，也没有跨线程竞争的原子操作（高水位只会与汇总线程竞争）。
+     * 线程退出后其计数器记录保留在链表中（数值仍计入总量），并由之后新建的线程复用。
+     *
+     * 每个线程在分配时记录自己计数的高水位，汇总（getStats/sample/checkBudgets）时合并为峰值，
+     * 两次汇总之间分配又释放的内存同样计入峰值。多个线程在两次汇总之间都有分配时，合并结果是峰值的上界。
+     * GameApplication 会在每帧调用一次 sample()。
+     *
+     * 引擎代码通过 TINA_TRACK_ALLOC/TINA_TRACK_FREE 接入，只有定义了 TRACK_MEMORY
+     * （CMake 选项 TINA_TRACK_MEMORY）时这两个宏才会展开。
+     */
+    class TrackMemory
+    {
+    public:
+        static constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::Count);
 
+        // 分配点，按 recordAlloc 传入的位置首次出现时创建，之后一直保留
+        struct CallSite
+        {
+            const char* file;
+            int line;
+            const char* function;
+            std::atomic<uint64_t> bytes{0};
+            std::atomic<uint64_t> count{0};
 
+            CallSite(const char* file, int line, const char* function)
+                : file(file), line(line), function(function)
+            {
+            }
+        };
 
-namespace Tina {
+        struct TagStats
+        {
+            int64_t currentBytes = 0;
+            int64_t currentAllocations = 0;
+            uint64_t totalAllocations = 0;
+            int64_t peakBytes = 0;
+        };
 
-class TrackMemory {
+        struct BudgetViolation
+        {
+            MemoryTag tag;
+            uint64_t budgetBytes;
+            int64_t peakBytes;
+        };
 
-};
+        // location 是分配的发起者：分配器的公开接口以默认参数取得调用方的位置并传到这里，
+        // 分配点统计因此指向真正申请内存的引擎代码，而不是分配器内部
+        static void recordAlloc(MemoryTag tag, size_t bytes,
+                                const SourceLocation& location = SourceLocation::current());
+        static void recordFree(MemoryTag tag, size_t bytes);
 
+        // 汇总所有线程的计数器并刷新峰值
+        static TagStats getStats(MemoryTag tag);
+        static std::array<TagStats, TAG_COUNT> sample();
+
+        // 为标签设置预算，0 表示不限制；checkBudgets 返回峰值超出预算的标签
+        static void setBudget(MemoryTag tag, uint64_t bytes);
+        static uint64_t getBudget(MemoryTag tag);
+        static std::vector<BudgetViolation> checkBudgets();
+
+        // 按累计分配字节数排序的分配点
+        static std::vector<const CallSite*> getTopCallSites(size_t count);
+        static void dumpTopCallSites(size_t count = 10);
+        static void dumpStats();
+
+        // 清零所有计数器、峰值和预算，只应在没有其他线程分配时调用（例如测试之间）
+        static void reset();
+
+        static const char* getTagName(MemoryTag tag);
+    };
 } // Tina
 
+// TINA_TRACK_ALLOC(tag, bytes[, location])：省略 location 时记到宏展开的位置
+#ifdef TRACK_MEMORY
+#define TINA_TRACK_ALLOC(tag, ...) ::Tina::TrackMemory::recordAlloc((tag), __VA_ARGS__)
+#define TINA_TRACK_FREE(tag, bytes) ::Tina::TrackMemory::recordFree((tag), (bytes))
+#else
+#define TINA_TRACK_ALLOC(tag, ...) ((void)0)
+#define TINA_TRACK_FREE(tag, bytes) ((void)0)
+#endif
+
 #endif //TRACKMEMORY_HPP
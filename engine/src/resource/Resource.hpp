@@ -5,12 +5,22 @@
 #ifndef TINA_CORE_RESOURCE_HPP
 #define TINA_CORE_RESOURCE_HPP
 
+#include <cstddef>
 #include <string>
+#include <vector>
 #include "ResourceHandle.hpp"
 #include "ResourceType.hpp"
 #include "core/Core.hpp"
 
 namespace Tina {
+    // 资源占用的内存估算，cpuBytes 为内存中的数据（如尚未上传的解码结果），gpuBytes 为显存中的数据
+    struct ResourceMemoryUsage {
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+
+        [[nodiscard]] size_t total() const { return cpuBytes + gpuBytes; }
+    };
+
     class Resource {
     public:
         Resource(const ResourceHandle &handle, const std::string &path, ResourceType type);
@@ -20,6 +30,26 @@ namespace Tina {
         virtual bool load() = 0;
         virtual void unload() = 0;
 
+        // 异步加载分为两个阶段：decode 在工作线程执行（读文件、解码），不能调用 bgfx；
+        // upload 在渲染线程执行（创建 GPU 资源）。默认实现不拆分，全部在 upload 中调用 load()
+        virtual bool decode() { return true; }
+        virtual bool upload() { return load(); }
+        // decode 完成后待上传的字节数，用于限制每帧的上传量
+        [[nodiscard]] virtual size_t getUploadSize() const { return 0; }
+        // 供 ResourceCache 按预算淘汰使用，未实现的资源类型不计入预算
+        [[nodiscard]] virtual ResourceMemoryUsage getMemoryUsage() const { return {}; }
+
+        // 流式加载：资源先以较低精度可用，之后由 ResourceManager::update 每帧在上传预算内调用 stream 逐步提升。
+        // stream 返回本次上传的字节数，预算不足或已达到目标精度时返回 0
+        [[nodiscard]] virtual bool isStreamable() const { return false; }
+        virtual size_t stream(size_t budgetBytes) { (void)budgetBytes; return 0; }
+
+        // 热重载：文件变化后在渲染线程原地重新加载。默认实现先卸载再加载，
+        // 子类应先准备好新数据再替换，失败时保留旧数据
+        virtual bool reload() { unload(); return load(); }
+        // 热重载需要监视的文件
+        [[nodiscard]] virtual std::vector<std::string> getWatchPaths() const { return {m_path}; }
+
         [[nodiscard]] const ResourceHandle &getHandle() const;
         [[nodiscard]] const std::string &getPath() const;
         [[nodiscard]] ResourceType getType() const;
@@ -0,0 +1,180 @@
+#include "ResourceCache.hpp"
+
+namespace Tina {
+    ResourceHandle ResourceCache::allocate(const ResourceType type) {
+        if (type >= ResourceType::Count) {
+            return {};
+        }
+        return {type, m_types[static_cast<size_t>(type)].slots.insert({})};
+    }
+
+    RefPtr<Resource> ResourceCache::find(const ResourceHandle &handle) {
+        Entry *entry = getEntry(handle);
+        if (!entry || !entry->resource) {
+            ++m_stats.misses;
+            return nullptr;
+        }
+
+        ++m_stats.hits;
+        auto &lru = m_types[static_cast<size_t>(handle.getType())].lru;
+        lru.splice(lru.begin(), lru, entry->lruIt);
+        return entry->resource;
+    }
+
+    RefPtr<Resource> ResourceCache::peek(const ResourceHandle &handle) const {
+        const Entry *entry = getEntry(handle);
+        return entry ? entry->resource : nullptr;
+    }
+
+    bool ResourceCache::contains(const ResourceHandle &handle) const {
+        const Entry *entry = getEntry(handle);
+        return entry && entry->resource;
+    }
+
+    bool ResourceCache::insert(const RefPtr<Resource> &resource) {
+        if (!resource) {
+            return false;
+        }
+        const ResourceHandle &handle = resource->getHandle();
+        Entry *entry = getEntry(handle);
+        if (!entry) {
+            return false;
+        }
+
+        TypeState &state = m_types[static_cast<size_t>(handle.getType())];
+        if (entry->resource) {
+            detach(state, *entry);
+        }
+
+        state.lru.push_front(handle);
+        entry->resource = resource;
+        entry->lruIt = state.lru.begin();
+        entry->memory = resource->getMemoryUsage();
+        state.usage += entry->memory.total();
+        m_totalUsage.cpuBytes += entry->memory.cpuBytes;
+        m_totalUsage.gpuBytes += entry->memory.gpuBytes;
+        ++m_size;
+        return true;
+    }
+
+    RefPtr<Resource> ResourceCache::erase(const ResourceHandle &handle) {
+        Entry *entry = getEntry(handle);
+        if (!entry) {
+            return nullptr;
+        }
+
+        TypeState &state = m_types[static_cast<size_t>(handle.getType())];
+        RefPtr<Resource> resource = entry->resource;
+        if (resource) {
+            detach(state, *entry);
+        }
+        state.slots.erase(handle.getSlotKey());
+        return resource;
+    }
+
+    std::vector<RefPtr<Resource>> ResourceCache::clear() {
+        std::vector<RefPtr<Resource>> resources;
+        resources.reserve(m_size);
+        for (auto &state: m_types) {
+            for (Entry &entry: state.slots) {
+                if (entry.resource) {
+                    resources.push_back(std::move(entry.resource));
+                }
+            }
+            state.slots.clear();
+            state.lru.clear();
+            state.usage = 0;
+        }
+        m_size = 0;
+        m_totalUsage = {};
+        return resources;
+    }
+
+    void ResourceCache::updateMemoryUsage(const ResourceHandle &handle) {
+        Entry *entry = getEntry(handle);
+        if (!entry || !entry->resource) {
+            return;
+        }
+
+        TypeState &state = m_types[static_cast<size_t>(handle.getType())];
+        state.usage -= entry->memory.total();
+        m_totalUsage.cpuBytes -= entry->memory.cpuBytes;
+        m_totalUsage.gpuBytes -= entry->memory.gpuBytes;
+
+        entry->memory = entry->resource->getMemoryUsage();
+        state.usage += entry->memory.total();
+        m_totalUsage.cpuBytes += entry->memory.cpuBytes;
+        m_totalUsage.gpuBytes += entry->memory.gpuBytes;
+    }
+
+    void ResourceCache::setBudget(const ResourceType type, const size_t bytes) {
+        if (type < ResourceType::Count) {
+            m_types[static_cast<size_t>(type)].budget = bytes;
+        }
+    }
+
+    size_t ResourceCache::getBudget(const ResourceType type) const {
+        return type < ResourceType::Count ? m_types[static_cast<size_t>(type)].budget : 0;
+    }
+
+    size_t ResourceCache::getMemoryUsage(const ResourceType type) const {
+        return type < ResourceType::Count ? m_types[static_cast<size_t>(type)].usage : 0;
+    }
+
+    ResourceMemoryUsage ResourceCache::getTotalMemoryUsage() const {
+        return m_totalUsage;
+    }
+
+    size_t ResourceCache::trim(std::vector<RefPtr<Resource>> &evicted) {
+        size_t count = 0;
+        for (auto &state: m_types) {
+            if (state.budget == 0) {
+                continue;
+            }
+
+            // 从最久未使用的一端向前扫描，跳过仍被外部引用的资源
+            auto it = state.lru.end();
+            while (state.usage > state.budget && it != state.lru.begin()) {
+                --it;
+                const uint32_t slotKey = it->getSlotKey();
+                Entry *entry = state.slots.get(slotKey);
+                if (entry->resource.use_count() > 1) {
+                    continue;
+                }
+
+                const auto next = std::next(it);
+                ++m_stats.evictions;
+                m_stats.evictedBytes += entry->memory.total();
+                evicted.push_back(entry->resource);
+                detach(state, *entry);
+                state.slots.erase(slotKey);
+                it = next;
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    ResourceCache::Entry *ResourceCache::getEntry(const ResourceHandle &handle) {
+        if (!handle.isValid() || handle.getType() >= ResourceType::Count) {
+            return nullptr;
+        }
+        return m_types[static_cast<size_t>(handle.getType())].slots.get(handle.getSlotKey());
+    }
+
+    const ResourceCache::Entry *ResourceCache::getEntry(const ResourceHandle &handle) const {
+        if (!handle.isValid() || handle.getType() >= ResourceType::Count) {
+            return nullptr;
+        }
+        return m_types[static_cast<size_t>(handle.getType())].slots.get(handle.getSlotKey());
+    }
+
+    void ResourceCache::detach(TypeState &state, Entry &entry) {
+        state.lru.erase(entry.lruIt);
+        state.usage -= entry.memory.total();
+        m_totalUsage.cpuBytes -= entry.memory.cpuBytes;
+        m_totalUsage.gpuBytes -= entry.memory.gpuBytes;
+        entry.resource.reset();
+        --m_size;
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef TINA_CORE_RESOURCE_CACHE_HPP
+#define TINA_CORE_RESOURCE_CACHE_HPP
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <vector>
+#include "Resource.hpp"
+#include "ResourceHandle.hpp"
+#include "ResourceType.hpp"
+#include "base/SlotMap.hpp"
+#include "core/Core.hpp"
+
+namespace Tina {
+    struct ResourceCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t evictedBytes = 0;
+    };
+
+    /**
+     * 已加载资源的缓存，每种资源类型一张槽位表，句柄由这里分配，查找只是数组下标加代数比较。
+     * 按资源类型分别维护 LRU 顺序和内存预算。
+     * 只有缓存自己持有 RefPtr 的资源才可以被淘汰，外部仍在使用的资源即使超出预算也会保留，
+     * 等引用释放后在下一次 trim 时淘汰。预算为 0 表示不限制。
+     */
+    class ResourceCache {
+    public:
+        // 为即将加载的资源预留槽位并返回其句柄，资源加载完成后用 insert 填入；槽位用尽时返回无效句柄
+        ResourceHandle allocate(ResourceType type);
+
+        // 查找资源并计入命中/未命中统计，命中时移到 LRU 队首
+        RefPtr<Resource> find(const ResourceHandle &handle);
+        // 只查找，不影响统计和 LRU 顺序
+        [[nodiscard]] RefPtr<Resource> peek(const ResourceHandle &handle) const;
+        [[nodiscard]] bool contains(const ResourceHandle &handle) const;
+
+        // 把资源放入其句柄预留的槽位，作为最近使用的条目；句柄已失效时返回 false
+        bool insert(const RefPtr<Resource> &resource);
+        // 移除资源（或只是预留的槽位）并返回资源，不检查引用，此后该句柄失效
+        RefPtr<Resource> erase(const ResourceHandle &handle);
+        // 移除所有资源，返回被移除的资源供调用方释放
+        std::vector<RefPtr<Resource>> clear();
+
+        // 资源重新加载或上传后大小发生变化时调用
+        void updateMemoryUsage(const ResourceHandle &handle);
+
+        void setBudget(ResourceType type, size_t bytes);
+        [[nodiscard]] size_t getBudget(ResourceType type) const;
+        [[nodiscard]] size_t getMemoryUsage(ResourceType type) const;
+        [[nodiscard]] ResourceMemoryUsage getTotalMemoryUsage() const;
+
+        // 淘汰超出预算类型中最久未使用且没有外部引用的资源，被淘汰的资源追加到 evicted，返回淘汰数量
+        size_t trim(std::vector<RefPtr<Resource>> &evicted);
+
+        // 按存储顺序遍历某类已加载的资源，fn 的参数为 const RefPtr<Resource>&
+        template<typename Fn>
+        void forEach(ResourceType type, Fn &&fn) const {
+            for (const Entry &entry: m_types[static_cast<size_t>(type)].slots) {
+                if (entry.resource) {
+                    fn(entry.resource);
+                }
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] const ResourceCacheStats &getStats() const { return m_stats; }
+        void resetStats() { m_stats = {}; }
+
+    private:
+        struct Entry {
+            // 只预留了槽位、尚未加载完成时为空
+            RefPtr<Resource> resource;
+            std::list<ResourceHandle>::iterator lruIt;
+            ResourceMemoryUsage memory;
+        };
+
+        struct TypeState {
+            SlotMap<Entry, ResourceHandle::INDEX_BITS, ResourceHandle::GENERATION_BITS> slots;
+            // 队首为最近使用
+            std::list<ResourceHandle> lru;
+            size_t budget = 0;
+            size_t usage = 0;
+        };
+
+        Entry *getEntry(const ResourceHandle &handle);
+        [[nodiscard]] const Entry *getEntry(const ResourceHandle &handle) const;
+        void detach(TypeState &state, Entry &entry);
+
+        std::array<TypeState, static_cast<size_t>(ResourceType::Count)> m_types;
+        size_t m_size = 0;
+        ResourceMemoryUsage m_totalUsage;
+        ResourceCacheStats m_stats;
+    };
+}
+
+#endif
@@ -0,0 +1,34 @@
+#include "ResourceData.hpp"
+
+#include <iostream>
+
+namespace Tina {
+    ScopePtr<ResourceData> ResourceData::open(const std::string &path, const MappedFile::AccessPattern pattern) {
+        ScopePtr<ResourceData> result(new ResourceData());
+
+        const ResourcePack::Entry *entry = nullptr;
+        if (RefPtr<ResourcePack> pack = ResourcePack::findMounted(ResourceId(path), entry)) {
+            if (entry->flags & ResourcePack::Compressed) {
+                if (!pack->read(*entry, result->m_buffer)) {
+                    std::cerr << "Failed to decompress packed resource: " << path << std::endl;
+                    return nullptr;
+                }
+                result->m_data = result->m_buffer.data();
+                result->m_size = result->m_buffer.size();
+            } else {
+                const ByteView view = pack->getData(*entry);
+                result->m_data = view.data();
+                result->m_size = view.size();
+            }
+            result->m_pack = std::move(pack);
+            return result;
+        }
+
+        if (!result->m_file.open(Path(path), pattern)) {
+            return nullptr;
+        }
+        result->m_data = result->m_file.data();
+        result->m_size = result->m_file.size();
+        return result;
+    }
+}
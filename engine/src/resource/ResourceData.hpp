@@ -0,0 +1,41 @@
+#ifndef TINA_CORE_RESOURCE_DATA_HPP
+#define TINA_CORE_RESOURCE_DATA_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ResourcePack.hpp"
+#include "base/NonCopyable.hpp"
+#include "core/Core.hpp"
+#include "filesystem/ByteView.hpp"
+#include "filesystem/MappedFile.hpp"
+
+namespace Tina {
+    /**
+     * 资源文件的只读内容。优先从已挂载的资源包中查找：未压缩的条目直接引用包的映射内存，
+     * 压缩的条目解压到自有缓冲区；包中没有时退回到单独映射磁盘上的文件。
+     */
+    class ResourceData : public NonCopyable {
+    public:
+        // 找不到资源或读取失败时返回 nullptr
+        static ScopePtr<ResourceData> open(const std::string &path,
+                                           MappedFile::AccessPattern pattern = MappedFile::AccessPattern::Sequential);
+
+        [[nodiscard]] const uint8_t *data() const { return m_data; }
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] ByteView view() const { return {m_data, m_size}; }
+        [[nodiscard]] bool isFromPack() const { return m_pack != nullptr; }
+
+    private:
+        ResourceData() = default;
+
+        // 持有资源包，保证引用的映射内存在本对象销毁前有效
+        RefPtr<ResourcePack> m_pack;
+        MappedFile m_file;
+        std::vector<uint8_t> m_buffer;
+        const uint8_t *m_data = nullptr;
+        size_t m_size = 0;
+    };
+}
+
+#endif
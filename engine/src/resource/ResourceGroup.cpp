@@ -0,0 +1,210 @@
+#include "ResourceGroup.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace Tina {
+    namespace {
+        using YamlMap = std::unordered_map<std::string, YamlValuePtr>;
+        using YamlList = std::vector<YamlValuePtr>;
+
+        struct GroupSection {
+            const char *key;
+            ResourceType type;
+        };
+
+        constexpr GroupSection GROUP_SECTIONS[] = {
+            {"textures", ResourceType::Texture},
+            {"shaders", ResourceType::Shader},
+        };
+
+        // unordered_map 的遍历顺序不固定，按键排序保证每次加载的顺序一致
+        std::vector<std::pair<std::string, YamlValuePtr>> sortedEntries(const YamlMap &map) {
+            std::vector<std::pair<std::string, YamlValuePtr>> entries(map.begin(), map.end());
+            std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+                return a.first < b.first;
+            });
+            return entries;
+        }
+
+        // 字符串或字符串序列，其他形式返回 false
+        bool readStrings(const YamlValue &value, std::vector<std::string> &out) {
+            if (const auto *string = std::get_if<std::string>(&value.data)) {
+                out.push_back(*string);
+                return true;
+            }
+            const auto *list = std::get_if<YamlList>(&value.data);
+            if (!list) {
+                return false;
+            }
+            for (const auto &item: *list) {
+                const auto *string = item ? std::get_if<std::string>(&item->data) : nullptr;
+                if (!string) {
+                    return false;
+                }
+                out.push_back(*string);
+            }
+            return true;
+        }
+
+        bool readResources(const YamlValue &value, const ResourceType type, std::vector<ResourceGroupEntry> &out) {
+            std::vector<std::string> paths;
+            if (const auto *map = std::get_if<YamlMap>(&value.data)) {
+                for (const auto &[name, path]: sortedEntries(*map)) {
+                    const auto *string = path ? std::get_if<std::string>(&path->data) : nullptr;
+                    if (!string) {
+                        return false;
+                    }
+                    paths.push_back(*string);
+                }
+            } else if (!readStrings(value, paths)) {
+                return false;
+            }
+
+            for (auto &path: paths) {
+                out.push_back({type, std::move(path)});
+            }
+            return true;
+        }
+    }
+
+    bool ResourceGroupGraph::define(ResourceGroupDesc desc) {
+        Node &node = m_nodes[desc.name];
+        if (node.refCount > 0) {
+            std::cerr << "Cannot redefine resource group while it is loaded: " << desc.name << std::endl;
+            return false;
+        }
+        node.desc = std::move(desc);
+        return true;
+    }
+
+    bool ResourceGroupGraph::contains(const std::string &name) const {
+        return m_nodes.find(name) != m_nodes.end();
+    }
+
+    const ResourceGroupDesc *ResourceGroupGraph::find(const std::string &name) const {
+        const auto it = m_nodes.find(name);
+        return it != m_nodes.end() ? &it->second.desc : nullptr;
+    }
+
+    size_t ResourceGroupGraph::getRefCount(const std::string &name) const {
+        const auto it = m_nodes.find(name);
+        return it != m_nodes.end() ? it->second.refCount : 0;
+    }
+
+    bool ResourceGroupGraph::acquire(const std::string &name, std::vector<const ResourceGroupDesc *> &activated) {
+        // 先检查整个依赖闭包，失败时不修改任何计数
+        std::unordered_map<std::string, bool> visiting;
+        if (!validate(name, visiting)) {
+            return false;
+        }
+        Node &node = m_nodes.at(name);
+        ++node.acquireCount;
+        acquireNode(node, activated);
+        return true;
+    }
+
+    bool ResourceGroupGraph::release(const std::string &name, std::vector<const ResourceGroupDesc *> &deactivated) {
+        const auto it = m_nodes.find(name);
+        if (it == m_nodes.end() || it->second.acquireCount == 0) {
+            return false;
+        }
+        --it->second.acquireCount;
+        releaseNode(it->second, deactivated);
+        return true;
+    }
+
+    void ResourceGroupGraph::releaseAll() {
+        for (auto &[name, node]: m_nodes) {
+            node.refCount = 0;
+            node.acquireCount = 0;
+        }
+    }
+
+    bool ResourceGroupGraph::validate(const std::string &name, std::unordered_map<std::string, bool> &visiting) const {
+        const auto it = m_nodes.find(name);
+        if (it == m_nodes.end()) {
+            std::cerr << "Unknown resource group: " << name << std::endl;
+            return false;
+        }
+        if (const auto state = visiting.find(name); state != visiting.end()) {
+            if (state->second) {
+                std::cerr << "Cyclic resource group dependency: " << name << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        visiting[name] = true;
+        for (const auto &dependency: it->second.desc.dependencies) {
+            if (!validate(dependency, visiting)) {
+                return false;
+            }
+        }
+        visiting[name] = false;
+        return true;
+    }
+
+    void ResourceGroupGraph::acquireNode(Node &node, std::vector<const ResourceGroupDesc *> &activated) {
+        if (node.refCount++ > 0) {
+            return;
+        }
+        for (const auto &dependency: node.desc.dependencies) {
+            acquireNode(m_nodes.at(dependency), activated);
+        }
+        activated.push_back(&node.desc);
+    }
+
+    void ResourceGroupGraph::releaseNode(Node &node, std::vector<const ResourceGroupDesc *> &deactivated) {
+        if (--node.refCount > 0) {
+            return;
+        }
+        deactivated.push_back(&node.desc);
+        const auto &dependencies = node.desc.dependencies;
+        for (auto it = dependencies.rbegin(); it != dependencies.rend(); ++it) {
+            releaseNode(m_nodes.at(*it), deactivated);
+        }
+    }
+
+    std::vector<ResourceGroupDesc> ResourceGroupGraph::parse(const YamlValue &section) {
+        std::vector<ResourceGroupDesc> groups;
+        const auto *map = std::get_if<YamlMap>(&section.data);
+        if (!map) {
+            std::cerr << "Resource groups must be a map of group names" << std::endl;
+            return groups;
+        }
+
+        for (const auto &[name, value]: sortedEntries(*map)) {
+            const auto *fields = value ? std::get_if<YamlMap>(&value->data) : nullptr;
+            if (!fields) {
+                std::cerr << "Resource group " << name << " must be a map" << std::endl;
+                continue;
+            }
+
+            ResourceGroupDesc desc;
+            desc.name = name;
+            for (const auto &[key, field]: sortedEntries(*fields)) {
+                if (!field) {
+                    continue;
+                }
+                if (key == "depends") {
+                    if (!readStrings(*field, desc.dependencies)) {
+                        std::cerr << "Resource group " << name << ": depends must be a name or a list of names" << std::endl;
+                    }
+                    continue;
+                }
+
+                const auto group = std::find_if(std::begin(GROUP_SECTIONS), std::end(GROUP_SECTIONS),
+                                                [&key](const GroupSection &s) { return key == s.key; });
+                if (group == std::end(GROUP_SECTIONS)) {
+                    std::cerr << "Resource group " << name << ": unknown key " << key << std::endl;
+                } else if (!readResources(*field, group->type, desc.resources)) {
+                    std::cerr << "Resource group " << name << ": " << key << " must be a list or a map of paths" << std::endl;
+                }
+            }
+            groups.push_back(std::move(desc));
+        }
+        return groups;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef TINA_CORE_RESOURCE_GROUP_HPP
+#define TINA_CORE_RESOURCE_GROUP_HPP
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ResourceType.hpp"
+#include "core/YamlParser.hpp"
+
+namespace Tina {
+    struct ResourceGroupEntry {
+        ResourceType type;
+        std::string path;
+    };
+
+    // 一组一起加载、一起卸载的资源，例如一个关卡；dependencies 为先于本组加载的其他组
+    struct ResourceGroupDesc {
+        std::string name;
+        std::vector<std::string> dependencies;
+        std::vector<ResourceGroupEntry> resources;
+    };
+
+    /**
+     * 资源组之间的依赖图，按组记录引用计数：加载一个组会引用它和它的所有依赖，
+     * 多个组共享的依赖只在第一次被引用时加载，最后一个引用释放时才卸载。
+     * 只维护计数和顺序，实际的加载由 ResourceManager 完成。
+     *
+     * 配置格式（settings.yaml 的 resources: 节，每个子节是一个组）：
+     *   resources:
+     *     common:
+     *       shaders: [sprite]
+     *     level-1:
+     *       depends: [common]
+     *       textures:
+     *         grassland: "../resources/textures/grassland.png"
+     * 资源列表可以写成序列，也可以写成“名称: 路径”的映射，名称只用于阅读。
+     */
+    class ResourceGroupGraph {
+    public:
+        // 定义或替换一个组；组正在被引用时不能替换，返回 false
+        bool define(ResourceGroupDesc desc);
+        [[nodiscard]] bool contains(const std::string &name) const;
+        [[nodiscard]] const ResourceGroupDesc *find(const std::string &name) const;
+        [[nodiscard]] size_t getRefCount(const std::string &name) const;
+
+        // 引用 name 及其依赖，activated 中按依赖在前的顺序返回本次从未引用变为被引用的组。
+        // 组不存在或存在循环依赖时返回 false，不修改任何计数
+        bool acquire(const std::string &name, std::vector<const ResourceGroupDesc *> &activated);
+        // 释放一次 acquire(name) 的引用，deactivated 中按依赖在后的顺序返回引用计数归零的组。
+        // name 没有被直接 acquire 过时返回 false
+        bool release(const std::string &name, std::vector<const ResourceGroupDesc *> &deactivated);
+        // 清空所有引用计数，组定义保留
+        void releaseAll();
+
+        // 解析配置中的 resources: 节，格式错误的条目会被跳过并输出警告
+        static std::vector<ResourceGroupDesc> parse(const YamlValue &section);
+
+    private:
+        struct Node {
+            ResourceGroupDesc desc;
+            // 直接 acquire 的次数加上处于引用状态的依赖方数量
+            size_t refCount = 0;
+            size_t acquireCount = 0;
+        };
+
+        // 检查依赖是否都已定义且没有环；visiting 中 true 表示正在访问，false 表示已检查过
+        bool validate(const std::string &name, std::unordered_map<std::string, bool> &visiting) const;
+        void acquireNode(Node &node, std::vector<const ResourceGroupDesc *> &activated);
+        void releaseNode(Node &node, std::vector<const ResourceGroupDesc *> &deactivated);
+
+        std::unordered_map<std::string, Node> m_nodes;
+    };
+}
+
+#endif
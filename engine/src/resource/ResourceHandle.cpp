@@ -1,20 +1,40 @@
 #include "ResourceHandle.hpp"
 
 namespace Tina {
+    static_assert(static_cast<uint32_t>(ResourceType::Count) <= (1u << ResourceHandle::TYPE_BITS),
+                  "ResourceType does not fit in ResourceHandle");
+
     ResourceHandle::ResourceHandle():m_id(0) {
         
     }
 
-    ResourceHandle::ResourceHandle(uint64_t id):m_id(id) {
+    ResourceHandle::ResourceHandle(uint32_t id):m_id(id) {
     }
 
-    ResourceHandle::ResourceHandle(const std::string &path): m_id(std::hash<std::string>{}(path)) {
+    ResourceHandle::ResourceHandle(ResourceType type, uint32_t slotKey)
+        : m_id(slotKey ? static_cast<uint32_t>(type) << (INDEX_BITS + GENERATION_BITS) | (slotKey & SLOT_KEY_MASK) : 0) {
     }
 
-    uint64_t ResourceHandle::getId() const {
+    uint32_t ResourceHandle::getId() const {
         return m_id;
     }
 
+    ResourceType ResourceHandle::getType() const {
+        return static_cast<ResourceType>(m_id >> (INDEX_BITS + GENERATION_BITS));
+    }
+
+    uint32_t ResourceHandle::getSlotKey() const {
+        return m_id & SLOT_KEY_MASK;
+    }
+
+    uint32_t ResourceHandle::getIndex() const {
+        return m_id & ((1u << INDEX_BITS) - 1);
+    }
+
+    uint32_t ResourceHandle::getGeneration() const {
+        return getSlotKey() >> INDEX_BITS;
+    }
+
     bool ResourceHandle::isValid() const {
         return m_id != 0;
     }
@@ -22,4 +42,8 @@ namespace Tina {
     bool ResourceHandle::operator==(const ResourceHandle &other) const {
         return m_id == other.m_id;
     }
+
+    bool ResourceHandle::operator!=(const ResourceHandle &other) const {
+        return m_id != other.m_id;
+    }
 }
@@ -1,25 +1,41 @@
 #ifndef TINA_CORE_RESOURCE_HANDLE_HPP
 #define TINA_CORE_RESOURCE_HANDLE_HPP
 
-#include <string>
 #include <cstdint>
+#include <functional>
+#include "ResourceType.hpp"
 
 namespace Tina {
+    /**
+     * 32 位资源句柄：高 4 位为资源类型，其下 12 位为代数，低 16 位为该类型槽位表中的下标。
+     * 句柄由 ResourceCache 分配，资源卸载后代数变化，旧句柄不会再取到其他资源。
+     */
     class ResourceHandle {
     public:
+        static constexpr uint32_t INDEX_BITS = 16;
+        static constexpr uint32_t GENERATION_BITS = 12;
+        static constexpr uint32_t TYPE_BITS = 4;
+        // 类型之下的部分，即槽位表的键
+        static constexpr uint32_t SLOT_KEY_MASK = (1u << (INDEX_BITS + GENERATION_BITS)) - 1;
+
         ResourceHandle();
 
-        explicit ResourceHandle(uint64_t id);
+        explicit ResourceHandle(uint32_t id);
 
-        explicit ResourceHandle(const std::string &path);
-        
-        [[nodiscard]] uint64_t getId() const;
+        ResourceHandle(ResourceType type, uint32_t slotKey);
+
+        [[nodiscard]] uint32_t getId() const;
+        [[nodiscard]] ResourceType getType() const;
+        [[nodiscard]] uint32_t getSlotKey() const;
+        [[nodiscard]] uint32_t getIndex() const;
+        [[nodiscard]] uint32_t getGeneration() const;
         [[nodiscard]] bool isValid() const;
 
         bool operator==(const ResourceHandle &other) const;
+        bool operator!=(const ResourceHandle &other) const;
         
     private:
-        uint64_t m_id;
+        uint32_t m_id;
     };
 }
 
@@ -0,0 +1,126 @@
+#include "ResourceLoader.hpp"
+
+#include <algorithm>
+
+namespace Tina {
+    ResourceLoadRequest::ResourceLoadRequest(RefPtr<Resource> resource, const ResourceLoadState state)
+        : m_resource(std::move(resource)), m_state(state) {
+    }
+
+    ResourceLoadState ResourceLoadRequest::getState() const {
+        return m_state.load(std::memory_order_acquire);
+    }
+
+    bool ResourceLoadRequest::isDone() const {
+        const ResourceLoadState state = getState();
+        return state == ResourceLoadState::Ready || state == ResourceLoadState::Failed;
+    }
+
+    const RefPtr<Resource> &ResourceLoadRequest::getResource() const {
+        return m_resource;
+    }
+
+    void ResourceLoadRequest::wait() const {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stateChanged.wait(lock, [this]() { return isDone(); });
+    }
+
+    void ResourceLoadRequest::waitDecoded() const {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stateChanged.wait(lock, [this]() {
+            return isDone() || getState() == ResourceLoadState::Decoded;
+        });
+    }
+
+    void ResourceLoadRequest::setState(const ResourceLoadState state) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_state.store(state, std::memory_order_release);
+        }
+        m_stateChanged.notify_all();
+    }
+
+    ResourceLoader::ResourceLoader(const size_t threadCount) : m_threadPool(threadCount) {
+    }
+
+    ResourceLoader::~ResourceLoader() {
+        // 成员析构前先让线程池执行完剩余任务，然后让还没上传的请求失败，避免等待方永久阻塞
+        m_threadPool.waitIdle();
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        for (const auto &request: m_uploadQueue) {
+            if (!request->isDone()) {
+                request->setState(ResourceLoadState::Failed);
+            }
+        }
+        m_uploadQueue.clear();
+    }
+
+    void ResourceLoader::submit(const RefPtr<ResourceLoadRequest> &request) {
+        m_threadPool.enqueue([this, request]() {
+            request->setState(ResourceLoadState::Decoding);
+            const bool decoded = request->getResource()->decode();
+
+            // 失败的请求也进入队列，由渲染线程统一处理完成后的登记工作
+            std::lock_guard<std::mutex> lock(m_uploadMutex);
+            m_uploadQueue.push_back(request);
+            request->setState(decoded ? ResourceLoadState::Decoded : ResourceLoadState::Failed);
+        });
+    }
+
+    size_t ResourceLoader::processUploads(const size_t budgetBytes,
+                                          std::vector<RefPtr<ResourceLoadRequest>> &completed) {
+        size_t uploadedBytes = 0;
+        size_t uploadedCount = 0;
+        while (true) {
+            RefPtr<ResourceLoadRequest> request;
+            {
+                std::lock_guard<std::mutex> lock(m_uploadMutex);
+                if (m_uploadQueue.empty()) {
+                    break;
+                }
+                request = m_uploadQueue.front();
+                if (request->getState() == ResourceLoadState::Decoded) {
+                    const size_t size = request->getResource()->getUploadSize();
+                    if (uploadedCount > 0 && uploadedBytes + size > budgetBytes) {
+                        break;
+                    }
+                    uploadedBytes += size;
+                    ++uploadedCount;
+                }
+                m_uploadQueue.pop_front();
+            }
+
+            if (request->getState() == ResourceLoadState::Decoded) {
+                upload(request);
+            }
+            completed.push_back(request);
+        }
+        return uploadedBytes;
+    }
+
+    void ResourceLoader::finish(const RefPtr<ResourceLoadRequest> &request) {
+        request->waitDecoded();
+        {
+            std::lock_guard<std::mutex> lock(m_uploadMutex);
+            const auto it = std::find(m_uploadQueue.begin(), m_uploadQueue.end(), request);
+            if (it == m_uploadQueue.end()) {
+                // 已经被 processUploads 处理过
+                return;
+            }
+            m_uploadQueue.erase(it);
+        }
+        if (request->getState() == ResourceLoadState::Decoded) {
+            upload(request);
+        }
+    }
+
+    size_t ResourceLoader::getPendingUploadCount() const {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        return m_uploadQueue.size();
+    }
+
+    void ResourceLoader::upload(const RefPtr<ResourceLoadRequest> &request) {
+        const bool uploaded = request->getResource()->upload();
+        request->setState(uploaded ? ResourceLoadState::Ready : ResourceLoadState::Failed);
+    }
+} // Tina
@@ -0,0 +1,120 @@
+#ifndef TINA_CORE_RESOURCE_LOADER_HPP
+#define TINA_CORE_RESOURCE_LOADER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "Resource.hpp"
+#include "base/NonCopyable.hpp"
+#include "core/Core.hpp"
+#include "core/ThreadPool.hpp"
+
+namespace Tina {
+    enum class ResourceLoadState {
+        Queued,
+        Decoding,
+        // 已在工作线程解码完成，等待渲染线程上传
+        Decoded,
+        Ready,
+        Failed
+    };
+
+    // 一次异步加载请求，同一资源的重复请求共享同一个对象
+    class ResourceLoadRequest {
+    public:
+        explicit ResourceLoadRequest(RefPtr<Resource> resource, ResourceLoadState state = ResourceLoadState::Queued);
+
+        [[nodiscard]] ResourceLoadState getState() const;
+        [[nodiscard]] bool isDone() const;
+        [[nodiscard]] const RefPtr<Resource> &getResource() const;
+
+        // 阻塞直到加载完成或失败；上传发生在渲染线程，渲染线程自身请使用 ResourceManager::waitForResource
+        void wait() const;
+        // 阻塞直到解码阶段结束（Decoded/Ready/Failed）
+        void waitDecoded() const;
+
+        void setState(ResourceLoadState state);
+
+    private:
+        RefPtr<Resource> m_resource;
+        std::atomic<ResourceLoadState> m_state;
+        mutable std::mutex m_mutex;
+        mutable std::condition_variable m_stateChanged;
+    };
+
+    // loadResourceAsync 返回的句柄，可轮询状态或等待完成
+    template<typename T>
+    class ResourceFuture {
+    public:
+        ResourceFuture() = default;
+
+        explicit ResourceFuture(RefPtr<ResourceLoadRequest> request) : m_request(std::move(request)) {
+        }
+
+        [[nodiscard]] bool isValid() const { return m_request != nullptr; }
+
+        [[nodiscard]] ResourceLoadState getState() const {
+            return m_request ? m_request->getState() : ResourceLoadState::Failed;
+        }
+
+        [[nodiscard]] bool isReady() const { return getState() == ResourceLoadState::Ready; }
+        [[nodiscard]] bool isFailed() const { return getState() == ResourceLoadState::Failed; }
+        [[nodiscard]] bool isDone() const { return isReady() || isFailed(); }
+
+        // 加载完成前返回 nullptr
+        [[nodiscard]] RefPtr<T> get() const {
+            return isReady() ? std::dynamic_pointer_cast<T>(m_request->getResource()) : nullptr;
+        }
+
+        // 不能在渲染线程调用，见 ResourceLoadRequest::wait
+        RefPtr<T> wait() const {
+            if (m_request) {
+                m_request->wait();
+            }
+            return get();
+        }
+
+        [[nodiscard]] ResourceHandle getHandle() const {
+            return m_request && m_request->getResource() ? m_request->getResource()->getHandle() : ResourceHandle();
+        }
+
+        [[nodiscard]] const RefPtr<ResourceLoadRequest> &getRequest() const { return m_request; }
+
+    private:
+        RefPtr<ResourceLoadRequest> m_request;
+    };
+
+    /**
+     * 异步加载流水线：decode 在线程池中执行，解码完成的请求进入上传队列，
+     * 由渲染线程每帧调用 processUploads 按字节预算上传，避免一帧内集中创建大量 GPU 资源造成卡顿。
+     */
+    class ResourceLoader : public NonCopyable {
+    public:
+        explicit ResourceLoader(size_t threadCount = 0);
+        ~ResourceLoader();
+
+        void submit(const RefPtr<ResourceLoadRequest> &request);
+
+        // 渲染线程调用：按提交顺序上传已解码的资源，累计字节数超过预算后停止（每次至少上传一个）。
+        // 完成（成功或失败）的请求追加到 completed 中，返回本次上传的字节数
+        size_t processUploads(size_t budgetBytes, std::vector<RefPtr<ResourceLoadRequest>> &completed);
+
+        // 渲染线程调用：等待指定请求解码完成并立即上传，不受预算限制
+        void finish(const RefPtr<ResourceLoadRequest> &request);
+
+        [[nodiscard]] size_t getPendingUploadCount() const;
+
+    private:
+        static void upload(const RefPtr<ResourceLoadRequest> &request);
+
+        std::deque<RefPtr<ResourceLoadRequest>> m_uploadQueue;
+        mutable std::mutex m_uploadMutex;
+        // 最后声明，析构时最先停止，保证工作线程不再访问上传队列
+        ThreadPool m_threadPool;
+    };
+} // Tina
+
+#endif //TINA_CORE_RESOURCE_LOADER_HPP
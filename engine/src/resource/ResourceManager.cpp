@@ -1,94 +1,523 @@
 #include "ResourceManager.hpp"
 #include "TextureResource.hpp"
 #include "ShaderResource.hpp"
+#include "core/Config.hpp"
+#include "graphics/TextureAtlas.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <spdlog/spdlog.h>
 
 namespace Tina {
     ResourceManager::ResourceManager() {
         // 注册资源类型及其创建函数
         registerResourceType<TextureResource>();
         registerResourceType<ShaderResource>();
+
+        m_cache.setBudget(ResourceType::Texture, DEFAULT_TEXTURE_BUDGET);
+        m_cache.setBudget(ResourceType::Shader, DEFAULT_SHADER_BUDGET);
     }
 
     ResourceManager::~ResourceManager() {
+        // 先停止工作线程，再释放资源
+        m_loader.reset();
+        m_fileWatcher.reset();
         unloadAllResources();
+        for (const auto &pack: m_packs) {
+            ResourcePack::unmount(pack);
+        }
     }
 
     template<typename T, typename... Args>
     RefPtr<T> ResourceManager::loadResource(const std::string &path, Args &&... args) {
-        ResourceHandle handle(path);
-        auto it = m_resources.find(handle);
-        
-        if (it != m_resources.end()) {
-            return getResource<T>(handle);
-        }
+        return loadResource<T>(ResourcePath(path), std::forward<Args>(args)...);
+    }
 
-        auto factoryIt = m_resourceFactories.find(T::staticResourceType);
-        if (factoryIt == m_resourceFactories.end()) {
-            // 处理未知资源类型
+    template<typename T, typename... Args>
+    RefPtr<T> ResourceManager::loadResource(const InternedString &path, Args &&... args) {
+        return loadResource<T>(ResourcePath(path.view()), std::forward<Args>(args)...);
+    }
+
+    template<typename T, typename... Args>
+    RefPtr<T> ResourceManager::loadResource(const ResourcePath &path, Args &&... args) {
+        const ResourceHandle existing = findHandle(path);
+        if (existing.isValid() && existing.getType() != T::staticResourceType) {
+            // 同一路径已作为其他类型的资源加载
             return nullptr;
         }
+        if (const RefPtr<Resource> cached = m_cache.find(existing)) {
+            return std::static_pointer_cast<T>(cached);
+        }
 
-        const RefPtr<Resource> resource = factoryIt->second(handle, path);
-        auto typeResource = std::dynamic_pointer_cast<T>(resource);
+        // 同一资源正在异步加载时不再重复加载，直接在当前线程完成该请求
+        if (const auto pending = m_pendingLoads.find(existing); pending != m_pendingLoads.end()) {
+            return waitForResource(ResourceFuture<T>(pending->second));
+        }
 
-        if (!typeResource|| !typeResource->load()) {
+        const ResourceHandle handle = m_cache.allocate(T::staticResourceType);
+        const RefPtr<Resource> resource = createResource(T::staticResourceType, handle, std::string(path.path));
+        if (!resource || !resource->load()) {
             // 加载失败
+            m_cache.erase(handle);
             return nullptr;
         }
-        m_resources[handle] = resource;
-        return typeResource;
+        registerPath(path, handle);
+        addResource(resource);
+        return std::static_pointer_cast<T>(resource);
     }
 
     template<typename T>
-    RefPtr<T> ResourceManager::getResource(const ResourceHandle &handle) {
-        const auto it = m_resources.find(handle);
-        if (it != m_resources.end()) {
-            return std::dynamic_pointer_cast<T>(it->second);
+    ResourceFuture<T> ResourceManager::loadResourceAsync(const std::string &path) {
+        return loadResourceAsync<T>(ResourcePath(path));
+    }
+
+    template<typename T>
+    ResourceFuture<T> ResourceManager::loadResourceAsync(const InternedString &path) {
+        return loadResourceAsync<T>(ResourcePath(path.view()));
+    }
+
+    template<typename T>
+    ResourceFuture<T> ResourceManager::loadResourceAsync(const ResourcePath &path) {
+        return ResourceFuture<T>(loadAsync(T::staticResourceType, path));
+    }
+
+    template<typename T>
+    RefPtr<T> ResourceManager::waitForResource(const ResourceFuture<T> &future) {
+        const RefPtr<ResourceLoadRequest> &request = future.getRequest();
+        if (request && !request->isDone() && m_loader) {
+            m_loader->finish(request);
+            completeLoad(request);
         }
-        return nullptr;
+        return future.get();
     }
 
-    void ResourceManager::unloadResource(const ResourceHandle &handle) {
-        if (const auto it = m_resources.find(handle); it != m_resources.end()) {
-            // 在这里添加特定资源类型的释放逻辑
-            if (it->second->getType() == ResourceType::Texture) {
-                auto textureResource = std::dynamic_pointer_cast<TextureResource>(it->second);
-                if (textureResource && textureResource->isLoaded()) {
-                    bgfx::destroy(textureResource->getTexture().getHandle());
+    template<typename T>
+    std::vector<RefPtr<T>> ResourceManager::loadResources(const std::vector<std::string> &paths) {
+        std::vector<ResourceFuture<T>> futures;
+        futures.reserve(paths.size());
+        for (const auto &path: paths) {
+            futures.push_back(loadResourceAsync<T>(path));
+        }
+
+        // 等待第一个资源时其余资源仍在后台解码，上传与解码重叠进行
+        std::vector<RefPtr<T>> resources;
+        resources.reserve(paths.size());
+        for (const auto &future: futures) {
+            resources.push_back(waitForResource(future));
+        }
+        return resources;
+    }
+
+    bool ResourceManager::defineResourceGroup(ResourceGroupDesc desc) {
+        return m_groups.define(std::move(desc));
+    }
+
+    size_t ResourceManager::defineResourceGroups(const Config &config) {
+        const YamlValuePtr section = config.getValue("resources");
+        if (!section) {
+            return 0;
+        }
+        size_t count = 0;
+        for (auto &desc: ResourceGroupGraph::parse(*section)) {
+            if (defineResourceGroup(std::move(desc))) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    bool ResourceManager::loadResourceGroup(const std::string &name, const ResourceGroupProgress &progress) {
+        std::vector<const ResourceGroupDesc *> activated;
+        if (!m_groups.acquire(name, activated)) {
+            return false;
+        }
+
+        // 与 loadResources 相同：先提交所有组的资源，等待前面的资源时后面的仍在后台解码
+        std::vector<std::pair<const ResourceGroupDesc *, RefPtr<ResourceLoadRequest>>> requests;
+        for (const auto *group: activated) {
+            for (const auto &entry: group->resources) {
+                requests.emplace_back(group, loadAsync(entry.type, ResourcePath(entry.path)));
+            }
+        }
+
+        const size_t total = requests.size();
+        size_t loaded = 0;
+        bool succeeded = true;
+        if (progress) {
+            progress(loaded, total);
+        }
+        for (const auto &[group, request]: requests) {
+            if (!request->isDone() && m_loader) {
+                m_loader->finish(request);
+                completeLoad(request);
+            }
+
+            const RefPtr<Resource> &resource = request->getResource();
+            if (request->getState() == ResourceLoadState::Ready && resource) {
+                m_groupResources[group->name].push_back(resource);
+                ++m_groupRefs[resource->getHandle()];
+            } else {
+                std::cerr << "Failed to load resource in group " << group->name << ": "
+                        << (resource ? resource->getPath() : std::string()) << std::endl;
+                succeeded = false;
+            }
+
+            if (progress) {
+                progress(++loaded, total);
+            }
+        }
+        return succeeded;
+    }
+
+    bool ResourceManager::unloadResourceGroup(const std::string &name) {
+        std::vector<const ResourceGroupDesc *> deactivated;
+        if (!m_groups.release(name, deactivated)) {
+            return false;
+        }
+
+        for (const auto *group: deactivated) {
+            const auto it = m_groupResources.find(group->name);
+            if (it == m_groupResources.end()) {
+                continue;
+            }
+            for (auto &pinned: it->second) {
+                const ResourceHandle handle = pinned->getHandle();
+                if (const auto ref = m_groupRefs.find(handle); ref != m_groupRefs.end()) {
+                    if (--ref->second > 0) {
+                        continue;
+                    }
+                    m_groupRefs.erase(ref);
                 }
-            } else if (it->second->getType() == ResourceType::Shader) {
-                auto shaderResource = std::dynamic_pointer_cast<ShaderResource>(it->second);
-                if (shaderResource && shaderResource->isLoaded()) {
-                    bgfx::destroy(shaderResource->getShader().getProgram());
+
+                // 只剩这里和缓存持有时立即卸载，否则外部仍在使用，交给缓存淘汰
+                const RefPtr<Resource> resource = std::move(pinned);
+                if (resource.use_count() <= 2) {
+                    unloadResource(handle);
                 }
             }
+            m_groupResources.erase(it);
+        }
+        return true;
+    }
+
+    void ResourceManager::update(const size_t uploadBudgetBytes) {
+        if (m_textureAtlas) {
+            // 上一帧的绘制已经提交，之前释放的区域可以交给新纹理
+            m_textureAtlas->endFrame();
+        }
+
+        size_t uploaded = 0;
+        if (m_loader && !m_pendingLoads.empty()) {
+            uploaded = m_loader->processUploads(uploadBudgetBytes, m_completedLoads);
+            for (const auto &request: m_completedLoads) {
+                completeLoad(request);
+            }
+            m_completedLoads.clear();
+        }
+
+        streamResources(uploadBudgetBytes, uploaded);
+        reloadChangedResources();
+
+        // 外部引用随时可能释放，每帧检查一次预算
+        trim();
+    }
+
+    void ResourceManager::streamResources(const size_t budgetBytes, size_t uploadedBytes) {
+        for (auto it = m_streamingResources.begin(); it != m_streamingResources.end();) {
+            const RefPtr<Resource> resource = m_cache.peek(*it);
+            if (!resource || !resource->isStreamable()) {
+                it = m_streamingResources.erase(it);
+                continue;
+            }
 
-            it->second->unload();
-            m_resources.erase(it);
+            // 与 processUploads 一致：本帧还没有上传过任何数据时不受预算限制，保证大资源也能推进
+            const size_t remaining = uploadedBytes == 0 ? SIZE_MAX
+                                         : (budgetBytes > uploadedBytes ? budgetBytes - uploadedBytes : 0);
+            if (const size_t bytes = resource->stream(remaining); bytes > 0) {
+                uploadedBytes += bytes;
+                m_cache.updateMemoryUsage(*it);
+            }
+            ++it;
         }
     }
 
-    void ResourceManager::unloadAllResources() {
-        for (const auto &pair: m_resources) {
-            // 在这里添加特定资源类型的释放逻辑
-            if (pair.second->getType() == ResourceType::Texture) {
-                auto textureResource = std::dynamic_pointer_cast<TextureResource>(pair.second);
-                if (textureResource && textureResource->isLoaded()) {
-                    bgfx::destroy(textureResource->getTexture().getHandle());
+    void ResourceManager::setHotReloadEnabled(const bool enabled) {
+        if (enabled == isHotReloadEnabled()) {
+            return;
+        }
+
+        m_watchedFiles.clear();
+        if (!enabled) {
+            m_fileWatcher.reset();
+            return;
+        }
+
+        m_fileWatcher = createScopePtr<FileWatcher>();
+        for (size_t type = 0; type < static_cast<size_t>(ResourceType::Count); ++type) {
+            m_cache.forEach(static_cast<ResourceType>(type), [this](const RefPtr<Resource> &resource) {
+                watchResource(*resource);
+            });
+        }
+    }
+
+    bool ResourceManager::mountPack(const std::string &path) {
+        auto pack = createRefPtr<ResourcePack>();
+        if (!pack->open(Path(path))) {
+            return false;
+        }
+        ResourcePack::mount(pack);
+        m_packs.push_back(std::move(pack));
+        return true;
+    }
+
+    void ResourceManager::enableTextureAtlas(const std::string &directory, const uint16_t pageSize,
+                                             const uint16_t maxEntrySize) {
+        if (m_textureAtlas) {
+            // 已在图集中的纹理引用着现有的页，不能替换
+            std::cerr << "Texture atlas is already enabled" << std::endl;
+            return;
+        }
+        m_textureAtlas = createScopePtr<TextureAtlas>(pageSize, maxEntrySize);
+        m_textureAtlasDirectory = ResourcePath::normalize(directory);
+    }
+
+    bool ResourceManager::isTextureAtlasPath(const std::string &path) const {
+        if (m_textureAtlasDirectory.empty()) {
+            return true;
+        }
+        // 按规范化的路径比较，"./"、".." 和反斜杠不影响结果；目录名只匹配完整的一段
+        const std::string normalized = ResourcePath::normalize(path);
+        return normalized.size() > m_textureAtlasDirectory.size() &&
+               normalized.compare(0, m_textureAtlasDirectory.size(), m_textureAtlasDirectory) == 0 &&
+               (m_textureAtlasDirectory.back() == '/' || normalized[m_textureAtlasDirectory.size()] == '/');
+    }
+
+    void ResourceManager::watchResource(const Resource &resource) {
+        for (const auto &path: resource.getWatchPaths()) {
+            if (m_fileWatcher->watch(path)) {
+                m_watchedFiles[path].push_back(resource.getHandle());
+            }
+        }
+    }
+
+    void ResourceManager::unwatchResource(const Resource &resource) {
+        for (const auto &path: resource.getWatchPaths()) {
+            const auto it = m_watchedFiles.find(path);
+            if (it == m_watchedFiles.end()) {
+                continue;
+            }
+            auto &handles = it->second;
+            handles.erase(std::remove(handles.begin(), handles.end(), resource.getHandle()), handles.end());
+            if (handles.empty()) {
+                m_fileWatcher->unwatch(path);
+                m_watchedFiles.erase(it);
+            }
+        }
+    }
+
+    void ResourceManager::reloadChangedResources() {
+        if (!m_fileWatcher) {
+            return;
+        }
+
+        m_fileWatcher->poll(m_changedFiles);
+        for (const auto &path: m_changedFiles) {
+            const auto it = m_watchedFiles.find(path);
+            if (it == m_watchedFiles.end()) {
+                continue;
+            }
+            for (const auto &handle: it->second) {
+                const RefPtr<Resource> resource = m_cache.peek(handle);
+                if (!resource) {
+                    continue;
                 }
-            } else if (pair.second->getType() == ResourceType::Shader) {
-                auto shaderResource = std::dynamic_pointer_cast<ShaderResource>(pair.second);
-                if (shaderResource && shaderResource->isLoaded()) {
-                    bgfx::destroy(shaderResource->getShader().getProgram());
+                if (resource->reload()) {
+                    m_cache.updateMemoryUsage(handle);
+                    // 重新加载后可能变为可以流式加载，例如刚生成了预处理过的纹理
+                    if (resource->isStreamable() &&
+                        std::find(m_streamingResources.begin(), m_streamingResources.end(), handle) ==
+                        m_streamingResources.end()) {
+                        m_streamingResources.push_back(handle);
+                    }
+                    spdlog::info("Reloaded resource: {}", resource->getPath());
+                } else {
+                    spdlog::error("Failed to reload resource: {}", resource->getPath());
                 }
             }
-            pair.second->unload();
         }
-        m_resources.clear();
+        m_changedFiles.clear();
+    }
+
+    void ResourceManager::setMemoryBudget(const ResourceType type, const size_t bytes) {
+        m_cache.setBudget(type, bytes);
+        trim();
+    }
+
+    size_t ResourceManager::trim() {
+        const size_t count = m_cache.trim(m_evicted);
+        for (const auto &resource: m_evicted) {
+            releaseResource(resource);
+        }
+        m_evicted.clear();
+        return count;
+    }
+
+    RefPtr<Resource> ResourceManager::createResource(const ResourceType type, const ResourceHandle &handle,
+                                                     const std::string &path) const {
+        if (!handle.isValid()) {
+            // 该类型的槽位已用尽
+            return nullptr;
+        }
+        const auto factoryIt = m_resourceFactories.find(type);
+        if (factoryIt == m_resourceFactories.end()) {
+            // 处理未知资源类型
+            return nullptr;
+        }
+        RefPtr<Resource> resource = factoryIt->second(handle, path);
+        if (resource && type == ResourceType::Texture && m_textureAtlas && isTextureAtlasPath(path)) {
+            std::static_pointer_cast<TextureResource>(resource)->setAtlas(m_textureAtlas.get());
+        }
+        return resource;
+    }
+
+    RefPtr<ResourceLoadRequest> ResourceManager::loadAsync(const ResourceType type, const ResourcePath &path) {
+        const ResourceHandle existing = findHandle(path);
+        if (existing.isValid() && existing.getType() != type) {
+            return createRefPtr<ResourceLoadRequest>(nullptr, ResourceLoadState::Failed);
+        }
+        if (RefPtr<Resource> cached = m_cache.find(existing)) {
+            return createRefPtr<ResourceLoadRequest>(std::move(cached), ResourceLoadState::Ready);
+        }
+        return requestLoad(type, path);
+    }
+
+    RefPtr<ResourceLoadRequest> ResourceManager::requestLoad(const ResourceType type, const ResourcePath &path) {
+        if (const auto pending = m_pendingLoads.find(findHandle(path)); pending != m_pendingLoads.end()) {
+            return pending->second;
+        }
+
+        const ResourceHandle handle = m_cache.allocate(type);
+        RefPtr<Resource> resource = createResource(type, handle, std::string(path.path));
+        if (!resource) {
+            m_cache.erase(handle);
+            return createRefPtr<ResourceLoadRequest>(nullptr, ResourceLoadState::Failed);
+        }
+
+        if (!m_loader) {
+            m_loader = createScopePtr<ResourceLoader>();
+        }
+
+        auto request = createRefPtr<ResourceLoadRequest>(std::move(resource));
+        m_pendingLoads.emplace(handle, request);
+        registerPath(path, handle);
+        m_loader->submit(request);
+        return request;
+    }
+
+    void ResourceManager::completeLoad(const RefPtr<ResourceLoadRequest> &request) {
+        const RefPtr<Resource> &resource = request->getResource();
+        const ResourceHandle handle = resource->getHandle();
+        // 同一请求可能已经由 update 或 waitForResource 处理过
+        if (m_pendingLoads.erase(handle) == 0) {
+            return;
+        }
+
+        // 加载期间槽位可能已被 unloadAllResources 释放，此时同样视为失败
+        if (request->getState() != ResourceLoadState::Ready || !addResource(resource)) {
+            m_cache.erase(handle);
+            releaseResource(resource);
+        }
+    }
+
+    bool ResourceManager::addResource(const RefPtr<Resource> &resource) {
+        if (!m_cache.insert(resource)) {
+            return false;
+        }
+        if (resource->isStreamable()) {
+            m_streamingResources.push_back(resource->getHandle());
+        }
+        if (m_fileWatcher) {
+            watchResource(*resource);
+        }
+        trim();
+        return true;
+    }
+
+    void ResourceManager::releaseResource(const RefPtr<Resource> &resource) {
+        const auto it = m_pathHandles.find(ResourceId(resource->getPath()));
+        if (it != m_pathHandles.end() && it->second == resource->getHandle()) {
+            m_pathHandles.erase(it);
+        }
+        if (m_fileWatcher) {
+            unwatchResource(*resource);
+        }
+        resource->unload();
+    }
+
+    ResourceHandle ResourceManager::findHandle(const ResourcePath &path) const {
+        // 所有按 id 的查找都经过这里，先确认该 id 没有被另一个路径占用
+        path.checkCollision();
+        const auto it = m_pathHandles.find(path.id);
+        return it != m_pathHandles.end() ? it->second : ResourceHandle();
+    }
+
+    void ResourceManager::registerPath(const ResourcePath &path, const ResourceHandle handle) {
+        m_pathHandles[path.id] = handle;
+    }
+
+    template<typename T>
+    RefPtr<T> ResourceManager::getResource(const ResourceHandle &handle) {
+        // 句柄中带有资源类型，类型一致时槽位中的资源一定是 T
+        if (handle.getType() != T::staticResourceType) {
+            return nullptr;
+        }
+        return std::static_pointer_cast<T>(m_cache.find(handle));
+    }
+
+    void ResourceManager::unloadResource(const ResourceHandle &handle) {
+        // 各资源的 unload 负责销毁自己的 bgfx 句柄
+        if (const RefPtr<Resource> resource = m_cache.erase(handle)) {
+            releaseResource(resource);
+        }
+    }
+
+    void ResourceManager::unloadAllResources() {
+        m_groupResources.clear();
+        m_groupRefs.clear();
+        m_groups.releaseAll();
+        for (const auto &resource: m_cache.clear()) {
+            if (m_fileWatcher) {
+                unwatchResource(*resource);
+            }
+            resource->unload();
+        }
+        m_pathHandles.clear();
+        // 图集中的纹理已全部卸载，回收所有页
+        if (m_textureAtlas) {
+            m_textureAtlas->clear();
+        }
     }
 
     template RefPtr<TextureResource> ResourceManager::loadResource<TextureResource>(const std::string& path);
     template RefPtr<ShaderResource> ResourceManager::loadResource<ShaderResource>(const std::string& path);
+    template RefPtr<TextureResource> ResourceManager::loadResource<TextureResource>(const InternedString& path);
+    template RefPtr<ShaderResource> ResourceManager::loadResource<ShaderResource>(const InternedString& path);
+    template RefPtr<TextureResource> ResourceManager::loadResource<TextureResource>(const ResourcePath& path);
+    template RefPtr<ShaderResource> ResourceManager::loadResource<ShaderResource>(const ResourcePath& path);
+
+    template ResourceFuture<TextureResource> ResourceManager::loadResourceAsync<TextureResource>(const std::string& path);
+    template ResourceFuture<ShaderResource> ResourceManager::loadResourceAsync<ShaderResource>(const std::string& path);
+    template ResourceFuture<TextureResource> ResourceManager::loadResourceAsync<TextureResource>(const InternedString& path);
+    template ResourceFuture<ShaderResource> ResourceManager::loadResourceAsync<ShaderResource>(const InternedString& path);
+    template ResourceFuture<TextureResource> ResourceManager::loadResourceAsync<TextureResource>(const ResourcePath& path);
+    template ResourceFuture<ShaderResource> ResourceManager::loadResourceAsync<ShaderResource>(const ResourcePath& path);
+
+    template RefPtr<TextureResource> ResourceManager::waitForResource<TextureResource>(const ResourceFuture<TextureResource>& future);
+    template RefPtr<ShaderResource> ResourceManager::waitForResource<ShaderResource>(const ResourceFuture<ShaderResource>& future);
+
+    template std::vector<RefPtr<TextureResource>> ResourceManager::loadResources<TextureResource>(const std::vector<std::string>& paths);
+    template std::vector<RefPtr<ShaderResource>> ResourceManager::loadResources<ShaderResource>(const std::vector<std::string>& paths);
 
     template RefPtr<TextureResource> ResourceManager::getResource<TextureResource>(const ResourceHandle& handle);
     template RefPtr<ShaderResource> ResourceManager::getResource<ShaderResource>(const ResourceHandle& handle);
@@ -4,13 +4,26 @@
 #include <functional>
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include "ResourceCache.hpp"
+#include "ResourceGroup.hpp"
 #include "ResourceHandle.hpp"
 #include "Resource.hpp"
+#include "ResourceLoader.hpp"
+#include "ResourcePack.hpp"
+#include "ResourcePath.hpp"
+#include "base/InternedString.hpp"
 #include "core/Core.hpp"
+#include "filesystem/FileWatcher.hpp"
 
 namespace Tina {
+    class Config;
+    class TextureAtlas;
     class TextureResource;
 
+    // 资源组加载进度，每完成一个资源（无论成功与否）回调一次
+    using ResourceGroupProgress = std::function<void(size_t loaded, size_t total)>;
+
     class ResourceManager {
 
     public:
@@ -20,6 +33,83 @@ namespace Tina {
         template<typename T,typename... Args>
         RefPtr<T> loadResource(const std::string& path, Args&&... args);
 
+        template<typename T,typename... Args>
+        RefPtr<T> loadResource(const InternedString& path, Args&&... args);
+
+        // 每帧重复按路径取资源时使用，配合 "path"_res 字面量在编译期算好 id，查找时不再遍历路径
+        template<typename T,typename... Args>
+        RefPtr<T> loadResource(const ResourcePath& path, Args&&... args);
+
+        // 异步加载：读文件和解码在工作线程完成，GPU 上传在 update() 中按预算进行。
+        // 资源已加载时返回立即就绪的句柄，同一资源正在加载时返回同一个请求
+        template<typename T>
+        ResourceFuture<T> loadResourceAsync(const std::string& path);
+
+        template<typename T>
+        ResourceFuture<T> loadResourceAsync(const InternedString& path);
+
+        template<typename T>
+        ResourceFuture<T> loadResourceAsync(const ResourcePath& path);
+
+        // 渲染线程上等待异步加载完成，会立即上传该资源而不等到下一次 update()
+        template<typename T>
+        RefPtr<T> waitForResource(const ResourceFuture<T>& future);
+
+        // 批量加载：先把所有资源提交到工作线程并行解码，再按 paths 的顺序在当前（渲染）线程上传。
+        // 返回值与 paths 一一对应，加载失败的位置为 nullptr
+        template<typename T>
+        std::vector<RefPtr<T>> loadResources(const std::vector<std::string>& paths);
+
+        // 资源组：按名称整体预加载和卸载，组之间可以声明依赖，共享的依赖按引用计数加载
+        bool defineResourceGroup(ResourceGroupDesc desc);
+        // 从配置的 resources: 节定义资源组，返回成功定义的组数
+        size_t defineResourceGroups(const Config& config);
+        // 加载组及其尚未加载的依赖，所有资源先并行解码再依次上传。已加载的组只增加引用计数。
+        // 组不存在或依赖有环时返回 false；部分资源加载失败时同样返回 false，但组仍视为已加载
+        bool loadResourceGroup(const std::string& name, const ResourceGroupProgress& progress = nullptr);
+        // 与 loadResourceGroup 配对调用；引用计数归零的组中不再被其他组引用的资源，
+        // 没有外部引用时立即卸载，否则交给缓存按预算淘汰
+        bool unloadResourceGroup(const std::string& name);
+        [[nodiscard]] bool isResourceGroupLoaded(const std::string& name) const { return m_groups.getRefCount(name) > 0; }
+
+        // 每帧在渲染线程调用一次，上传已解码的资源、继续流式加载并淘汰超出预算的缓存。
+        // uploadBudgetBytes 为本帧允许上传的字节数，异步加载优先，剩余的额度用于流式加载。
+        // 需在上一帧的 bgfx::frame() 之后、本帧绘制之前调用，此时回收之前释放的图集区域
+        void update(size_t uploadBudgetBytes = DEFAULT_UPLOAD_BUDGET);
+
+        [[nodiscard]] size_t getPendingLoadCount() const { return m_pendingLoads.size(); }
+
+        static constexpr size_t DEFAULT_UPLOAD_BUDGET = 8 * 1024 * 1024;
+        static constexpr size_t DEFAULT_TEXTURE_BUDGET = 256 * 1024 * 1024;
+        static constexpr size_t DEFAULT_SHADER_BUDGET = 16 * 1024 * 1024;
+
+        // 某类资源的内存预算，超出时淘汰最久未使用且只被管理器持有的资源，0 表示不限制
+        void setMemoryBudget(ResourceType type, size_t bytes);
+        [[nodiscard]] size_t getMemoryBudget(ResourceType type) const { return m_cache.getBudget(type); }
+        [[nodiscard]] size_t getMemoryUsage(ResourceType type) const { return m_cache.getMemoryUsage(type); }
+        [[nodiscard]] ResourceMemoryUsage getTotalMemoryUsage() const { return m_cache.getTotalMemoryUsage(); }
+        [[nodiscard]] const ResourceCacheStats &getCacheStats() const { return m_cache.getStats(); }
+        void resetCacheStats() { m_cache.resetStats(); }
+
+        // 立即淘汰超出预算的资源，返回淘汰数量
+        size_t trim();
+
+        // 开启后监视已加载资源的文件，文件保存后在 update() 中原地重新加载
+        void setHotReloadEnabled(bool enabled);
+        [[nodiscard]] bool isHotReloadEnabled() const { return m_fileWatcher != nullptr; }
+
+        // 挂载资源包，之后按路径加载的资源优先从包中读取；后挂载的包优先，管理器销毁时卸载
+        bool mountPack(const std::string& path);
+
+        // 之后加载的、规范化路径位于 directory 下的小纹理放入运行时图集（空字符串表示所有路径），见 TextureResource::setAtlas。
+        // 图集中的纹理只能用于 2D 绘制，需要独立纹理的材质等资源应放在其他目录。
+        // 只能开启一次；图集在 unloadAllResources 时清空，管理器销毁时释放
+        void enableTextureAtlas(const std::string& directory, uint16_t pageSize = 2048, uint16_t maxEntrySize = 256);
+        [[nodiscard]] TextureAtlas* getTextureAtlas() const { return m_textureAtlas.get(); }
+
+        // 路径尚未加载也未在加载中时返回无效句柄；调试构建中同时检查路径哈希冲突
+        [[nodiscard]] ResourceHandle findHandle(const ResourcePath& path) const;
+
         template<typename T>
         RefPtr<T> getResource(const ResourceHandle& handle);
 
@@ -35,8 +125,45 @@ namespace Tina {
 
 
     private:
-        std::unordered_map<ResourceHandle,RefPtr<Resource>> m_resources;
+        RefPtr<Resource> createResource(ResourceType type, const ResourceHandle& handle, const std::string& path) const;
+        [[nodiscard]] bool isTextureAtlasPath(const std::string& path) const;
+        RefPtr<ResourceLoadRequest> loadAsync(ResourceType type, const ResourcePath& path);
+        RefPtr<ResourceLoadRequest> requestLoad(ResourceType type, const ResourcePath& path);
+        void completeLoad(const RefPtr<ResourceLoadRequest>& request);
+        bool addResource(const RefPtr<Resource>& resource);
+        void releaseResource(const RefPtr<Resource>& resource);
+        // 新建资源时登记路径；哈希冲突已在之前的 findHandle 中检查过
+        void registerPath(const ResourcePath& path, ResourceHandle handle);
+        void watchResource(const Resource& resource);
+        void unwatchResource(const Resource& resource);
+        void reloadChangedResources();
+        void streamResources(size_t budgetBytes, size_t uploadedBytes);
+
+        ResourceCache m_cache;
+        // 已加载和正在加载的资源，以规范化路径的 id 为键
+        std::unordered_map<ResourceId,ResourceHandle> m_pathHandles;
         std::unordered_map<ResourceType,std::function<RefPtr<Resource>(const ResourceHandle& handle,const std::string& path)>> m_resourceFactories;
+        // 正在异步加载的资源，用于合并重复请求
+        std::unordered_map<ResourceHandle,RefPtr<ResourceLoadRequest>> m_pendingLoads;
+        // 第一次异步加载时才创建，只做同步加载的管理器不会启动工作线程
+        ScopePtr<ResourceLoader> m_loader;
+        std::vector<RefPtr<ResourceLoadRequest>> m_completedLoads;
+        std::vector<RefPtr<Resource>> m_evicted;
+        // 热重载：被监视的文件及依赖它的资源
+        ScopePtr<FileWatcher> m_fileWatcher;
+        std::unordered_map<std::string,std::vector<ResourceHandle>> m_watchedFiles;
+        std::vector<std::string> m_changedFiles;
+        std::vector<RefPtr<ResourcePack>> m_packs;
+        // 按 mip 等逐步加载的资源，每帧检查是否需要继续上传
+        std::vector<ResourceHandle> m_streamingResources;
+        ScopePtr<TextureAtlas> m_textureAtlas;
+        // 规范化的图集目录，空字符串表示所有路径
+        std::string m_textureAtlasDirectory;
+        ResourceGroupGraph m_groups;
+        // 已加载的组持有其资源，使其不会被预算淘汰
+        std::unordered_map<std::string,std::vector<RefPtr<Resource>>> m_groupResources;
+        // 每个资源被多少个已加载的组持有
+        std::unordered_map<ResourceHandle,size_t> m_groupRefs;
     };
 
  
@@ -0,0 +1,144 @@
+#include "ResourcePack.hpp"
+#include "tool/Endianness.hpp"
+#include "tool/Lz4.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Tina {
+    namespace {
+        std::shared_mutex &getMountMutex() {
+            static std::shared_mutex mutex;
+            return mutex;
+        }
+
+        std::vector<RefPtr<ResourcePack>> &getMountedPacks() {
+            static std::vector<RefPtr<ResourcePack>> packs;
+            return packs;
+        }
+    }
+
+    bool ResourcePack::open(const Path &path) {
+        close();
+        // 索引项直接映射为结构体读取，格式固定为小端
+        if constexpr (!Tool::IS_LITTLE_ENDIAN) {
+            std::cerr << "Resource packs are not supported on big-endian hosts" << std::endl;
+            return false;
+        }
+
+        if (!m_file.open(path, MappedFile::AccessPattern::Random)) {
+            std::cerr << "Failed to open resource pack: " << path.toString() << std::endl;
+            return false;
+        }
+
+        const uint8_t *base = m_file.data();
+        const size_t fileSize = m_file.size();
+        const auto fail = [&](const char *reason) {
+            std::cerr << "Invalid resource pack " << path.toString() << ": " << reason << std::endl;
+            m_file.close();
+            return false;
+        };
+
+        if (fileSize < sizeof(Header)) {
+            return fail("truncated header");
+        }
+        const auto *header = reinterpret_cast<const Header *>(base);
+        if (header->magic != MAGIC || header->version != VERSION) {
+            return fail("bad magic or version");
+        }
+        if (header->indexOffset % alignof(Entry) != 0 || header->indexOffset > fileSize ||
+            header->entryCount > (fileSize - header->indexOffset) / sizeof(Entry)) {
+            return fail("index out of range");
+        }
+        if (header->pathsOffset > fileSize || header->pathsSize > fileSize - header->pathsOffset ||
+            (header->pathsSize > 0 && base[header->pathsOffset + header->pathsSize - 1] != '\0')) {
+            return fail("path table out of range");
+        }
+
+        const auto *entries = reinterpret_cast<const Entry *>(base + header->indexOffset);
+        for (uint32_t i = 0; i < header->entryCount; ++i) {
+            const Entry &entry = entries[i];
+            if (entry.offset > fileSize || entry.size > fileSize - entry.offset || entry.pathOffset >= header->pathsSize) {
+                return fail("entry out of range");
+            }
+            if (!(entry.flags & Compressed) && entry.size != entry.originalSize) {
+                return fail("entry size mismatch");
+            }
+            if (i > 0 && entries[i - 1].id >= entry.id) {
+                return fail("index not sorted");
+            }
+        }
+
+        m_header = header;
+        m_entries = entries;
+        m_paths = reinterpret_cast<const char *>(base + header->pathsOffset);
+        return true;
+    }
+
+    void ResourcePack::close() {
+        m_header = nullptr;
+        m_entries = nullptr;
+        m_paths = nullptr;
+        m_file.close();
+    }
+
+    const ResourcePack::Entry *ResourcePack::find(const ResourceId id) const {
+        if (!m_header) {
+            return nullptr;
+        }
+        const Entry *end = m_entries + m_header->entryCount;
+        const Entry *it = std::lower_bound(m_entries, end, id.getValue(), [](const Entry &entry, uint64_t value) {
+            return entry.id < value;
+        });
+        return it != end && it->id == id.getValue() ? it : nullptr;
+    }
+
+    std::string_view ResourcePack::getPath(const Entry &entry) const {
+        return m_paths + entry.pathOffset;
+    }
+
+    ByteView ResourcePack::getData(const Entry &entry) const {
+        return {m_file.data() + entry.offset, static_cast<size_t>(entry.size)};
+    }
+
+    bool ResourcePack::read(const Entry &entry, std::vector<uint8_t> &out) const {
+        const ByteView data = getData(entry);
+        out.resize(static_cast<size_t>(entry.originalSize));
+        if (entry.flags & Compressed) {
+            return Tool::Lz4Decompress(data.data(), data.size(), out.data(), out.size());
+        }
+        if (!out.empty()) {
+            memcpy(out.data(), data.data(), data.size());
+        }
+        return true;
+    }
+
+    void ResourcePack::mount(const RefPtr<ResourcePack> &pack) {
+        if (!pack || !pack->isOpen()) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(getMountMutex());
+        getMountedPacks().push_back(pack);
+    }
+
+    void ResourcePack::unmount(const RefPtr<ResourcePack> &pack) {
+        std::unique_lock<std::shared_mutex> lock(getMountMutex());
+        auto &packs = getMountedPacks();
+        packs.erase(std::remove(packs.begin(), packs.end(), pack), packs.end());
+    }
+
+    RefPtr<ResourcePack> ResourcePack::findMounted(const ResourceId id, const Entry *&entry) {
+        std::shared_lock<std::shared_mutex> lock(getMountMutex());
+        const auto &packs = getMountedPacks();
+        for (auto it = packs.rbegin(); it != packs.rend(); ++it) {
+            if ((entry = (*it)->find(id))) {
+                return *it;
+            }
+        }
+        entry = nullptr;
+        return nullptr;
+    }
+}
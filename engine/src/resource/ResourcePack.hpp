@@ -0,0 +1,84 @@
+#ifndef TINA_CORE_RESOURCE_PACK_HPP
+#define TINA_CORE_RESOURCE_PACK_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "ResourcePath.hpp"
+#include "base/NonCopyable.hpp"
+#include "core/Core.hpp"
+#include "filesystem/ByteView.hpp"
+#include "filesystem/MappedFile.hpp"
+
+namespace Tina {
+    /**
+     * 资源包：把 resources/ 下的散文件合并成一个文件，运行时整体映射，按 ResourceId 二分查找。
+     * 启动时只需打开一个文件、顺序换入页面，而不是对每个资源各做一次 open/stat。
+     *
+     * 文件布局（小端）：
+     *   Header | 按 id 升序排列的 Entry 索引 | 以 '\0' 结尾的规范化路径表 | 数据块
+     * 数据块按 Header::alignment 对齐，可以是 LZ4 块压缩的；未压缩的数据直接以映射内存的视图返回。
+     */
+    class ResourcePack : public NonCopyable {
+    public:
+        static constexpr uint32_t MAGIC = 0x4B415054; // "TPAK"
+        static constexpr uint32_t VERSION = 1;
+
+        enum EntryFlags : uint32_t {
+            Compressed = 1 << 0,
+        };
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t alignment;
+            uint64_t indexOffset;
+            uint64_t pathsOffset;
+            uint64_t pathsSize;
+        };
+
+        struct Entry {
+            uint64_t id;
+            uint64_t offset;
+            // 包内存储的大小，压缩时为压缩后的大小
+            uint64_t size;
+            uint64_t originalSize;
+            uint32_t pathOffset;
+            uint32_t flags;
+        };
+
+        static_assert(sizeof(Header) == 40 && sizeof(Entry) == 40, "ResourcePack layout must not have padding");
+
+        // 映射并校验资源包，格式错误时返回 false
+        bool open(const Path &path);
+        void close();
+
+        [[nodiscard]] bool isOpen() const { return m_header != nullptr; }
+        [[nodiscard]] size_t getEntryCount() const { return m_header ? m_header->entryCount : 0; }
+        [[nodiscard]] const Entry &getEntry(size_t index) const { return m_entries[index]; }
+
+        // 不存在时返回 nullptr
+        [[nodiscard]] const Entry *find(ResourceId id) const;
+        [[nodiscard]] std::string_view getPath(const Entry &entry) const;
+
+        // 包内存储的原始数据，不拷贝；压缩条目返回的是压缩后的数据
+        [[nodiscard]] ByteView getData(const Entry &entry) const;
+        // 读出（必要时解压）条目数据到 out
+        bool read(const Entry &entry, std::vector<uint8_t> &out) const;
+
+        // 全局挂载表，ResourceData 从这里查找资源；后挂载的包优先。可在任意线程调用
+        static void mount(const RefPtr<ResourcePack> &pack);
+        static void unmount(const RefPtr<ResourcePack> &pack);
+        // 返回包含 id 的资源包，entry 指向其索引项
+        static RefPtr<ResourcePack> findMounted(ResourceId id, const Entry *&entry);
+
+    private:
+        MappedFile m_file;
+        const Header *m_header = nullptr;
+        const Entry *m_entries = nullptr;
+        const char *m_paths = nullptr;
+    };
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "ResourcePackWriter.hpp"
+#include "tool/Lz4.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace Tina {
+    namespace {
+        uint64_t alignUp(uint64_t value, uint64_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    ResourcePackWriter::ResourcePackWriter(const uint32_t alignment) : m_alignment(alignment) {
+        if (alignment < alignof(ResourcePack::Entry) || (alignment & (alignment - 1)) != 0) {
+            throw std::runtime_error("Resource pack alignment must be a power of two >= 8");
+        }
+    }
+
+    void ResourcePackWriter::add(const std::string_view path, const void *data, const size_t size, const bool compress) {
+        PendingEntry entry;
+        entry.path = ResourcePath::normalize(path);
+        entry.id = ResourceId(entry.path);
+        entry.originalSize = size;
+        entry.flags = 0;
+
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        if (compress && size > 0) {
+            entry.data.resize(Tool::Lz4CompressBound(size));
+            const size_t compressedSize = Tool::Lz4Compress(bytes, size, entry.data.data(), entry.data.size());
+            if (compressedSize > 0 && compressedSize < size) {
+                entry.data.resize(compressedSize);
+                entry.flags |= ResourcePack::Compressed;
+            }
+        }
+        if (!(entry.flags & ResourcePack::Compressed)) {
+            entry.data.assign(bytes, bytes + size);
+        }
+        m_entries.push_back(std::move(entry));
+    }
+
+    bool ResourcePackWriter::addFile(const std::string_view path, const Path &file, const bool compress) {
+        std::ifstream stream(file.toString(), std::ios::binary | std::ios::ate);
+        if (!stream) {
+            std::cerr << "Failed to open file for packing: " << file.toString() << std::endl;
+            return false;
+        }
+        std::vector<uint8_t> data(static_cast<size_t>(stream.tellg()));
+        stream.seekg(0);
+        if (!stream.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            std::cerr << "Failed to read file for packing: " << file.toString() << std::endl;
+            return false;
+        }
+        add(path, data.data(), data.size(), compress);
+        return true;
+    }
+
+    bool ResourcePackWriter::write(const Path &outputPath) const {
+        std::vector<const PendingEntry *> sorted;
+        sorted.reserve(m_entries.size());
+        for (const auto &entry: m_entries) {
+            sorted.push_back(&entry);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const PendingEntry *a, const PendingEntry *b) {
+            return a->id.getValue() < b->id.getValue();
+        });
+        for (size_t i = 1; i < sorted.size(); ++i) {
+            if (sorted[i - 1]->id == sorted[i]->id) {
+                if (sorted[i - 1]->path != sorted[i]->path) {
+                    throw std::runtime_error("Resource id collision in pack: '" + sorted[i - 1]->path +
+                                             "' and '" + sorted[i]->path + "'");
+                }
+                throw std::runtime_error("Duplicate resource in pack: " + sorted[i]->path);
+            }
+        }
+
+        ResourcePack::Header header{};
+        header.magic = ResourcePack::MAGIC;
+        header.version = ResourcePack::VERSION;
+        header.entryCount = static_cast<uint32_t>(sorted.size());
+        header.alignment = m_alignment;
+        header.indexOffset = sizeof(ResourcePack::Header);
+        header.pathsOffset = header.indexOffset + sorted.size() * sizeof(ResourcePack::Entry);
+
+        std::string paths;
+        std::vector<ResourcePack::Entry> index(sorted.size());
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            index[i].id = sorted[i]->id.getValue();
+            index[i].pathOffset = static_cast<uint32_t>(paths.size());
+            index[i].size = sorted[i]->data.size();
+            index[i].originalSize = sorted[i]->originalSize;
+            index[i].flags = sorted[i]->flags;
+            paths.append(sorted[i]->path);
+            paths.push_back('\0');
+        }
+        header.pathsSize = paths.size();
+
+        uint64_t offset = header.pathsOffset + header.pathsSize;
+        for (auto &entry: index) {
+            offset = alignUp(offset, m_alignment);
+            entry.offset = offset;
+            offset += entry.size;
+        }
+
+        std::ofstream stream(outputPath.toString(), std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            std::cerr << "Failed to create resource pack: " << outputPath.toString() << std::endl;
+            return false;
+        }
+        // 头和索引直接按内存布局写出，ResourcePack::open 只支持小端主机
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(index.data()),
+                     static_cast<std::streamsize>(index.size() * sizeof(ResourcePack::Entry)));
+        stream.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+
+        uint64_t position = header.pathsOffset + header.pathsSize;
+        const std::vector<char> padding(m_alignment, 0);
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            stream.write(padding.data(), static_cast<std::streamsize>(index[i].offset - position));
+            stream.write(reinterpret_cast<const char *>(sorted[i]->data.data()),
+                         static_cast<std::streamsize>(sorted[i]->data.size()));
+            position = index[i].offset + index[i].size;
+        }
+
+        if (!stream) {
+            std::cerr << "Failed to write resource pack: " << outputPath.toString() << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef TINA_CORE_RESOURCE_PACK_WRITER_HPP
+#define TINA_CORE_RESOURCE_PACK_WRITER_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ResourcePack.hpp"
+
+namespace Tina {
+    /**
+     * 生成 ResourcePack 文件，供打包工具和测试使用。
+     * 条目按规范化路径的 ResourceId 排序，两个不同路径的 id 冲突时 write 抛出 std::runtime_error。
+     */
+    class ResourcePackWriter {
+    public:
+        // alignment 为数据块的对齐字节数，必须是 2 的幂
+        explicit ResourcePackWriter(uint32_t alignment = 16);
+
+        // path 为运行时加载资源使用的路径；compress 为 true 时尝试 LZ4 压缩，只有变小时才保留压缩结果
+        void add(std::string_view path, const void *data, size_t size, bool compress = true);
+        // 读取文件失败时返回 false
+        bool addFile(std::string_view path, const Path &file, bool compress = true);
+
+        bool write(const Path &outputPath) const;
+
+        [[nodiscard]] size_t getEntryCount() const { return m_entries.size(); }
+
+    private:
+        struct PendingEntry {
+            std::string path;
+            ResourceId id;
+            std::vector<uint8_t> data;
+            uint64_t originalSize;
+            uint32_t flags;
+        };
+
+        uint32_t m_alignment;
+        std::vector<PendingEntry> m_entries;
+    };
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "ResourcePath.hpp"
+
+#include <vector>
+
+#ifdef DEBUG
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#endif
+
+namespace Tina {
+    std::string ResourcePath::normalize(std::string_view path) {
+        const auto isSeparator = [](char c) { return c == '/' || c == '\\'; };
+        const bool absolute = !path.empty() && isSeparator(path[0]);
+
+        std::vector<std::string_view> segments;
+        size_t begin = 0;
+        while (begin < path.size()) {
+            size_t end = begin;
+            while (end < path.size() && !isSeparator(path[end])) {
+                ++end;
+            }
+            const std::string_view segment = path.substr(begin, end - begin);
+            begin = end + 1;
+
+            if (segment.empty() || segment == ".") {
+                continue;
+            }
+            if (segment == "..") {
+                if (!segments.empty() && segments.back() != "..") {
+                    segments.pop_back();
+                } else if (!absolute) {
+                    segments.push_back(segment);
+                }
+                continue;
+            }
+            segments.push_back(segment);
+        }
+
+        std::string result;
+        result.reserve(path.size());
+        if (absolute) {
+            result.push_back('/');
+        }
+        for (size_t i = 0; i < segments.size(); ++i) {
+            if (i > 0) {
+                result.push_back('/');
+            }
+            result.append(segments[i]);
+        }
+        return result;
+    }
+
+    void ResourcePath::checkCollision() const {
+#ifdef DEBUG
+        static std::mutex mutex;
+        static std::unordered_map<ResourceId, std::string> registry;
+
+        std::string normalized = normalize(path);
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto [it, inserted] = registry.emplace(id, normalized);
+        if (!inserted && it->second != normalized) {
+            throw std::runtime_error("Resource path hash collision: \"" + it->second + "\" and \"" + normalized + "\"");
+        }
+#endif
+    }
+
+    bool ResourcePath::isCollisionCheckEnabled() {
+#ifdef DEBUG
+        return true;
+#else
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,145 @@
+#ifndef TINA_CORE_RESOURCE_PATH_HPP
+#define TINA_CORE_RESOURCE_PATH_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#if defined(__cpp_consteval)
+#define TINA_CONSTEVAL consteval
+#else
+#define TINA_CONSTEVAL constexpr
+#endif
+
+namespace Tina {
+    /**
+     * 资源路径的 64 位标识：对规范化后的路径做 FNV-1a 哈希。
+     * 规范化与哈希同时进行，不需要先生成规范化的字符串，因此可以在编译期求值，
+     * "./textures/a.png"、"textures//a.png" 和 "textures/a.png" 得到同一个 id。
+     */
+    class ResourceId {
+    public:
+        constexpr ResourceId() = default;
+
+        constexpr explicit ResourceId(std::string_view path) : m_value(hash(path)) {
+        }
+
+        [[nodiscard]] constexpr uint64_t getValue() const { return m_value; }
+        [[nodiscard]] constexpr bool isValid() const { return m_value != 0; }
+
+        constexpr bool operator==(const ResourceId &other) const { return m_value == other.m_value; }
+        constexpr bool operator!=(const ResourceId &other) const { return m_value != other.m_value; }
+
+        /**
+         * 规范化规则：'\\' 视为 '/'，连续的分隔符合并，"." 去掉，".." 与前一段抵消，
+         * 开头的 '/' 保留。为了不借助栈处理 ".."，各段按从后往前的顺序参与哈希，
+         * 这只影响哈希值本身，规范化结果相同的路径哈希一定相同。
+         */
+        static constexpr uint64_t hash(std::string_view path) {
+            uint64_t value = FNV_OFFSET_BASIS;
+            size_t end = path.size();
+            size_t pendingParents = 0;
+            bool first = true;
+            while (end > 0) {
+                while (end > 0 && isSeparator(path[end - 1])) {
+                    --end;
+                }
+                size_t begin = end;
+                while (begin > 0 && !isSeparator(path[begin - 1])) {
+                    --begin;
+                }
+                const std::string_view segment = path.substr(begin, end - begin);
+                end = begin;
+
+                if (segment.empty() || segment == ".") {
+                    continue;
+                }
+                if (segment == "..") {
+                    ++pendingParents;
+                    continue;
+                }
+                if (pendingParents > 0) {
+                    --pendingParents;
+                    continue;
+                }
+                value = mixSegment(value, segment, first);
+                first = false;
+            }
+
+            const bool absolute = !path.empty() && isSeparator(path[0]);
+            if (absolute) {
+                // 根目录之上没有父目录，多余的 ".." 丢弃
+                value = mix(value, '/');
+            } else {
+                for (; pendingParents > 0; --pendingParents) {
+                    value = mixSegment(value, "..", first);
+                    first = false;
+                }
+            }
+            return value == 0 ? 1 : value;
+        }
+
+    private:
+        static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+        static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+        static constexpr bool isSeparator(char c) {
+            return c == '/' || c == '\\';
+        }
+
+        static constexpr uint64_t mix(uint64_t value, char c) {
+            return (value ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+        }
+
+        static constexpr uint64_t mixSegment(uint64_t value, std::string_view segment, bool first) {
+            if (!first) {
+                value = mix(value, '/');
+            }
+            for (const char c: segment) {
+                value = mix(value, c);
+            }
+            return value;
+        }
+
+        uint64_t m_value = 0;
+    };
+
+    /**
+     * 资源路径及其预先计算的 id。对字面量使用 _res 后缀时 id 在编译期算好，
+     * 运行时查找资源不再需要遍历路径字符串。path 只是视图，调用方需保证其在使用期间有效。
+     */
+    struct ResourcePath {
+        std::string_view path;
+        ResourceId id;
+
+        constexpr explicit ResourcePath(std::string_view path) : path(path), id(path) {
+        }
+
+        // 把 path 规范化为字符串，与 ResourceId 使用相同的规则
+        static std::string normalize(std::string_view path);
+
+        // 调试构建中记录 id 与规范化路径的对应关系，两个不同的路径哈希相同时抛出异常；其他构建中为空操作
+        void checkCollision() const;
+
+        // 引擎是否以调试构建编译，即 checkCollision 是否生效
+        static bool isCollisionCheckEnabled();
+    };
+
+    inline namespace Literals {
+        TINA_CONSTEVAL ResourcePath operator""_res(const char *path, size_t length) {
+            return ResourcePath(std::string_view(path, length));
+        }
+    }
+}
+
+namespace std {
+    template <>
+    struct hash<Tina::ResourceId> {
+        size_t operator()(const Tina::ResourceId& id) const noexcept {
+            return static_cast<size_t>(id.getValue());
+        }
+    };
+}
+
+#endif
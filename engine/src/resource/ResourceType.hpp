@@ -8,7 +8,9 @@ enum class ResourceType {
   Texture,
   Model,
   Shader,
-  Sound
+  Sound,
+  // 类型数量，不是有效的资源类型
+  Count
   };
 
 
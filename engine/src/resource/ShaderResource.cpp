@@ -1,6 +1,28 @@
 #include "ShaderResource.hpp"
 
 namespace Tina {
+    namespace {
+        void releaseMappedFile(void *data, void *userData) {
+            (void)data;
+            delete static_cast<ResourceData *>(userData);
+        }
+
+        // bgfx 直接引用映射内存，用完后通过回调解除映射
+        const bgfx::Memory *makeMappedRef(ScopePtr<ResourceData> file) {
+            ResourceData *mapped = file.release();
+            return bgfx::makeRef(mapped->data(), static_cast<uint32_t>(mapped->size()), releaseMappedFile, mapped);
+        }
+
+        // 已挂载的资源包中有该文件时直接引用包内的数据
+        ScopePtr<ResourceData> mapShaderBinary(const std::string &path) {
+            auto file = ResourceData::open(path, MappedFile::AccessPattern::WillNeed);
+            if (!file || file->size() == 0) {
+                return nullptr;
+            }
+            return file;
+        }
+    }
+
     ShaderResource::ShaderResource(const ResourceHandle &handle, const std::string &path):Resource(handle,path,ResourceType::Shader) {
         
     }
@@ -14,13 +36,61 @@ namespace Tina {
             return true;
         }
 
-        m_shader.loadFromFile(m_path);
-        return m_shader.isValid();
+        // 与异步加载走同一条路径，以便记录着色器二进制的大小
+        return decode() && upload();
+    }
+
+    bool ShaderResource::decode() {
+        m_vertexData = mapShaderBinary(m_shader.getBinaryPath(m_path, "vs"));
+        m_fragmentData = mapShaderBinary(m_shader.getBinaryPath(m_path, "fs"));
+        return m_vertexData && m_fragmentData;
+    }
+
+    bool ShaderResource::upload() {
+        if (isLoaded()) {
+            return true;
+        }
+        if (!m_vertexData || !m_fragmentData) {
+            return false;
+        }
+        m_gpuSize = getUploadSize();
+        return m_shader.createFromMemory(makeMappedRef(std::move(m_vertexData)),
+                                         makeMappedRef(std::move(m_fragmentData)));
+    }
+
+    size_t ShaderResource::getUploadSize() const {
+        return (m_vertexData ? m_vertexData->size() : 0) + (m_fragmentData ? m_fragmentData->size() : 0);
+    }
+
+    bool ShaderResource::reload() {
+        if (!decode()) {
+            return false;
+        }
+
+        const size_t size = getUploadSize();
+        Shader shader;
+        if (!shader.createFromMemory(makeMappedRef(std::move(m_vertexData)),
+                                     makeMappedRef(std::move(m_fragmentData)))) {
+            return false;
+        }
+        // 旧程序随临时对象析构
+        m_shader.swap(shader);
+        m_gpuSize = size;
+        return true;
+    }
+
+    std::vector<std::string> ShaderResource::getWatchPaths() const {
+        return {m_shader.getBinaryPath(m_path, "vs"), m_shader.getBinaryPath(m_path, "fs")};
+    }
+
+    ResourceMemoryUsage ShaderResource::getMemoryUsage() const {
+        return {getUploadSize(), isLoaded() ? m_gpuSize : 0};
     }
 
     void ShaderResource::unload() {
         if (isLoaded()) {
             m_shader.destory();
+            m_gpuSize = 0;
         }
     }
 
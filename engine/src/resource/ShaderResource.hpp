@@ -3,6 +3,7 @@
 
 #include "Resource.hpp"
 #include "core/Shader.hpp"
+#include "ResourceData.hpp"
 
 namespace Tina{
 
@@ -13,14 +14,26 @@ namespace Tina{
 
         bool load() override;
         void unload() override;
+
+        bool decode() override;
+        bool upload() override;
+        [[nodiscard]] size_t getUploadSize() const override;
+        [[nodiscard]] ResourceMemoryUsage getMemoryUsage() const override;
+        bool reload() override;
+        [[nodiscard]] std::vector<std::string> getWatchPaths() const override;
+
         bool isLoaded() const override;
         const Shader &getShader() const;
 
         static constexpr ResourceType staticResourceType = ResourceType::Shader;
     private:
         Shader m_shader;
+        // decode 映射的着色器二进制，upload 时所有权转交给 bgfx
+        ScopePtr<ResourceData> m_vertexData;
+        ScopePtr<ResourceData> m_fragmentData;
+        size_t m_gpuSize = 0;
     };
 
 }
 
-#endif //TINA_CORE_SHADER_RESOURCE_HPP
\ No newline at end of file
+#endif //TINA_CORE_SHADER_RESOURCE_HPP
@@ -1,31 +1,236 @@
 #include "TextureResource.hpp"
+#include "graphics/TextureAtlas.hpp"
 #include "tool/BgfxUtils.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace Tina {
     TextureResource::TextureResource(const ResourceHandle &handle, const std::string &path):Resource(handle,path,ResourceType::Texture) {
     }
 
     TextureResource::~TextureResource() {
         TextureResource::unload();
+        if (m_image) {
+            bimg::imageFree(m_image);
+        }
     }
 
     bool TextureResource::load() {
         if (!isLoaded()) {
-            m_texture = BgfxUtils::loadTexture(m_path.c_str()); 
+            decode();
+            upload();
+        }
+        return isLoaded();
+    }
+
+    bool TextureResource::decode() {
+        if (m_image || m_streamData) {
+            return true;
+        }
+
+        // 能按 mip 流式加载时只解析文件头，像素数据留在映射内存中按需上传
+        auto info = createScopePtr<bimg::ImageContainer>();
+        if ((m_streamData = BgfxUtils::openStreamableImage(m_path.c_str(), *info))) {
+            m_streamInfo = std::move(info);
+            // 在报告屏幕尺寸之前只需要初始精度
+            m_targetMip = getInitialMip();
+            return true;
+        }
+
+        m_image = BgfxUtils::decodeImage(m_path.c_str());
+        return m_image != nullptr;
+    }
+
+    bool TextureResource::upload() {
+        if (isLoaded()) {
+            return true;
+        }
+        if (m_streamData) {
+            // 先上传最低精度的几级，纹理立即可用
+            return createStreamedTexture(std::max(getInitialMip(), m_targetMip));
+        }
+        if (m_image) {
+            m_gpuSize = m_image->m_size;
+            if (!addToAtlas(m_image)) {
+                m_texture = BgfxUtils::createTexture(m_image);
+            }
+            m_image = nullptr;
+        }
+        return isLoaded();
+    }
+
+    bool TextureResource::addToAtlas(bimg::ImageContainer *image) {
+        // 块压缩、带 mip 或多层的纹理保留独立纹理
+        if (!m_atlas || image->m_format != bimg::TextureFormat::RGBA8 || image->m_numMips != 1 ||
+            image->m_numLayers != 1 || image->m_depth != 1 || image->m_cubeMap ||
+            !m_atlas->accepts(static_cast<uint16_t>(image->m_width), static_cast<uint16_t>(image->m_height))) {
+            return false;
+        }
+
+        TextureRegion region;
+        if (!m_atlas->add(static_cast<uint16_t>(image->m_width), static_cast<uint16_t>(image->m_height),
+                          image->m_data, region)) {
+            return false;
+        }
+        bimg::imageFree(image);
+        m_texture.setHandle(BGFX_INVALID_HANDLE);
+        m_region = region;
+        m_inAtlas = true;
+        return true;
+    }
+
+    void TextureResource::removeFromAtlas() {
+        if (m_inAtlas && m_atlas) {
+            m_atlas->remove(m_region);
+        }
+        m_region = {};
+        m_inAtlas = false;
+    }
+
+    size_t TextureResource::getUploadSize() const {
+        if (m_streamData && !isLoaded()) {
+            return BgfxUtils::getMipChainSize(*m_streamInfo, *m_streamData, std::max(getInitialMip(), m_targetMip));
+        }
+        return m_image ? m_image->m_size : 0;
+    }
+
+    size_t TextureResource::stream(const size_t budgetBytes) {
+        if (!m_streamData || !isLoaded()) {
+            return 0;
+        }
+        m_targetMip = m_screenSize.resolve(m_streamInfo->m_width, m_streamInfo->m_height, m_streamInfo->m_numMips,
+                                           m_targetMip);
+        if (m_residentMip == m_targetMip) {
+            return 0;
         }
+
+        const uint8_t mip = TextureStreaming::getNextMip(m_residentMip, m_targetMip);
+        const size_t size = BgfxUtils::getMipChainSize(*m_streamInfo, *m_streamData, mip);
+        if (size > budgetBytes || !createStreamedTexture(mip)) {
+            return 0;
+        }
+        return size;
+    }
+
+    void TextureResource::setTargetMip(const uint8_t mip) {
+        const uint8_t count = getMipCount();
+        m_targetMip = count > 0 ? std::min<uint8_t>(mip, count - 1) : 0;
+    }
+
+    void TextureResource::requestScreenSize(const float screenSize) {
+        if (m_streamInfo) {
+            m_screenSize.report(screenSize);
+        }
+    }
+
+    uint8_t TextureResource::getMipCount() const {
+        return m_streamInfo ? m_streamInfo->m_numMips : 1;
+    }
+
+    uint8_t TextureResource::getInitialMip() const {
+        return TextureStreaming::getInitialMip(m_streamInfo->m_width, m_streamInfo->m_height, m_streamInfo->m_numMips);
+    }
+
+    bool TextureResource::createStreamedTexture(const uint8_t mip) {
+        const bgfx::TextureHandle handle = BgfxUtils::createTexture(*m_streamInfo, *m_streamData, mip);
+        if (!bgfx::isValid(handle)) {
+            return false;
+        }
+        // setHandle 会销毁旧纹理，bgfx 在本帧结束后才真正释放，本帧已提交的绘制不受影响
+        m_texture.setHandle(handle);
+        m_residentMip = mip;
+        m_gpuSize = BgfxUtils::getMipChainSize(*m_streamInfo, *m_streamData, mip);
+        return true;
+    }
+
+    void TextureResource::resetStreaming() {
+        m_streamData.reset();
+        m_streamInfo.reset();
+        m_residentMip = 0;
+        m_targetMip = 0;
+    }
+
+    bool TextureResource::reload() {
+        auto info = createScopePtr<bimg::ImageContainer>();
+        if (auto data = BgfxUtils::openStreamableImage(m_path.c_str(), *info)) {
+            // 保持当前的精度，mip 数变少时截断
+            const uint8_t lastMip = static_cast<uint8_t>(info->m_numMips - 1);
+            const uint8_t residentMip = std::min(m_streamData ? m_residentMip : lastMip, lastMip);
+            const uint8_t targetMip = m_streamData ? std::min(m_targetMip, lastMip)
+                                                   : TextureStreaming::getInitialMip(info->m_width, info->m_height,
+                                                                                     info->m_numMips);
+            const bgfx::TextureHandle handle = BgfxUtils::createTexture(*info, *data, residentMip);
+            if (!bgfx::isValid(handle)) {
+                return false;
+            }
+            m_streamData = std::move(data);
+            m_streamInfo = std::move(info);
+            m_texture.setHandle(handle);
+            removeFromAtlas();
+            m_residentMip = residentMip;
+            m_targetMip = targetMip;
+            m_gpuSize = BgfxUtils::getMipChainSize(*m_streamInfo, *m_streamData, residentMip);
+            return true;
+        }
+
+        bimg::ImageContainer *image = BgfxUtils::decodeImage(m_path.c_str());
+        if (!image) {
+            return false;
+        }
+
+        const size_t size = image->m_size;
+        // 新区域放入成功后才释放原来的区域；图集到 endFrame 时才回收它，本帧已提交的绘制仍然采样旧的像素
+        const bool wasInAtlas = m_inAtlas;
+        const TextureRegion oldRegion = m_region;
+        if (addToAtlas(image)) {
+            if (wasInAtlas) {
+                m_atlas->remove(oldRegion);
+            }
+            m_gpuSize = size;
+            resetStreaming();
+            return true;
+        }
+        const bgfx::TextureHandle handle = BgfxUtils::createTexture(image);
+        if (!bgfx::isValid(handle)) {
+            return false;
+        }
+        // 新纹理创建成功后才替换，setHandle 会销毁旧纹理，期间不会出现无效句柄
+        m_texture.setHandle(handle);
+        m_gpuSize = size;
+        removeFromAtlas();
+        resetStreaming();
         return true;
     }
 
+    ResourceMemoryUsage TextureResource::getMemoryUsage() const {
+        return {getUploadSize(), isLoaded() ? m_gpuSize : 0};
+    }
+
     void TextureResource::unload() {
         if (isLoaded()) {
-            bgfx::destroy(m_texture.getHandle());
-            m_texture = Texture();
+            // setHandle 会销毁旧句柄，这里不能再单独 destroy 一次
+            m_texture.setHandle(BGFX_INVALID_HANDLE);
+            m_gpuSize = 0;
         }
+        removeFromAtlas();
+        resetStreaming();
+        // 图集属于 ResourceManager，可能先于资源对象销毁；卸载后不再引用它
+        m_atlas = nullptr;
     }
 
 
     bool TextureResource::isLoaded() const {
-        return m_texture.isValid();
+        return m_texture.isValid() || m_inAtlas;
+    }
+
+    TextureRegion TextureResource::getRegion() const {
+        if (m_inAtlas) {
+            return m_region;
+        }
+        TextureRegion region;
+        region.texture = m_texture.getHandle();
+        return region;
     }
 
     const Texture & TextureResource::getTexture() const {
@@ -33,7 +238,7 @@ namespace Tina {
     }
 
     TextureHandle TextureResource::getTextureHandle() const {
-        return m_texture.getHandle();
+        return getRegion().texture;
     }
 
 }
@@ -2,9 +2,16 @@
 #define TINA_CORE_TEXTURE_RESOURCE_HPP
 
 #include "Resource.hpp"
+#include "ResourceData.hpp"
+#include "TextureStreaming.hpp"
 #include "graphics/Texture.hpp"
 
+namespace bimg {
+    struct ImageContainer;
+}
+
 namespace Tina {
+    class TextureAtlas;
     
     class TextureResource : public Resource {
     public:
@@ -14,18 +21,70 @@ namespace Tina {
         bool load() override;
         void unload() override;
 
+        bool decode() override;
+        bool upload() override;
+        [[nodiscard]] size_t getUploadSize() const override;
+        [[nodiscard]] ResourceMemoryUsage getMemoryUsage() const override;
+        bool reload() override;
+
+        // 预处理过、带 mip 链的纹理按 mip 流式加载：先上传低精度的几级，之后每帧向目标精度提升一级。
+        // mip 编号越大精度越低，显存中只保留驻留 mip 及更低精度的各级
+        [[nodiscard]] bool isStreamable() const override { return m_streamData != nullptr; }
+        size_t stream(size_t budgetBytes) override;
+
+        // 设置期望的精度，超出 mip 数时截断；降低精度会在下一次 stream 时释放显存。
+        // 流式纹理默认以初始精度（最长边不超过 TextureStreaming::INITIAL_MIP_SIZE 的一级）为目标
+        void setTargetMip(uint8_t mip);
+        // 报告纹理本帧在屏幕上的最长边（像素），Renderer2D 绘制 TextureResource 时自动调用；
+        // 下一次 stream 时按本帧报告的最大尺寸设置期望的精度
+        void requestScreenSize(float screenSize);
+        [[nodiscard]] uint8_t getTargetMip() const { return m_targetMip; }
+        [[nodiscard]] uint8_t getResidentMip() const { return m_residentMip; }
+        [[nodiscard]] uint8_t getMipCount() const;
+
+        // 放入图集的纹理返回所在页的句柄，需要配合 getRegion 中的纹理坐标使用
         [[nodiscard]] TextureHandle getTextureHandle() const;
         [[nodiscard]] bool isLoaded() const override;
+        // 独立的纹理对象，放入图集的纹理没有独立纹理，返回的对象无效
         [[nodiscard]] const Texture& getTexture() const;
+        [[nodiscard]] TextureRegion getRegion() const;
+        [[nodiscard]] bool isInAtlas() const { return m_inAtlas; }
+
+        // 上传时尺寸合适的 RGBA8 纹理放入 atlas，由 ResourceManager 在创建资源时按路径设置；
+        // nullptr 表示总是创建独立纹理。卸载时清空
+        void setAtlas(TextureAtlas* atlas) { m_atlas = atlas; }
 
         static constexpr ResourceType staticResourceType = ResourceType::Texture;
         
     protected:
+        [[nodiscard]] uint8_t getInitialMip() const;
+        bool createStreamedTexture(uint8_t mip);
+        void resetStreaming();
+        // 符合条件时把 image 放入图集并释放它
+        bool addToAtlas(bimg::ImageContainer* image);
+        // 把占用的图集区域还给图集
+        void removeFromAtlas();
+
         Texture m_texture;
+        // decode 的结果，upload 时交给 bgfx
+        bimg::ImageContainer* m_image = nullptr;
+        // 上传到 GPU 的数据大小（含 mip）
+        size_t m_gpuSize = 0;
+
+        // 流式加载时映射的纹理文件及其文件头，各级 mip 直接从映射内存上传
+        ScopePtr<ResourceData> m_streamData;
+        ScopePtr<bimg::ImageContainer> m_streamInfo;
+        uint8_t m_residentMip = 0;
+        uint8_t m_targetMip = 0;
+        TextureStreaming::ScreenSizeTracker m_screenSize;
+
+        TextureAtlas* m_atlas = nullptr;
+        TextureRegion m_region;
+        bool m_inAtlas = false;
     };
     
 }
 
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,75 @@
+#ifndef TINA_CORE_TEXTURE_STREAMING_HPP
+#define TINA_CORE_TEXTURE_STREAMING_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Tina {
+    /**
+     * 纹理按 mip 流式加载时的精度选择。mip 编号越大分辨率越低，驻留 mip 为显存中最高精度的一级，
+     * 它和更低精度的各级都在显存中。
+     */
+    struct TextureStreaming {
+        // 新纹理先上传的最高精度：最长边不超过该值的第一级
+        static constexpr uint32_t INITIAL_MIP_SIZE = 64;
+
+        // 纹理在屏幕上最长边约为 screenSize 像素时需要的 mip，纹理像素与屏幕像素接近一比一即可
+        static uint8_t getMipForScreenSize(uint32_t width, uint32_t height, uint8_t numMips, float screenSize) {
+            if (numMips <= 1) {
+                return 0;
+            }
+            const float size = static_cast<float>(std::max(width, height));
+            if (!(screenSize > 0.0f)) {
+                return static_cast<uint8_t>(numMips - 1);
+            }
+            if (screenSize >= size) {
+                return 0;
+            }
+            const int mip = static_cast<int>(std::floor(std::log2(size / screenSize)));
+            return static_cast<uint8_t>(std::clamp(mip, 0, numMips - 1));
+        }
+
+        static uint8_t getInitialMip(uint32_t width, uint32_t height, uint8_t numMips,
+                                     uint32_t maxSize = INITIAL_MIP_SIZE) {
+            uint8_t mip = 0;
+            while (mip + 1 < numMips && std::max(width >> mip, height >> mip) > maxSize) {
+                ++mip;
+            }
+            return mip;
+        }
+
+        // 从驻留 mip 向目标前进一步：提升精度时每次只增加一级以分散上传量，降低精度时直接到目标，尽快释放显存
+        static uint8_t getNextMip(uint8_t residentMip, uint8_t targetMip) {
+            return targetMip < residentMip ? static_cast<uint8_t>(residentMip - 1) : targetMip;
+        }
+
+        /**
+         * 记录纹理一帧内绘制时的最大屏幕尺寸。resolve 在流式加载前调用，按记录的尺寸给出目标 mip 并清空记录；
+         * 这一帧没有绘制时保持原来的目标，从未报告过尺寸的纹理因此停留在初始精度。
+         */
+        class ScreenSizeTracker {
+        public:
+            void report(float screenSize) {
+                m_maxScreenSize = std::max(m_maxScreenSize, screenSize);
+                m_reported = true;
+            }
+
+            uint8_t resolve(uint32_t width, uint32_t height, uint8_t numMips, uint8_t currentTarget) {
+                if (!m_reported) {
+                    return currentTarget;
+                }
+                const uint8_t mip = getMipForScreenSize(width, height, numMips, m_maxScreenSize);
+                m_maxScreenSize = 0.0f;
+                m_reported = false;
+                return mip;
+            }
+
+        private:
+            float m_maxScreenSize = 0.0f;
+            bool m_reported = false;
+        };
+    };
+}
+
+#endif
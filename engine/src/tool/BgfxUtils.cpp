@@ -1,9 +1,15 @@
 #include "BgfxUtils.hpp"
 
+#include <bx/error.h>
 #include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include <filesystem>
 #include <fstream>
+#include "filesystem/MappedFile.hpp"
+#include "resource/ResourceData.hpp"
 
 
 namespace Tina::BgfxUtils {
@@ -26,7 +32,19 @@ namespace Tina::BgfxUtils {
     }
 
 
+    static void resourceDataReleaseCb(void *_ptr, void *_userData) {
+        BX_UNUSED(_ptr);
+        delete static_cast<ResourceData *>(_userData);
+    }
+
     static const bgfx::Memory *loadMem(bx::FileReaderI *_reader, const bx::FilePath &_filePath) {
+        // 优先映射文件（或资源包）并直接引用映射内存，bgfx 用完后通过回调解除映射，省去一次完整拷贝
+        auto data = ResourceData::open(_filePath.getCPtr(), MappedFile::AccessPattern::WillNeed);
+        if (data && data->size() > 0) {
+            ResourceData *mapped = data.release();
+            return bgfx::makeRef(mapped->data(), static_cast<uint32_t>(mapped->size()), resourceDataReleaseCb, mapped);
+        }
+
         if (bx::open(_reader, _filePath)) {
             const auto size = static_cast<uint32_t>(bx::getSize(_reader));
             const bgfx::Memory *mem = bgfx::alloc(size + 1);
@@ -39,7 +57,7 @@ namespace Tina::BgfxUtils {
     }
 
     static bgfx::ShaderHandle loadShader(bx::FileReaderI *_reader, const bx::StringView &_name) {
-        Path shaderPath = ResourcePath::getShaderPath();
+        Path shaderPath = ResourceDirectory::getShaderPath();
 
         // 根据渲染器类型选择着色器目录
         String rendererDir;
@@ -114,48 +132,189 @@ namespace Tina::BgfxUtils {
         return nullptr;
     }
 
-    bgfx::TextureHandle loadTexture(const char *filepath) {
-        // Opening the file in binary mode
-        std::ifstream file(filepath, std::ios::binary);
+    namespace {
+        // 与 cmake/CompileTextures.cmake 的约定一致：-n 结尾的文件名是法线贴图，不做预乘
+        bool isNormalMap(const std::filesystem::path &path) {
+            const std::string stem = path.stem().string();
+            return stem.size() >= 2 && stem.compare(stem.size() - 2, 2, "-n") == 0;
+        }
 
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file at filepath: " << filepath << std::endl;
+        bool isNewerThan(const std::filesystem::path &path, const std::filesystem::path &other) {
+            std::error_code error;
+            const auto time = std::filesystem::last_write_time(path, error);
+            if (error) {
+                return false;
+            }
+            const auto otherTime = std::filesystem::last_write_time(other, error);
+            return !error && time > otherTime;
+        }
+
+        // 优先打开构建时生成的 .ktx；源文件比它新（例如热重载时刚修改过）时仍使用源文件
+        ScopePtr<ResourceData> openTextureData(const std::string &path, bool &cooked) {
+            const std::string cookedPath = getCookedTexturePath(path);
+            cooked = cookedPath == path;
+            if (!cooked) {
+                auto data = ResourceData::open(cookedPath);
+                if (data && (data->isFromPack() || !isNewerThan(path, cookedPath))) {
+                    cooked = true;
+                    return data;
+                }
+            }
+            return ResourceData::open(path);
+        }
+
+        // 构建时生成的 .ktx/.dds 已经由 texturec --pma 预乘过
+        bool isCookedContainer(const void *data, uint32_t size) {
+            static constexpr uint8_t KTX_MAGIC[] = {0xAB, 'K', 'T', 'X'};
+            static constexpr uint8_t DDS_MAGIC[] = {'D', 'D', 'S', ' '};
+            return size >= 4 && (memcmp(data, KTX_MAGIC, 4) == 0 || memcmp(data, DDS_MAGIC, 4) == 0);
+        }
+
+        // 运行时直接解码源文件时补做预乘，使其与构建时 texturec --pma 的结果一致
+        void premultiplyAlpha(bimg::ImageContainer *image) {
+            if (image->m_format != bimg::TextureFormat::RGBA8 && image->m_format != bimg::TextureFormat::BGRA8) {
+                return;
+            }
+            auto *pixels = static_cast<uint8_t *>(image->m_data);
+            for (uint32_t i = 0; i + 3 < image->m_size; i += 4) {
+                const uint32_t alpha = pixels[i + 3];
+                pixels[i + 0] = static_cast<uint8_t>((pixels[i + 0] * alpha + 127) / 255);
+                pixels[i + 1] = static_cast<uint8_t>((pixels[i + 1] * alpha + 127) / 255);
+                pixels[i + 2] = static_cast<uint8_t>((pixels[i + 2] * alpha + 127) / 255);
+            }
         }
+    }
 
-        // Getting the filesize
-        file.seekg(0, std::ios::end);
-        std::streampos size = file.tellg();
-        file.seekg(0, std::ios::beg);
+    std::string getCookedTexturePath(const std::string &path) {
+        std::filesystem::path cooked(path);
+        const std::string extension = cooked.extension().string();
+        if (extension == COOKED_TEXTURE_EXTENSION || extension == ".dds") {
+            return path;
+        }
+        return cooked.replace_extension(COOKED_TEXTURE_EXTENSION).generic_string();
+    }
 
-        // Storing the data into data
-        char *data = new char[size];
-        file.read(data, size);
+    bimg::ImageContainer *decodeImage(const char *filepath) {
+        bool cooked = false;
+        const auto data = openTextureData(filepath, cooked);
+        if (!data) {
+            std::cerr << "Failed to open file at filepath: " << filepath << std::endl;
+            return nullptr;
+        }
 
-        // Closing the file
-        file.close();
+        // 直接从映射内存（或资源包中的切片）解码
+        return decodeImage(data->data(), static_cast<uint32_t>(data->size()), !isNormalMap(filepath));
+    }
 
-        bx::DefaultAllocator allocator;
-        bimg::ImageContainer *img_container = bimg::imageParse(&allocator, data, size);
+    bimg::ImageContainer *decodeImage(const void *data, uint32_t size, bool premultiply) {
+        bimg::ImageContainer *image = bimg::imageParse(getAllocator(), data, size);
+        if (image && premultiply && !isCookedContainer(data, size)) {
+            premultiplyAlpha(image);
+        }
+        return image;
+    }
 
+    bgfx::TextureHandle createTexture(bimg::ImageContainer *img_container, uint64_t flags) {
         if (img_container == nullptr)
             return BGFX_INVALID_HANDLE;
 
-        const bgfx::Memory *mem = bgfx::makeRef(img_container->m_data, img_container->m_size, 0, img_container);
-        delete[] data;
+        // 解码结果由 imageReleaseCb 在 bgfx 用完后释放，创建纹理后不能再访问 img_container
+        const uint32_t width = img_container->m_width;
+        const uint32_t height = img_container->m_height;
+        const bgfx::Memory *mem = bgfx::makeRef(img_container->m_data, img_container->m_size, imageReleaseCb,
+                                                img_container);
 
         bgfx::TextureHandle handle = bgfx::createTexture2D(static_cast<uint16_t>(img_container->m_width),
                                                            static_cast<uint16_t>(img_container->m_height),
                                                            1 < img_container->m_numMips, img_container->m_numLayers,
                                                            static_cast<bgfx::TextureFormat::Enum>(img_container->
                                                                m_format),
-                                                           BGFX_SAMPLER_U_MIRROR | BGFX_SAMPLER_V_MIRROR, mem
+                                                           flags, mem
         );
 
-        std::cout << "Image width: " << static_cast<uint16_t>(img_container->m_width) <<
-                ", Image height: " << static_cast<uint16_t>(img_container->m_height) << std::endl;
+        spdlog::debug("Created texture {}x{}", width, height);
 
         return handle;
     }
+
+    ScopePtr<ResourceData> openStreamableImage(const char *fileName, bimg::ImageContainer &info) {
+        bool cooked = false;
+        auto data = openTextureData(fileName, cooked);
+        if (!data || !cooked) {
+            return nullptr;
+        }
+        bx::Error error;
+        if (!bimg::imageParse(info, data->data(), static_cast<uint32_t>(data->size()), &error)) {
+            return nullptr;
+        }
+        if (info.m_numMips <= 1 || info.m_numLayers != 1 || info.m_cubeMap || info.m_depth != 1) {
+            return nullptr;
+        }
+        return data;
+    }
+
+    uint32_t getMipChainSize(const bimg::ImageContainer &info, const ResourceData &data, const uint8_t firstMip) {
+        uint32_t size = 0;
+        for (uint8_t lod = firstMip; lod < info.m_numMips; ++lod) {
+            bimg::ImageMip mip;
+            if (bimg::imageGetRawData(info, 0, lod, data.data(), static_cast<uint32_t>(data.size()), mip)) {
+                size += mip.m_size;
+            }
+        }
+        return size;
+    }
+
+    bgfx::TextureHandle createTexture(const bimg::ImageContainer &info, const ResourceData &data,
+                                      const uint8_t firstMip, const uint64_t flags) {
+        if (firstMip >= info.m_numMips) {
+            return BGFX_INVALID_HANDLE;
+        }
+
+        std::vector<bimg::ImageMip> mips(info.m_numMips - firstMip);
+        uint32_t size = 0;
+        for (uint8_t lod = firstMip; lod < info.m_numMips; ++lod) {
+            bimg::ImageMip &mip = mips[lod - firstMip];
+            if (!bimg::imageGetRawData(info, 0, lod, data.data(), static_cast<uint32_t>(data.size()), mip)) {
+                return BGFX_INVALID_HANDLE;
+            }
+            size += mip.m_size;
+        }
+
+        // bgfx 要求各级 mip 从大到小紧密排列，文件中的各级之间可能有头部信息，逐级拷贝
+        const bgfx::Memory *mem = bgfx::alloc(size);
+        uint32_t offset = 0;
+        for (const auto &mip: mips) {
+            memcpy(mem->data + offset, mip.m_data, mip.m_size);
+            offset += mip.m_size;
+        }
+
+        const uint16_t width = static_cast<uint16_t>(mips.front().m_width);
+        const uint16_t height = static_cast<uint16_t>(mips.front().m_height);
+        return bgfx::createTexture2D(width, height, info.m_numMips - firstMip > 1, 1,
+                                     static_cast<bgfx::TextureFormat::Enum>(info.m_format), flags, mem);
+    }
+
+    std::vector<bgfx::TextureHandle> loadTextures(const std::vector<std::string> &fileNames, ThreadPool &pool,
+                                                  const uint64_t flags) {
+        std::vector<std::future<bimg::ImageContainer *>> images;
+        images.reserve(fileNames.size());
+        for (const auto &fileName: fileNames) {
+            // 按值捕获：某个任务抛出异常时 get() 会提前返回，其余任务可能在 fileNames 销毁后才执行
+            images.push_back(pool.submit([fileName]() { return decodeImage(fileName.c_str()); }));
+        }
+
+        // bgfx 的创建调用必须留在渲染线程，按提交顺序逐个等待
+        std::vector<bgfx::TextureHandle> handles;
+        handles.reserve(fileNames.size());
+        for (auto &image: images) {
+            handles.push_back(createTexture(image.get(), flags));
+        }
+        return handles;
+    }
+
+    bgfx::TextureHandle loadTexture(const char *filepath) {
+        return createTexture(decodeImage(filepath), BGFX_SAMPLER_U_MIRROR | BGFX_SAMPLER_V_MIRROR);
+    }
     
 
     void imageReleaseCb(void *_ptr, void *_userData) {
@@ -180,11 +339,20 @@ namespace Tina::BgfxUtils {
                                     uint8_t _skip, bgfx::TextureInfo *_info,
                                     bimg::Orientation::Enum *_orientation) {
         bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
-        uint32_t size;
+        uint32_t size = 0;
 
-        void *data = load(_reader, getAllocator(), _filePath, &size);
-        if (data != nullptr) {
-            bimg::ImageContainer *imageContainer = bimg::imageParse(getAllocator(), data, size);
+        // 映射成功时直接解码映射内存，否则退回到通过 reader 读入
+        const auto mapped = ResourceData::open(_filePath.getCPtr());
+        void *data = nullptr;
+        if (mapped && mapped->size() > 0) {
+            size = static_cast<uint32_t>(mapped->size());
+        } else {
+            data = load(_reader, getAllocator(), _filePath, &size);
+        }
+
+        const void *source = data != nullptr ? data : (mapped ? mapped->data() : nullptr);
+        if (source != nullptr) {
+            bimg::ImageContainer *imageContainer = bimg::imageParse(getAllocator(), source, size);
 
             if (imageContainer != nullptr) {
                 if (_orientation != nullptr) {
@@ -192,7 +360,6 @@ namespace Tina::BgfxUtils {
                 }
                 const bgfx::Memory *mem = bgfx::makeRef(imageContainer->m_data, imageContainer->m_size, imageReleaseCb,
                                                         imageContainer);
-                unLoad(data);
 
                 if (imageContainer->m_cubeMap) {
                     handle = bgfx::createTextureCube(static_cast<uint16_t>(imageContainer->m_width),
@@ -230,6 +397,9 @@ namespace Tina::BgfxUtils {
                 }
             }
         }
+        if (data != nullptr) {
+            unLoad(data);
+        }
         return handle;
     }
 
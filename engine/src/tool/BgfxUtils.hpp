@@ -11,7 +11,11 @@
 #include <bx/pixelformat.h>
 #include <bx/filepath.h>
 #include <bimg/decode.h>
-#include "filesystem/ResourcePath.hpp"
+#include "filesystem/ResourceDirectory.hpp"
+#include "core/ThreadPool.hpp"
+#include "resource/ResourceData.hpp"
+#include <string>
+#include <vector>
 
 namespace Tina::BgfxUtils {
     static bx::StringView s_currentDir = "./";
@@ -40,6 +44,40 @@ namespace Tina::BgfxUtils {
                                     uint8_t _skip = 0, bgfx::TextureInfo *_info= nullptr, bimg::Orientation::Enum *_orientation = nullptr);
 
     bgfx::TextureHandle loadTexture(const char* fileName);
+
+    // 构建时由 cmake/CompileTextures.cmake 生成的纹理格式（mip 链、预乘 alpha、可选的 BC 压缩）
+    constexpr const char* COOKED_TEXTURE_EXTENSION = ".ktx";
+
+    // 源图片对应的预处理纹理路径，即同目录下扩展名换为 .ktx 的文件
+    std::string getCookedTexturePath(const std::string &path);
+
+    // 读取并解码图片，不调用 bgfx，可以在工作线程执行；失败返回 nullptr
+    // 存在预处理过的 .ktx 时优先使用它，否则解码源图片并预乘 alpha；已挂载的资源包中有该文件时直接从包中读取
+    bimg::ImageContainer *decodeImage(const char* fileName);
+
+    // 解码内存中的图片文件数据，解码结果不引用 data。
+    // 引擎中所有纹理都使用预乘 alpha：源图片在这里预乘，.ktx/.dds 视为构建时已预乘；法线贴图等非颜色数据传 premultiply = false
+    bimg::ImageContainer *decodeImage(const void* data, uint32_t size, bool premultiply = true);
+
+    // 在渲染线程用解码结果创建 2D 纹理，imageContainer 的所有权转交给 bgfx，用完后自动释放
+    bgfx::TextureHandle createTexture(bimg::ImageContainer *imageContainer,
+                                      uint64_t flags = BGFX_SAMPLER_U_MIRROR | BGFX_SAMPLER_V_MIRROR);
+
+    // 打开可以按 mip 流式上传的纹理：预处理过、带 mip 链的单层 2D 纹理。只解析文件头，info 不含像素数据，
+    // 各级 mip 直接从返回的（映射的）文件数据中读取；不满足条件时返回 nullptr
+    ScopePtr<ResourceData> openStreamableImage(const char* fileName, bimg::ImageContainer &info);
+
+    // firstMip 及更低精度的各级 mip 的总字节数
+    uint32_t getMipChainSize(const bimg::ImageContainer &info, const ResourceData &data, uint8_t firstMip);
+
+    // 只用 firstMip 及更低精度的各级 mip 创建纹理，纹理尺寸为 firstMip 的尺寸
+    bgfx::TextureHandle createTexture(const bimg::ImageContainer &info, const ResourceData &data, uint8_t firstMip,
+                                      uint64_t flags = BGFX_SAMPLER_U_MIRROR | BGFX_SAMPLER_V_MIRROR);
+
+    // 在 pool 中并行解码所有图片，再按 fileNames 的顺序在调用线程（渲染线程）创建纹理，
+    // 前面的纹理创建时后面的图片仍在解码。返回值与 fileNames 一一对应，失败的位置为无效句柄
+    std::vector<bgfx::TextureHandle> loadTextures(const std::vector<std::string> &fileNames, ThreadPool &pool,
+                                                  uint64_t flags = BGFX_SAMPLER_U_MIRROR | BGFX_SAMPLER_V_MIRROR);
     
 }
 
@@ -0,0 +1,135 @@
+//
+// Created by wuxianggujun on 2024/7/29.
+//
+
+#include "Endianness.hpp"
+#include "base/CpuFeatures.hpp"
+
+#if TINA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace Tina::Tool
+{
+    namespace
+    {
+        using SwapFunction = void (*)(const uint8_t*, uint8_t*, size_t);
+
+        template <typename T>
+        void swapScalar(const uint8_t* src, uint8_t* dest, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                T value;
+                memcpy(&value, src + i * sizeof(T), sizeof(T));
+                value = ByteSwap(value);
+                memcpy(dest + i * sizeof(T), &value, sizeof(T));
+            }
+        }
+
+#if TINA_SIMD_X86
+        // pshufb 的字节重排表：每个元素内部的字节倒序
+        template <size_t Size>
+        struct ShuffleMask;
+
+        template <>
+        struct ShuffleMask<2>
+        {
+            static constexpr int8_t bytes[16] = {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+        };
+
+        template <>
+        struct ShuffleMask<4>
+        {
+            static constexpr int8_t bytes[16] = {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+        };
+
+        template <>
+        struct ShuffleMask<8>
+        {
+            static constexpr int8_t bytes[16] = {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8};
+        };
+
+        template <typename T>
+        TINA_TARGET_SSSE3 void swapSSSE3(const uint8_t* src, uint8_t* dest, size_t count)
+        {
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ShuffleMask<sizeof(T)>::bytes));
+            const size_t bytes = count * sizeof(T);
+            size_t i = 0;
+            for (; i + 16 <= bytes; i += 16)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_shuffle_epi8(block, mask));
+            }
+            swapScalar<T>(src + i, dest + i, (bytes - i) / sizeof(T));
+        }
+
+        template <typename T>
+        TINA_TARGET_AVX2 void swapAVX2(const uint8_t* src, uint8_t* dest, size_t count)
+        {
+            // vpshufb 在每个 128 位通道内独立重排，两个通道使用同一张表
+            const __m128i lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ShuffleMask<sizeof(T)>::bytes));
+            const __m256i mask = _mm256_broadcastsi128_si256(lane);
+            const size_t bytes = count * sizeof(T);
+            size_t i = 0;
+            for (; i + 64 <= bytes; i += 64)
+            {
+                const __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                const __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_shuffle_epi8(block0, mask));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 32), _mm256_shuffle_epi8(block1, mask));
+            }
+            for (; i + 32 <= bytes; i += 32)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_shuffle_epi8(block, mask));
+            }
+            // 剩余不足 32 字节时用 VEX 编码的 128 位指令收尾，避免切换到非 VEX 的 SSE 代码
+            for (; i + 16 <= bytes; i += 16)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_shuffle_epi8(block, lane));
+            }
+            swapScalar<T>(src + i, dest + i, (bytes - i) / sizeof(T));
+        }
+#endif
+
+        template <typename T>
+        SwapFunction selectSwap()
+        {
+#if TINA_SIMD_X86
+            if (CpuFeatures::hasAVX2())
+            {
+                return swapAVX2<T>;
+            }
+            if (CpuFeatures::hasSSSE3())
+            {
+                return swapSSSE3<T>;
+            }
+#endif
+            return swapScalar<T>;
+        }
+
+        template <typename T>
+        void swapArray(const void* src, void* dest, size_t count)
+        {
+            static const SwapFunction swap = selectSwap<T>();
+            swap(static_cast<const uint8_t*>(src), static_cast<uint8_t*>(dest), count);
+        }
+    }
+
+    void ByteSwapArray16(const void* src, void* dest, size_t count)
+    {
+        swapArray<uint16_t>(src, dest, count);
+    }
+
+    void ByteSwapArray32(const void* src, void* dest, size_t count)
+    {
+        swapArray<uint32_t>(src, dest, count);
+    }
+
+    void ByteSwapArray64(const void* src, void* dest, size_t count)
+    {
+        swapArray<uint64_t>(src, dest, count);
+    }
+}
@@ -5,35 +5,145 @@
 #ifndef TINA_TOOL_ENDIANNESS_HPP
 #define TINA_TOOL_ENDIANNESS_HPP
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <stdlib.h>
+#endif
+
 namespace Tina::Tool
 {
-    /*inline uint32_t EndianConvert(uint32_t value)
+    // 编译期判断主机字节序
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+    inline constexpr bool IS_LITTLE_ENDIAN = __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__;
+#else
+    // MSVC 支持的平台都是小端
+    inline constexpr bool IS_LITTLE_ENDIAN = true;
+#endif
+
+    inline uint16_t ByteSwap(uint16_t value)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return _byteswap_ushort(value);
+#else
+        return __builtin_bswap16(value);
+#endif
+    }
+
+    inline uint32_t ByteSwap(uint32_t value)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return _byteswap_ulong(value);
+#else
+        return __builtin_bswap32(value);
+#endif
+    }
+
+    inline uint64_t ByteSwap(uint64_t value)
     {
-        auto np = reinterpret_cast<unsigned char*>(&value);
+#if defined(_MSC_VER) && !defined(__clang__)
+        return _byteswap_uint64(value);
+#else
+        return __builtin_bswap64(value);
+#endif
+    }
 
-        return (static_cast<uint32_t>(np[0]) << 24) |
-            (static_cast<uint32_t>(np[1]) << 16) |
-            (static_cast<uint32_t>(np[2]) << 8) |
-            static_cast<uint32_t>(np[3]);
-    }*/
-    
+    // 反转 value 的字节顺序
     template <typename T>
     inline T EndianConvert(const T& value)
     {
         static_assert(std::is_fundamental_v<T>, "EndianConvert supports only fundamental types.");
-        T result;
-        memcpy(&result, reinterpret_cast<const uint8_t*>(&value), sizeof(value));
-        for (size_t i = 0; i < sizeof(T); ++i)
+        if constexpr (sizeof(T) == 1)
+        {
+            return value;
+        }
+        else if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+        {
+            using Bits = std::conditional_t<sizeof(T) == 2, uint16_t,
+                                            std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+            Bits bits;
+            memcpy(&bits, &value, sizeof(T));
+            bits = ByteSwap(bits);
+            T result;
+            memcpy(&result, &bits, sizeof(T));
+            return result;
+        }
+        else
+        {
+            T result;
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                reinterpret_cast<uint8_t*>(&result)[i] = reinterpret_cast<const uint8_t*>(&value)[sizeof(T) - 1 - i];
+            }
+            return result;
+        }
+    }
+
+    // 批量反转字节顺序的底层实现，src/dest 可以不对齐，也可以相同（原地转换）
+    void ByteSwapArray16(const void* src, void* dest, size_t count);
+    void ByteSwapArray32(const void* src, void* dest, size_t count);
+    void ByteSwapArray64(const void* src, void* dest, size_t count);
+
+    // 批量转换 count 个元素，从 src 写入 dest；x86 上按 CPU 支持情况使用 SSSE3/AVX2 的 pshufb
+    template <typename T>
+    inline void EndianConvert(const T* src, T* dest, size_t count)
+    {
+        static_assert(std::is_fundamental_v<T>, "EndianConvert supports only fundamental types.");
+        if constexpr (sizeof(T) == 1)
+        {
+            if (src != dest)
+            {
+                memmove(dest, src, count);
+            }
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            ByteSwapArray16(src, dest, count);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            ByteSwapArray32(src, dest, count);
+        }
+        else if constexpr (sizeof(T) == 8)
+        {
+            ByteSwapArray64(src, dest, count);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                dest[i] = EndianConvert(src[i]);
+            }
+        }
+    }
+
+    // 原地批量转换
+    template <typename T>
+    inline void EndianConvert(T* data, size_t count)
+    {
+        EndianConvert(static_cast<const T*>(data), data, count);
+    }
+
+    // 大端数据与主机字节序之间的转换，大端主机上不做任何处理
+    template <typename T>
+    inline void BigEndianToHost(T* data, size_t count)
+    {
+        if constexpr (IS_LITTLE_ENDIAN)
+        {
+            EndianConvert(data, count);
+        }
+    }
+
+    template <typename T>
+    inline void LittleEndianToHost(T* data, size_t count)
+    {
+        if constexpr (!IS_LITTLE_ENDIAN)
         {
-            reinterpret_cast<uint8_t*>(&result)[i] = reinterpret_cast<const uint8_t*>(&value)[sizeof(T) - 1 - i];
+            EndianConvert(data, count);
         }
-        return result;
     }
-    
-    
 }
 
 
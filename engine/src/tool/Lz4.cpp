@@ -0,0 +1,220 @@
+#include "Lz4.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Tina::Tool
+{
+    namespace
+    {
+        constexpr size_t MIN_MATCH = 4;
+        // 格式要求：最后 5 个字节必须是字面量，最后一个匹配至少在结尾前 12 字节开始
+        constexpr size_t LAST_LITERALS = 5;
+        constexpr size_t MF_LIMIT = 12;
+        constexpr size_t MAX_OFFSET = 65535;
+        constexpr uint32_t HASH_BITS = 16;
+
+        uint32_t read32(const uint8_t* p)
+        {
+            uint32_t value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        uint32_t hash(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - HASH_BITS);
+        }
+
+        // 长度字段超过 15 时的扩展字节：连续的 255 加上最后一个余数
+        uint8_t* writeLength(uint8_t* op, size_t length)
+        {
+            for (; length >= 255; length -= 255)
+            {
+                *op++ = 255;
+            }
+            *op++ = static_cast<uint8_t>(length);
+            return op;
+        }
+
+        bool readLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+        {
+            uint8_t byte;
+            do
+            {
+                if (ip >= end)
+                {
+                    return false;
+                }
+                byte = *ip++;
+                length += byte;
+            }
+            while (byte == 255);
+            return true;
+        }
+
+        // 写出一个序列：literalLength 个字面量，随后是 offset/matchLength 描述的匹配（matchLength 为 0 表示最后的字面量）
+        uint8_t* writeSequence(uint8_t* op, const uint8_t* opEnd, const uint8_t* literals, size_t literalLength,
+                               size_t offset, size_t matchLength)
+        {
+            const size_t worst = 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1;
+            if (static_cast<size_t>(opEnd - op) < worst)
+            {
+                return nullptr;
+            }
+
+            uint8_t* token = op++;
+            *token = static_cast<uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4);
+            if (literalLength >= 15)
+            {
+                op = writeLength(op, literalLength - 15);
+            }
+            // 空输入时 literals 可能为空指针，长度为 0 也不能传给 memcpy
+            if (literalLength)
+            {
+                memcpy(op, literals, literalLength);
+                op += literalLength;
+            }
+
+            if (matchLength == 0)
+            {
+                return op;
+            }
+
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            const size_t extra = matchLength - MIN_MATCH;
+            *token |= static_cast<uint8_t>(extra >= 15 ? 15 : extra);
+            if (extra >= 15)
+            {
+                op = writeLength(op, extra - 15);
+            }
+            return op;
+        }
+    }
+
+    size_t Lz4Compress(const void* src, size_t size, void* dest, size_t capacity)
+    {
+        const auto* in = static_cast<const uint8_t*>(src);
+        auto* out = static_cast<uint8_t*>(dest);
+        const uint8_t* outEnd = out + capacity;
+        uint8_t* op = out;
+        size_t anchor = 0;
+
+        if (size > MF_LIMIT)
+        {
+            // 记录每个 4 字节序列最近出现的位置 + 1，0 表示没有
+            std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+            const size_t matchLimit = size - LAST_LITERALS;
+            const size_t inputLimit = size - MF_LIMIT;
+
+            size_t ip = 0;
+            while (ip < inputLimit)
+            {
+                const uint32_t sequence = read32(in + ip);
+                uint32_t& slot = table[hash(sequence)];
+                const size_t candidate = slot;
+                slot = static_cast<uint32_t>(ip + 1);
+
+                if (candidate == 0 || ip - (candidate - 1) > MAX_OFFSET || read32(in + candidate - 1) != sequence)
+                {
+                    ++ip;
+                    continue;
+                }
+
+                const size_t ref = candidate - 1;
+                size_t length = MIN_MATCH;
+                while (ip + length < matchLimit && in[ref + length] == in[ip + length])
+                {
+                    ++length;
+                }
+
+                op = writeSequence(op, outEnd, in + anchor, ip - anchor, ip - ref, length);
+                if (!op)
+                {
+                    return 0;
+                }
+                ip += length;
+                anchor = ip;
+            }
+        }
+
+        op = writeSequence(op, outEnd, in + anchor, size - anchor, 0, 0);
+        return op ? static_cast<size_t>(op - out) : 0;
+    }
+
+    bool Lz4Decompress(const void* src, size_t size, void* dest, size_t destSize)
+    {
+        const auto* ip = static_cast<const uint8_t*>(src);
+        const uint8_t* const end = ip + size;
+        auto* const out = static_cast<uint8_t*>(dest);
+        uint8_t* op = out;
+        uint8_t* const outEnd = out + destSize;
+
+        while (ip < end)
+        {
+            const uint8_t token = *ip++;
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !readLength(ip, end, literalLength))
+            {
+                return false;
+            }
+            if (literalLength > static_cast<size_t>(end - ip) || literalLength > static_cast<size_t>(outEnd - op))
+            {
+                return false;
+            }
+            if (literalLength)
+            {
+                memcpy(op, ip, literalLength);
+                ip += literalLength;
+                op += literalLength;
+            }
+
+            // 最后一个序列只有字面量
+            if (ip == end)
+            {
+                break;
+            }
+
+            if (end - ip < 2)
+            {
+                return false;
+            }
+            const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - out))
+            {
+                return false;
+            }
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !readLength(ip, end, matchLength))
+            {
+                return false;
+            }
+            matchLength += MIN_MATCH;
+            if (matchLength > static_cast<size_t>(outEnd - op))
+            {
+                return false;
+            }
+
+            const uint8_t* match = op - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(op, match, matchLength);
+                op += matchLength;
+            }
+            else
+            {
+                // 重叠拷贝用于表示重复的短模式，必须逐字节进行
+                for (size_t i = 0; i < matchLength; ++i)
+                {
+                    *op++ = match[i];
+                }
+            }
+        }
+        return op == outEnd;
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef TINA_TOOL_LZ4_HPP
+#define TINA_TOOL_LZ4_HPP
+
+#include <cstddef>
+
+namespace Tina::Tool
+{
+    // LZ4 块格式（不含帧头）的压缩与解压，输出与官方 LZ4_compress_default/LZ4_decompress_safe 互通
+
+    // 压缩 size 字节时输出缓冲区所需的最大长度
+    inline size_t Lz4CompressBound(size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    // 返回压缩后的字节数，dest 容量不足时返回 0
+    size_t Lz4Compress(const void* src, size_t size, void* dest, size_t capacity);
+
+    // 解压到 dest，解压结果必须恰好是 destSize 字节；数据损坏或越界时返回 false
+    bool Lz4Decompress(const void* src, size_t size, void* dest, size_t destSize);
+}
+
+#endif //TINA_TOOL_LZ4_HPP
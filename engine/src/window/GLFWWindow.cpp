@@ -6,6 +6,7 @@
 #include <fmt/printf.h>
 
 #include "EventHandler.hpp"
+#include "graphics/SpriteBatch.hpp"
 
 namespace Tina {
     GLFWWindow::GLFWWindow() : m_window(nullptr, GlfwWindowDeleter()) {
@@ -56,6 +57,9 @@ namespace Tina {
         bgfxInit.resolution.height = m_windowSize.height;
         bgfxInit.resolution.reset = BGFX_RESET_VSYNC;
         bgfxInit.callback = &m_bgfxCallback;
+        // 默认的 transient 缓冲区只够几万个精灵，保留默认大小给其他使用者，再加上 Renderer2D 每帧所需的部分
+        bgfxInit.limits.transientVbSize += SpriteBatch::TRANSIENT_VERTEX_BUFFER_SIZE;
+        bgfxInit.limits.transientIbSize += SpriteBatch::TRANSIENT_INDEX_BUFFER_SIZE;
 
         bgfxInit.platformData.nwh = glfwNativeWindowHandle(m_window.get());
         bgfxInit.platformData.ndt = getNativeDisplayHandle();
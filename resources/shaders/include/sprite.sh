@@ -0,0 +1,42 @@
+#ifndef SPRITE_SH
+#define SPRITE_SH
+
+// sprite 与 sprite_instanced 共用的片元逻辑，槽位与 SpriteBatch::MAX_TEXTURE_STAGES 一致
+SAMPLER2D(s_texColor, 0);
+SAMPLER2D(s_texColor1, 1);
+SAMPLER2D(s_texColor2, 2);
+SAMPLER2D(s_texColor3, 3);
+SAMPLER2D(s_texColor4, 4);
+SAMPLER2D(s_texColor5, 5);
+SAMPLER2D(s_texColor6, 6);
+SAMPLER2D(s_texColor7, 7);
+
+// GLSL 120 不能用变量索引采样器，按槽位逐个比较；同一个四边形的槽位相同
+vec4 sampleStage(float stage, vec2 texcoord)
+{
+    if (stage < 0.5) return texture2D(s_texColor, texcoord);
+    if (stage < 1.5) return texture2D(s_texColor1, texcoord);
+    if (stage < 2.5) return texture2D(s_texColor2, texcoord);
+    if (stage < 3.5) return texture2D(s_texColor3, texcoord);
+    if (stage < 4.5) return texture2D(s_texColor4, texcoord);
+    if (stage < 5.5) return texture2D(s_texColor5, texcoord);
+    if (stage < 6.5) return texture2D(s_texColor6, texcoord);
+    if (stage < 7.5) return texture2D(s_texColor7, texcoord);
+    // 没有纹理的精灵（SpriteBatch::NO_TEXTURE_STAGE）
+    return vec4_splat(0.0);
+}
+
+vec4 spriteColor(vec4 vertexColor, vec2 texcoord, float stage)
+{
+    // 纹理在构建或加载时已预乘 alpha，顶点颜色在这里预乘，与 ONE/INV_SRC_ALPHA 混合配合
+    vec4 color = vec4(vertexColor.rgb * vertexColor.a, vertexColor.a);
+
+    // 采样顶点指定槽位的纹理
+    vec4 texColor = sampleStage(stage, texcoord);
+
+    // 如果纹理的alpha值为0（表示没有有效纹理），使用顶点颜色
+    // 否则使用纹理颜色
+    return (texColor.a == 0.0) ? color : texColor;
+}
+
+#endif // SPRITE_SH
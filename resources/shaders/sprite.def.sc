@@ -1,6 +1,8 @@
 vec4 v_color0    : COLOR0    = vec4(1.0, 0.0, 0.0, 1.0);
 vec2 v_texcoord0 : TEXCOORD0 = vec2(0.0, 0.0);
+float v_texstage : TEXCOORD1 = 0.0;
 
 vec3 a_position  : POSITION;
 vec4 a_color0    : COLOR0;
-vec2 a_texcoord0 : TEXCOORD0;
\ No newline at end of file
+vec2 a_texcoord0 : TEXCOORD0;
+float a_texcoord1 : TEXCOORD1;
\ No newline at end of file
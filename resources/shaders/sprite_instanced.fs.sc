@@ -0,0 +1,9 @@
+$input v_color0, v_texcoord0, v_texstage
+
+#include <bgfx_shader.sh>
+#include "./include/sprite.sh"
+
+void main()
+{
+    gl_FragColor = spriteColor(v_color0, v_texcoord0, v_texstage);
+}
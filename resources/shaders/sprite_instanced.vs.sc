@@ -0,0 +1,30 @@
+$input a_position, i_data0, i_data1, i_data2
+$output v_color0, v_texcoord0, v_texstage
+
+#include <bgfx_shader.sh>
+
+// 单位四边形按实例数据展开：i_data0 为位置和尺寸，i_data1 为纹理坐标矩形，
+// i_data2.xy 为合成的顶点颜色，i_data2.z 为绕中心旋转的弧度（与 SpriteBatch::writeVertices 一致），i_data2.w 为纹理槽位
+
+// 拆开 SpriteInstance 中的颜色：每个分量是 0 ~ 65535 的整数，低 8 位和高 8 位各为一个通道。
+// 除以 256 和取整对这个范围内的整数都是精确的
+vec4 unpackColor(vec2 color)
+{
+    vec2 high = floor(color / 256.0);
+    vec2 low = color - high * 256.0;
+    return vec4(low.x, high.x, low.y, high.y) / 255.0;
+}
+
+void main()
+{
+    vec2 halfSize = i_data0.zw * 0.5;
+    vec2 local = (a_position - vec2(0.5, 0.5)) * i_data0.zw;
+    float s = sin(i_data2.z);
+    float c = cos(i_data2.z);
+    vec2 rotated = vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    gl_Position = mul(u_modelViewProj, vec4(i_data0.xy + halfSize + rotated, 0.0, 1.0));
+    v_color0 = unpackColor(i_data2.xy);
+    v_texcoord0 = mix(i_data1.xy, i_data1.zw, a_position);
+    v_texstage = i_data2.w;
+}
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "filesystem/ByteView.hpp"
+#include "tool/Endianness.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    // 模拟读取大端高度图：逐个元素读取与批量读取对比
+    std::vector<uint8_t> makeHeightmap(size_t count)
+    {
+        std::vector<uint8_t> bytes(count * sizeof(float));
+        for (size_t i = 0; i < bytes.size(); ++i)
+        {
+            bytes[i] = static_cast<uint8_t>(i * 31);
+        }
+        return bytes;
+    }
+
+    void BM_ReadFloatsPerElement(benchmark::State& state)
+    {
+        const auto bytes = makeHeightmap(static_cast<size_t>(state.range(0)));
+        std::vector<float> heights(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            ByteView view(bytes);
+            for (float& height : heights)
+            {
+                height = view.read<float>();
+            }
+            benchmark::DoNotOptimize(heights.data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+    }
+
+    void BM_ReadFloatsBulk(benchmark::State& state)
+    {
+        const auto bytes = makeHeightmap(static_cast<size_t>(state.range(0)));
+        std::vector<float> heights(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            ByteView view(bytes);
+            view.read(heights.data(), heights.size());
+            benchmark::DoNotOptimize(heights.data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+    }
+
+    void BM_ConvertInPlace16(benchmark::State& state)
+    {
+        std::vector<uint16_t> indices(static_cast<size_t>(state.range(0)), 0x1234);
+        for (auto _ : state)
+        {
+            Tool::EndianConvert(indices.data(), indices.size());
+            benchmark::DoNotOptimize(indices.data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * indices.size() * sizeof(uint16_t)));
+    }
+}
+
+BENCHMARK(BM_ReadFloatsPerElement)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_ReadFloatsBulk)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_ConvertInPlace16)->Arg(1024)->Arg(1 << 20);
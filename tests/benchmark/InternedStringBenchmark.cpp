@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "base/InternedString.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    // 模拟资源路径：公共前缀较长，比较时需要扫描到末尾才能区分
+    std::vector<std::string> makePaths(size_t count)
+    {
+        std::vector<std::string> paths;
+        paths.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            paths.push_back("resources/textures/characters/player/animation_" + std::to_string(i) + ".png");
+        }
+        return paths;
+    }
+
+    void BM_StdStringMapLookup(benchmark::State& state)
+    {
+        const auto paths = makePaths(static_cast<size_t>(state.range(0)));
+        std::unordered_map<std::string, int> table;
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            table.emplace(paths[i], static_cast<int>(i));
+        }
+
+        for (auto _ : state)
+        {
+            int sum = 0;
+            for (const auto& path : paths)
+            {
+                sum += table.find(path)->second;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * paths.size()));
+    }
+
+    void BM_InternedStringMapLookup(benchmark::State& state)
+    {
+        const auto paths = makePaths(static_cast<size_t>(state.range(0)));
+        std::vector<InternedString> keys;
+        std::unordered_map<InternedString, int> table;
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            keys.emplace_back(paths[i]);
+            table.emplace(keys.back(), static_cast<int>(i));
+        }
+
+        for (auto _ : state)
+        {
+            int sum = 0;
+            for (const auto& key : keys)
+            {
+                sum += table.find(key)->second;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+    }
+
+    void BM_StdStringEquality(benchmark::State& state)
+    {
+        const auto paths = makePaths(2);
+        const std::string a = paths[0];
+        const std::string b = paths[0];
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a == b);
+        }
+    }
+
+    void BM_InternedStringEquality(benchmark::State& state)
+    {
+        const auto paths = makePaths(2);
+        const InternedString a(paths[0]);
+        const InternedString b(paths[0]);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a == b);
+        }
+    }
+
+    // 驻留本身的开销（已驻留字符串的再次查找），只在从外部输入构造键时付出一次
+    void BM_InternExisting(benchmark::State& state)
+    {
+        const auto paths = makePaths(static_cast<size_t>(state.range(0)));
+        for (const auto& path : paths)
+        {
+            InternedString interned(path);
+            benchmark::DoNotOptimize(interned);
+        }
+
+        for (auto _ : state)
+        {
+            for (const auto& path : paths)
+            {
+                InternedString interned(path);
+                benchmark::DoNotOptimize(interned);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * paths.size()));
+    }
+}
+
+BENCHMARK(BM_StdStringMapLookup)->Arg(64)->Arg(1024);
+BENCHMARK(BM_InternedStringMapLookup)->Arg(64)->Arg(1024);
+BENCHMARK(BM_StdStringEquality);
+BENCHMARK(BM_InternedStringEquality);
+BENCHMARK(BM_InternExisting)->Arg(64)->Arg(1024);
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+#include <list>
+#include <memory>
+#include <vector>
+#include "memory/MemoryPool.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    struct Payload
+    {
+        float position[3];
+        float velocity[3];
+        uint32_t flags;
+    };
+
+    // 一帧内创建再销毁一批对象，模拟组件/事件的生命周期
+    void BM_NewDelete(benchmark::State& state)
+    {
+        const auto count = static_cast<size_t>(state.range(0));
+        std::vector<Payload*> objects(count);
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                objects[i] = new Payload();
+            }
+            benchmark::DoNotOptimize(objects.data());
+            for (size_t i = 0; i < count; ++i)
+            {
+                delete objects[i];
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    }
+
+    void BM_StdAllocator(benchmark::State& state)
+    {
+        const auto count = static_cast<size_t>(state.range(0));
+        std::allocator<Payload> allocator;
+        std::vector<Payload*> objects(count);
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                objects[i] = allocator.allocate(1);
+            }
+            benchmark::DoNotOptimize(objects.data());
+            for (size_t i = 0; i < count; ++i)
+            {
+                allocator.deallocate(objects[i], 1);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    }
+
+    void BM_MemoryPool(benchmark::State& state)
+    {
+        const auto count = static_cast<size_t>(state.range(0));
+        MemoryPool<Payload> pool;
+        std::vector<Payload*> objects(count);
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                objects[i] = pool.allocate();
+            }
+            benchmark::DoNotOptimize(objects.data());
+            for (size_t i = 0; i < count; ++i)
+            {
+                pool.deallocate(objects[i]);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    }
+
+    void BM_ListStdAllocator(benchmark::State& state)
+    {
+        const auto count = static_cast<int>(state.range(0));
+        for (auto _ : state)
+        {
+            std::list<int> values;
+            for (int i = 0; i < count; ++i)
+            {
+                values.push_back(i);
+            }
+            benchmark::DoNotOptimize(values);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    void BM_ListPoolAllocator(benchmark::State& state)
+    {
+        const auto count = static_cast<int>(state.range(0));
+        for (auto _ : state)
+        {
+            std::list<int, PoolAllocator<int>> values;
+            for (int i = 0; i < count; ++i)
+            {
+                values.push_back(i);
+            }
+            benchmark::DoNotOptimize(values);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+}
+
+BENCHMARK(BM_NewDelete)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_StdAllocator)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_MemoryPool)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_ListStdAllocator)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_ListPoolAllocator)->Arg(1 << 10)->Arg(1 << 16);
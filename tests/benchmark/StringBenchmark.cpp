@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include "base/String.hpp"
+#include "base/StringSearch.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    // 参数 0/1/2 分别对应 Scalar/SSE2/AVX2，超出 CPU 支持的级别会被降级并在标签中注明
+    bool selectLevel(benchmark::State& state)
+    {
+        const auto requested = static_cast<StringSearch::SimdLevel>(state.range(0));
+        StringSearch::setSimdLevel(requested);
+        if (StringSearch::getSimdLevel() != requested)
+        {
+            state.SkipWithError("SIMD level not supported on this CPU");
+            return false;
+        }
+        static const char* names[] = {"scalar", "sse2", "avx2"};
+        state.SetLabel(names[state.range(0)]);
+        return true;
+    }
+
+    // 长路径：前面是重复的目录名，子串的首字节会频繁命中，真正的目标位于末尾
+    String makeLongPath(size_t length)
+    {
+        std::string path;
+        while (path.size() < length)
+        {
+            path += "resources/textures/characters/";
+        }
+        path.resize(length);
+        path += "#characters/player.png";
+        return String(path);
+    }
+
+    // 基线：String 原先基于 strstr 的查找
+    size_t strstrFind(const String& str, const char* needle)
+    {
+        const char* found = std::strstr(str.c_str(), needle);
+        return found ? static_cast<size_t>(found - str.c_str()) : String::npos;
+    }
+
+    void BM_FindChar(benchmark::State& state)
+    {
+        if (!selectLevel(state)) return;
+        const String path = makeLongPath(static_cast<size_t>(state.range(1)));
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(path.find('#'));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * path.size()));
+    }
+
+    void BM_RFindChar(benchmark::State& state)
+    {
+        if (!selectLevel(state)) return;
+        String path = makeLongPath(static_cast<size_t>(state.range(1)));
+        path.insert(0, ".");
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(path.rfind('.', path.size() - 6));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * path.size()));
+    }
+
+    void BM_FindSubstring(benchmark::State& state)
+    {
+        if (!selectLevel(state)) return;
+        const String path = makeLongPath(static_cast<size_t>(state.range(1)));
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(path.find("characters/player"));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * path.size()));
+    }
+
+    void BM_FindSubstringStrstr(benchmark::State& state)
+    {
+        const String path = makeLongPath(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(strstrFind(path, "characters/player"));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * path.size()));
+    }
+
+    void BM_Equality(benchmark::State& state)
+    {
+        if (!selectLevel(state)) return;
+        const String a = makeLongPath(static_cast<size_t>(state.range(1)));
+        const String b = makeLongPath(static_cast<size_t>(state.range(1)));
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a == b);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * a.size()));
+    }
+}
+
+BENCHMARK(BM_FindChar)->ArgsProduct({{0, 1, 2}, {64, 4096}});
+BENCHMARK(BM_RFindChar)->ArgsProduct({{0, 1, 2}, {64, 4096}});
+BENCHMARK(BM_FindSubstring)->ArgsProduct({{0, 1, 2}, {64, 4096}});
+BENCHMARK(BM_FindSubstringStrstr)->Arg(64)->Arg(4096);
+BENCHMARK(BM_Equality)->ArgsProduct({{0, 1, 2}, {64, 4096}});
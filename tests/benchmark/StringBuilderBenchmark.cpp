@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "base/String.hpp"
+#include "base/StringBuilder.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    // 模拟逐行拼接大文本（着色器预处理输出、YAML 导出）
+    constexpr std::string_view LINE = "uniform vec4 u_params[16]; // generated by preprocessor\n";
+
+    void BM_TinaStringAppend(benchmark::State& state)
+    {
+        const auto lines = static_cast<size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            String result;
+            for (size_t i = 0; i < lines; ++i)
+            {
+                result.append(LINE.data(), LINE.size());
+            }
+            benchmark::DoNotOptimize(result.c_str());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * lines * LINE.size()));
+    }
+
+    void BM_StdStringAppend(benchmark::State& state)
+    {
+        const auto lines = static_cast<size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            std::string result;
+            for (size_t i = 0; i < lines; ++i)
+            {
+                result.append(LINE);
+            }
+            benchmark::DoNotOptimize(result.data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * lines * LINE.size()));
+    }
+
+    void BM_StringBuilderAppend(benchmark::State& state)
+    {
+        const auto lines = static_cast<size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            StringBuilder builder;
+            for (size_t i = 0; i < lines; ++i)
+            {
+                builder.append(LINE);
+            }
+            std::string result = builder.toString();
+            benchmark::DoNotOptimize(result.data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * lines * LINE.size()));
+    }
+}
+
+// 1024 行约 56KB，65536 行约 3.6MB
+BENCHMARK(BM_TinaStringAppend)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_StdStringAppend)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_StringBuilderAppend)->Arg(1024)->Arg(65536);
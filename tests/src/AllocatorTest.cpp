@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include "memory/Allocator.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    class TestMallocAllocator : public MallocAllocator
+    {
+    };
+}
+
+TEST(MallocAllocatorTest, AlignsAllocations)
+{
+    TestMallocAllocator allocator;
+    for (size_t alignment : {1u, 8u, 16u, 64u, 4096u})
+    {
+        void* p = allocator.allocate(100, alignment);
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignment, 0u);
+        allocator.deallocate(p);
+    }
+}
+
+TEST(MallocAllocatorTest, RejectsOverflowingSizes)
+{
+    TestMallocAllocator allocator;
+    constexpr size_t maxSize = std::numeric_limits<size_t>::max();
+
+    // 加上对齐和保存原始指针的空间后会回绕
+    EXPECT_EQ(allocator.allocate(maxSize, 16), nullptr);
+    EXPECT_EQ(allocator.allocate(maxSize - sizeof(void*) - 16 + 1, 16), nullptr);
+    EXPECT_EQ(allocator.allocate(1, maxSize - sizeof(void*) + 1), nullptr);
+    allocator.deallocate(nullptr);
+}
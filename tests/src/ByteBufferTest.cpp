@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "filesystem/ByteBuffer.hpp"
+#include "filesystem/ByteView.hpp"
+
+using namespace Tina;
+
+TEST(ByteBufferTest, ReadStringSkipsTerminator) {
+    ByteBuffer buffer;
+    const char data[] = "first\0second\0tail";
+    buffer.append(reinterpret_cast<const uint8_t *>(data), sizeof(data) - 1);
+
+    EXPECT_EQ(buffer.readString(), "first");
+    const std::string_view second = buffer.readStringView();
+    EXPECT_EQ(second, "second");
+    // 视图直接指向缓冲区内部
+    EXPECT_EQ(second.data(), reinterpret_cast<const char *>(buffer.peek()) - 7);
+    EXPECT_EQ(buffer.readStringView(), "tail");
+    EXPECT_EQ(buffer.bytesRemaining(), 0u);
+    EXPECT_TRUE(buffer.readStringView().empty());
+}
+
+TEST(ByteBufferTest, BulkReadMatchesScalarRead) {
+    ByteBuffer buffer;
+    for (uint32_t i = 0; i < 64; ++i) {
+        buffer.append(i * 0x01010101u);
+    }
+
+    std::vector<uint32_t> values(64);
+    ASSERT_TRUE(buffer.read(values.data(), values.size()));
+    for (uint32_t i = 0; i < 64; ++i) {
+        EXPECT_EQ(values[i], i * 0x01010101u);
+    }
+    EXPECT_EQ(buffer.bytesRemaining(), 0u);
+
+    // 数据不足时不读取，读位置不变
+    buffer.setReadPos(buffer.size() - 2);
+    uint32_t overflow = 0;
+    EXPECT_FALSE(buffer.read(&overflow, 1));
+    EXPECT_EQ(buffer.getReadPos(), buffer.size() - 2);
+}
+
+TEST(ByteBufferTest, BulkPutRejectsOverflowingCount) {
+    ByteBuffer buffer;
+    buffer.append(uint32_t{0});
+    buffer.append(uint32_t{0});
+    const uint32_t values[2] = {0x11223344u, 0x55667788u};
+
+    // pos + count * sizeof(T) 回绕后看起来在范围内，不能写入
+    buffer.put(4, values, (SIZE_MAX / sizeof(uint32_t)) + 1);
+    buffer.put(SIZE_MAX, values, 1);
+    EXPECT_EQ(buffer.read<uint32_t>(4), 0u);
+
+    buffer.put(0, values, 2);
+    EXPECT_EQ(buffer.read<uint32_t>(4), 0x55667788u);
+}
+
+TEST(ByteBufferTest, BulkAppendRejectsOverflowingCount) {
+    ByteBuffer buffer;
+    buffer.append(uint32_t{0x11223344u});
+    const uint32_t values[2] = {0x55667788u, 0x99aabbccu};
+
+    // wPos_ + cnt * sizeof(T) 回绕成很小的值时不能跳过扩容直接写入
+    EXPECT_THROW(buffer.append(values, (SIZE_MAX / sizeof(uint32_t)) + 1), std::length_error);
+    EXPECT_THROW(buffer.append(values, SIZE_MAX / sizeof(uint32_t)), std::length_error);
+    EXPECT_THROW(buffer.append(reinterpret_cast<const uint8_t *>(values), SIZE_MAX - 1), std::length_error);
+    EXPECT_EQ(buffer.size(), sizeof(uint32_t));
+
+    buffer.append(values, 2);
+    EXPECT_EQ(buffer.size(), 3 * sizeof(uint32_t));
+    EXPECT_EQ(buffer.read<uint32_t>(8), 0x99aabbccu);
+}
+
+TEST(ByteBufferTest, ReadBytesUpToEnd) {
+    ByteBuffer buffer;
+    const uint8_t data[4] = {1, 2, 3, 4};
+    buffer.append(data, 4);
+
+    uint8_t out[4] = {};
+    buffer.read(out, 4);
+    EXPECT_EQ(std::memcmp(out, data, 4), 0);
+    EXPECT_EQ(buffer.getReadPos(), 4u);
+}
+
+TEST(ByteViewTest, WrapsExternalMemoryWithoutCopy) {
+    ByteBuffer writer;
+    writer.append(uint16_t{0xABCD});
+    writer.append(int32_t{-42});
+    writer.append(reinterpret_cast<const uint8_t *>("name\0"), 5);
+    writer.append(reinterpret_cast<const uint8_t *>("payload"), 7);
+
+    std::vector<uint8_t> storage(writer.peek(), writer.peek() + writer.size());
+    ByteView view(storage.data(), storage.size());
+
+    EXPECT_EQ(view.read<uint16_t>(), 0xABCD);
+    EXPECT_EQ(view.read<int32_t>(), -42);
+
+    const std::string_view name = view.readString();
+    EXPECT_EQ(name, "name");
+    EXPECT_GE(reinterpret_cast<const uint8_t *>(name.data()), storage.data());
+    EXPECT_LT(reinterpret_cast<const uint8_t *>(name.data()), storage.data() + storage.size());
+
+    ByteView payload = view.readBytes(7);
+    EXPECT_EQ(payload.data(), storage.data() + 11);
+    EXPECT_EQ(payload.readString(7), "payload");
+    EXPECT_EQ(view.bytesRemaining(), 0u);
+}
+
+TEST(ByteViewTest, OutOfRangeReadsAreSafe) {
+    const uint8_t data[3] = {1, 2, 3};
+    ByteView view(data, sizeof(data));
+
+    EXPECT_EQ(view.read<uint32_t>(), 0u);
+    EXPECT_EQ(view.getReadPos(), 0u);
+    EXPECT_TRUE(view.readBytes(4).isEmpty());
+    EXPECT_TRUE(view.readString(4).empty());
+    EXPECT_EQ(view.subView(1, 10).size(), 2u);
+    EXPECT_TRUE(view.subView(5, 1).isEmpty());
+
+    view.skipBytes(10);
+    EXPECT_EQ(view.bytesRemaining(), 0u);
+}
+
+TEST(ByteViewTest, BulkReadRejectsOverflowingCount) {
+    const uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    ByteView view(data, sizeof(data));
+
+    // count * sizeof(uint32_t) 溢出后等于 4，不能因此通过剩余长度检查
+    uint32_t value = 0;
+    const size_t count = (SIZE_MAX / sizeof(uint32_t)) + 2;
+    EXPECT_FALSE(view.read(&value, count));
+    EXPECT_EQ(view.getReadPos(), 0u);
+    EXPECT_EQ(value, 0u);
+
+    EXPECT_EQ(view.read<uint8_t>(SIZE_MAX), 0u);
+    uint32_t values[2];
+    EXPECT_TRUE(view.read(values, 2));
+    EXPECT_EQ(view.bytesRemaining(), 0u);
+}
@@ -3,6 +3,8 @@
 //
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
 #include "tool/Endianness.hpp"
 
 using namespace Tina::Tool;
@@ -41,4 +43,57 @@ TEST(EndiannessTest, ConvertUint64) {
 bool IsLittleEndian() {
     uint32_t value = 1;
     return *reinterpret_cast<uint8_t*>(&value) == 1;
-}
\ No newline at end of file
+}
+TEST(EndiannessTest, BulkConvertMatchesScalar) {
+    // 长度覆盖 SIMD 主循环和标量收尾
+    for (size_t count : {0u, 1u, 7u, 8u, 33u, 257u}) {
+        std::vector<uint16_t> u16(count);
+        std::vector<uint32_t> u32(count);
+        std::vector<uint64_t> u64(count);
+        std::vector<float> f32(count);
+        for (size_t i = 0; i < count; ++i) {
+            u16[i] = static_cast<uint16_t>(i * 0x0102 + 3);
+            u32[i] = static_cast<uint32_t>(i * 0x01020304u + 5);
+            u64[i] = i * 0x0102030405060708ull + 7;
+            f32[i] = static_cast<float>(i) * 1.5f;
+        }
+
+        std::vector<uint16_t> out16(count);
+        std::vector<uint32_t> out32(count);
+        EndianConvert(u16.data(), out16.data(), count);
+        EndianConvert(u32.data(), out32.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(out16[i], EndianConvert(u16[i]));
+            EXPECT_EQ(out32[i], EndianConvert(u32[i]));
+        }
+
+        // 原地转换
+        std::vector<uint64_t> in64 = u64;
+        std::vector<float> inF32 = f32;
+        EndianConvert(in64.data(), count);
+        EndianConvert(inF32.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(in64[i], EndianConvert(u64[i]));
+            const float expected = EndianConvert(f32[i]);
+            EXPECT_EQ(std::memcmp(&inF32[i], &expected, sizeof(float)), 0);
+        }
+
+        // 转换两次还原
+        EndianConvert(in64.data(), count);
+        EXPECT_EQ(in64, u64);
+    }
+}
+
+TEST(EndiannessTest, BulkConvertUnalignedSource) {
+    std::vector<uint8_t> bytes(1 + 40 * sizeof(uint32_t));
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i);
+    }
+    const auto *src = reinterpret_cast<const uint32_t *>(bytes.data() + 1);
+    std::vector<uint32_t> out(40);
+    EndianConvert(src, out.data(), out.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        const auto b = static_cast<uint32_t>(1 + i * 4);
+        EXPECT_EQ(out[i], (b << 24) | ((b + 1) << 16) | ((b + 2) << 8) | (b + 3));
+    }
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "filesystem/FileWatcher.hpp"
+
+using namespace Tina;
+using namespace std::chrono_literals;
+
+namespace {
+    void writeFile(const std::string &name, const std::string &content) {
+        std::ofstream stream(name, std::ios::binary);
+        stream << content;
+    }
+
+    // 等到 poll 返回结果或超时
+    std::vector<std::string> waitForChanges(FileWatcher &watcher, std::chrono::milliseconds timeout = 3000ms) {
+        std::vector<std::string> changed;
+        const auto deadline = FileWatcher::Clock::now() + timeout;
+        while (changed.empty() && FileWatcher::Clock::now() < deadline) {
+            std::this_thread::sleep_for(20ms);
+            watcher.poll(changed);
+        }
+        return changed;
+    }
+}
+
+TEST(FileWatcherTest, ReportsModifiedFile) {
+    writeFile("file_watcher_test.txt", "a");
+    FileWatcher watcher(50ms);
+    ASSERT_TRUE(watcher.watch("file_watcher_test.txt"));
+    EXPECT_TRUE(watcher.isWatching("file_watcher_test.txt"));
+
+    // 退化为比较修改时间时，部分文件系统的时间精度只有 1 秒
+    std::this_thread::sleep_for(1100ms);
+    writeFile("file_watcher_test.txt", "b");
+
+    const auto changed = waitForChanges(watcher);
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], "file_watcher_test.txt");
+
+    std::remove("file_watcher_test.txt");
+}
+
+TEST(FileWatcherTest, DebouncesBurstWrites) {
+    writeFile("file_watcher_burst.txt", "0");
+    FileWatcher watcher(300ms);
+    ASSERT_TRUE(watcher.watch("file_watcher_burst.txt"));
+
+    std::this_thread::sleep_for(1100ms);
+    for (int i = 0; i < 5; ++i) {
+        writeFile("file_watcher_burst.txt", std::to_string(i));
+        std::this_thread::sleep_for(30ms);
+    }
+
+    std::vector<std::string> changed;
+    watcher.poll(changed);
+    // 最后一次写入还未超过 debounce
+    EXPECT_TRUE(changed.empty());
+
+    changed = waitForChanges(watcher);
+    EXPECT_EQ(changed.size(), 1u);
+    std::this_thread::sleep_for(400ms);
+    changed.clear();
+    watcher.poll(changed);
+    EXPECT_TRUE(changed.empty());
+
+    std::remove("file_watcher_burst.txt");
+}
+
+TEST(FileWatcherTest, ReportsEverySpellingOfSamePath) {
+    writeFile("file_watcher_alias.txt", "a");
+    FileWatcher watcher(50ms);
+    ASSERT_TRUE(watcher.watch("file_watcher_alias.txt"));
+    ASSERT_TRUE(watcher.watch("./file_watcher_alias.txt"));
+    EXPECT_EQ(watcher.getWatchCount(), 1u);
+
+    std::this_thread::sleep_for(1100ms);
+    writeFile("file_watcher_alias.txt", "b");
+    EXPECT_EQ(waitForChanges(watcher).size(), 2u);
+
+    watcher.unwatch("./file_watcher_alias.txt");
+    EXPECT_TRUE(watcher.isWatching("file_watcher_alias.txt"));
+    watcher.unwatch("file_watcher_alias.txt");
+    EXPECT_EQ(watcher.getWatchCount(), 0u);
+
+    std::remove("file_watcher_alias.txt");
+}
+
+TEST(FileWatcherTest, IgnoresUnwatchedFiles) {
+    writeFile("file_watcher_other.txt", "a");
+    writeFile("file_watcher_watched.txt", "a");
+    FileWatcher watcher(50ms);
+    ASSERT_TRUE(watcher.watch("file_watcher_watched.txt"));
+
+    std::this_thread::sleep_for(1100ms);
+    writeFile("file_watcher_other.txt", "b");
+    EXPECT_TRUE(waitForChanges(watcher, 500ms).empty());
+
+    std::remove("file_watcher_other.txt");
+    std::remove("file_watcher_watched.txt");
+}
+
+TEST(FileWatcherTest, FailsForMissingDirectory) {
+    FileWatcher watcher;
+    EXPECT_FALSE(watcher.watch("no_such_directory/file.txt"));
+}
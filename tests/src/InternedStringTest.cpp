@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "base/InternedString.hpp"
+
+using namespace Tina;
+
+TEST(InternedStringTest, EmptyString)
+{
+    InternedString empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.getId(), 0);
+    EXPECT_EQ(empty.length(), 0);
+    EXPECT_STREQ(empty.c_str(), "");
+
+    EXPECT_EQ(InternedString(""), empty);
+    EXPECT_EQ(InternedString(static_cast<const char*>(nullptr)), empty);
+    EXPECT_EQ(std::hash<InternedString>{}(InternedString("")), std::hash<InternedString>{}(empty));
+}
+
+TEST(InternedStringTest, SameContentSameId)
+{
+    InternedString a("textures/player.png");
+    InternedString b(std::string("textures/player.png"));
+    InternedString c(String("textures/player.png"));
+    InternedString d(std::string_view("textures/player.png!").substr(0, 19));
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, c);
+    EXPECT_EQ(a, d);
+    EXPECT_EQ(a.getHash(), b.getHash());
+    EXPECT_EQ(a.view(), "textures/player.png");
+    EXPECT_STREQ(a.c_str(), "textures/player.png");
+    EXPECT_EQ(a.length(), 19);
+}
+
+TEST(InternedStringTest, DifferentContentDifferentId)
+{
+    InternedString a("u_texColor");
+    InternedString b("u_texcolor");
+    EXPECT_NE(a, b);
+    EXPECT_NE(a.getId(), b.getId());
+    EXPECT_TRUE(a < b || b < a);
+}
+
+TEST(InternedStringTest, WorksAsHashMapKey)
+{
+    std::unordered_map<InternedString, int> values;
+    values[InternedString("window.width")] = 1280;
+    values[InternedString("window.height")] = 720;
+
+    EXPECT_EQ(values.at(InternedString("window.width")), 1280);
+    EXPECT_EQ(values.at(InternedString("window.height")), 720);
+    EXPECT_EQ(values.count(InternedString("window.title")), 0);
+}
+
+TEST(InternedStringTest, ConcurrentInterning)
+{
+    constexpr int threadCount = 8;
+    constexpr int stringCount = 2000;
+
+    std::vector<std::vector<uint32_t>> ids(threadCount, std::vector<uint32_t>(stringCount));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&ids, t]
+        {
+            for (int i = 0; i < stringCount; ++i)
+            {
+                const int index = (i + t * 131) % stringCount;
+                ids[t][index] = InternedString("concurrent/" + std::to_string(index)).getId();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // 所有线程对同一字符串得到同一个 id，不同字符串的 id 互不相同
+    std::set<uint32_t> unique;
+    for (int i = 0; i < stringCount; ++i)
+    {
+        for (int t = 1; t < threadCount; ++t)
+        {
+            EXPECT_EQ(ids[t][i], ids[0][i]);
+        }
+        unique.insert(ids[0][i]);
+        EXPECT_EQ(InternedString("concurrent/" + std::to_string(i)).getId(), ids[0][i]);
+    }
+    EXPECT_EQ(unique.size(), stringCount);
+}
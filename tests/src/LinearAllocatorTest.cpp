@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include "memory/LinearAllocator.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    struct BatchInfo
+    {
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint16_t texture;
+    };
+}
+
+TEST(LinearAllocatorTest, BumpAllocation)
+{
+    LinearAllocator allocator(1024);
+    EXPECT_EQ(allocator.getCapacity(), 1024);
+    EXPECT_EQ(allocator.getUsed(), 0);
+
+    void* a = allocator.allocate(100, 1);
+    void* b = allocator.allocate(100, 1);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(static_cast<uint8_t*>(b) - static_cast<uint8_t*>(a), 100);
+    EXPECT_EQ(allocator.getUsed(), 200);
+    EXPECT_TRUE(allocator.owns(a));
+    EXPECT_TRUE(allocator.owns(b));
+}
+
+TEST(LinearAllocatorTest, Alignment)
+{
+    LinearAllocator allocator(4096);
+    allocator.allocate(3, 1);
+
+    for (size_t alignment : {2u, 4u, 8u, 16u, 64u, 256u})
+    {
+        void* p = allocator.allocate(1, alignment);
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignment, 0u);
+    }
+
+    auto* info = allocator.create<BatchInfo>(BatchInfo{0, 6, 1});
+    ASSERT_NE(info, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(info) % alignof(BatchInfo), 0u);
+    EXPECT_EQ(info->vertexCount, 6);
+}
+
+TEST(LinearAllocatorTest, ReturnsNullWhenExhausted)
+{
+    LinearAllocator allocator(128);
+    EXPECT_NE(allocator.allocate(128, 1), nullptr);
+    EXPECT_EQ(allocator.allocate(1, 1), nullptr);
+    EXPECT_EQ(allocator.getRemaining(), 0);
+}
+
+TEST(LinearAllocatorTest, RejectsOverflowingSizes)
+{
+    LinearAllocator allocator(128);
+    ASSERT_NE(allocator.allocate(3, 1), nullptr);
+
+    // 加上对齐填充后会回绕的大小
+    EXPECT_EQ(allocator.allocate(std::numeric_limits<size_t>::max(), 16), nullptr);
+    EXPECT_EQ(allocator.allocate(std::numeric_limits<size_t>::max() - 8, 1), nullptr);
+    EXPECT_EQ(allocator.allocate(1, size_t(1) << (sizeof(size_t) * 8 - 1)), nullptr);
+    EXPECT_EQ(allocator.allocateArray<uint64_t>(std::numeric_limits<size_t>::max() / sizeof(uint64_t) + 1), nullptr);
+    EXPECT_EQ(allocator.getUsed(), 3);
+
+    // 恰好用完剩余空间的请求仍然成功
+    EXPECT_NE(allocator.allocate(allocator.getRemaining(), 1), nullptr);
+    EXPECT_EQ(allocator.getRemaining(), 0);
+    EXPECT_EQ(allocator.allocate(1, 1), nullptr);
+}
+
+TEST(LinearAllocatorTest, ResetReclaimsEverything)
+{
+    LinearAllocator allocator(256);
+    void* first = allocator.allocate(200, 8);
+    allocator.reset();
+
+    EXPECT_EQ(allocator.getUsed(), 0);
+    EXPECT_EQ(allocator.getPeak(), 200);
+    EXPECT_EQ(allocator.allocate(200, 8), first);
+}
+
+TEST(LinearAllocatorTest, MarkerRollback)
+{
+    LinearAllocator allocator(1024);
+    allocator.allocate(64, 8);
+    const auto marker = allocator.getMarker();
+
+    allocator.allocate(128, 8);
+    EXPECT_EQ(allocator.getUsed(), 192);
+
+    allocator.rollback(marker);
+    EXPECT_EQ(allocator.getUsed(), 64);
+
+    {
+        LinearAllocator::ScopedMarker scope(allocator);
+        auto* values = allocator.allocateArray<float>(32);
+        ASSERT_NE(values, nullptr);
+        EXPECT_EQ(allocator.getUsed(), 64 + 32 * sizeof(float));
+    }
+    EXPECT_EQ(allocator.getUsed(), 64);
+}
+
+TEST(LinearAllocatorTest, PoisonsReleasedRegion)
+{
+    LinearAllocator allocator(256);
+    allocator.setPoisonEnabled(true);
+
+    auto* bytes = static_cast<uint8_t*>(allocator.allocate(32, 1));
+    ASSERT_NE(bytes, nullptr);
+    std::memset(bytes, 0x11, 32);
+
+    allocator.reset();
+    for (int i = 0; i < 32; ++i)
+    {
+        EXPECT_EQ(bytes[i], LinearAllocator::POISON_BYTE);
+    }
+}
+
+TEST(LinearAllocatorTest, DeallocateIsNoOp)
+{
+    LinearAllocator allocator(256);
+    void* p = allocator.allocate(16, 8);
+    allocator.deallocate(p);
+    EXPECT_EQ(allocator.getUsed(), 16);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "tool/Lz4.hpp"
+
+using namespace Tina::Tool;
+
+namespace {
+    std::vector<uint8_t> roundTrip(const std::vector<uint8_t> &input, size_t *compressedSize = nullptr) {
+        std::vector<uint8_t> compressed(Lz4CompressBound(input.size()));
+        const size_t size = Lz4Compress(input.data(), input.size(), compressed.data(), compressed.size());
+        EXPECT_GT(size, 0u);
+        if (compressedSize) {
+            *compressedSize = size;
+        }
+
+        std::vector<uint8_t> output(input.size());
+        EXPECT_TRUE(Lz4Decompress(compressed.data(), size, output.data(), output.size()));
+        return output;
+    }
+}
+
+TEST(Lz4Test, RoundTripsEmptyAndShortInput) {
+    for (size_t length: {0, 1, 5, 12, 13, 20}) {
+        std::vector<uint8_t> input(length);
+        for (size_t i = 0; i < length; ++i) {
+            input[i] = static_cast<uint8_t>(i * 7);
+        }
+        EXPECT_EQ(roundTrip(input), input) << "length " << length;
+    }
+}
+
+TEST(Lz4Test, CompressesRepetitiveData) {
+    std::vector<uint8_t> input;
+    const std::string pattern = "texture atlas sprite ";
+    while (input.size() < 100000) {
+        input.insert(input.end(), pattern.begin(), pattern.end());
+    }
+
+    size_t compressedSize = 0;
+    EXPECT_EQ(roundTrip(input, &compressedSize), input);
+    EXPECT_LT(compressedSize, input.size() / 20);
+
+    // 重叠匹配：同一字节的长串
+    const std::vector<uint8_t> run(70000, 0xAB);
+    EXPECT_EQ(roundTrip(run), run);
+}
+
+TEST(Lz4Test, RoundTripsRandomData) {
+    std::mt19937 random(42);
+    std::vector<uint8_t> input(200000);
+    for (auto &byte: input) {
+        byte = static_cast<uint8_t>(random());
+    }
+    EXPECT_EQ(roundTrip(input), input);
+}
+
+TEST(Lz4Test, RejectsSmallOutputAndCorruptInput) {
+    const std::vector<uint8_t> input(1000, 'a');
+    std::vector<uint8_t> compressed(Lz4CompressBound(input.size()));
+    const size_t size = Lz4Compress(input.data(), input.size(), compressed.data(), compressed.size());
+    ASSERT_GT(size, 0u);
+
+    std::vector<uint8_t> tooSmall(4);
+    EXPECT_EQ(Lz4Compress(input.data(), input.size(), tooSmall.data(), tooSmall.size()), 0u);
+
+    std::vector<uint8_t> output(input.size());
+    EXPECT_FALSE(Lz4Decompress(compressed.data(), size, output.data(), output.size() - 1));
+    EXPECT_FALSE(Lz4Decompress(compressed.data(), size - 1, output.data(), output.size()));
+
+    // 偏移量指向输出开始之前
+    const uint8_t badOffset[] = {0x10, 'a', 0xFF, 0x00, 0x00};
+    EXPECT_FALSE(Lz4Decompress(badOffset, sizeof(badOffset), output.data(), 5));
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "filesystem/MappedFile.hpp"
+
+using namespace Tina;
+
+namespace {
+    std::string writeTempFile(const std::string &name, const std::string &content) {
+        std::ofstream stream(name, std::ios::binary);
+        stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return name;
+    }
+}
+
+TEST(MappedFileTest, MapsFileContent) {
+    std::string content(100000, 'x');
+    content += "tail";
+    const std::string name = writeTempFile("mapped_file_test.bin", content);
+
+    MappedFile file(Path(name.c_str()), MappedFile::AccessPattern::Random);
+    ASSERT_TRUE(file.isOpen());
+    ASSERT_EQ(file.size(), content.size());
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(file.data()), file.size()), content);
+
+    ByteView view = file.view();
+    view.skipBytes(100000);
+    EXPECT_EQ(view.readString(4), "tail");
+
+    // 移动后原对象不再持有映射
+    MappedFile moved(std::move(file));
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(moved.size(), content.size());
+    moved.close();
+    EXPECT_EQ(moved.data(), nullptr);
+
+    std::remove(name.c_str());
+}
+
+TEST(MappedFileTest, EmptyAndMissingFiles) {
+    const std::string name = writeTempFile("mapped_file_empty.bin", "");
+    MappedFile empty;
+    EXPECT_TRUE(empty.open(Path(name.c_str())));
+    EXPECT_EQ(empty.size(), 0u);
+    std::remove(name.c_str());
+
+    MappedFile missing;
+    EXPECT_FALSE(missing.open(Path("mapped_file_missing.bin")));
+    EXPECT_FALSE(missing.isOpen());
+    EXPECT_THROW(MappedFile(Path("mapped_file_missing.bin")), std::runtime_error);
+}
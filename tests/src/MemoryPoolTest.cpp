@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "memory/MemoryPool.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    struct Tracked
+    {
+        static int aliveCount;
+
+        int value;
+        std::string name;
+
+        Tracked(int v, std::string n) : value(v), name(std::move(n))
+        {
+            ++aliveCount;
+        }
+
+        ~Tracked()
+        {
+            --aliveCount;
+        }
+    };
+
+    int Tracked::aliveCount = 0;
+
+    struct alignas(64) OverAligned
+    {
+        float data[4];
+    };
+}
+
+TEST(MemoryPoolTest, AllocateAndDeallocate)
+{
+    MemoryPool<int> pool;
+    EXPECT_EQ(pool.allocatedCount(), 0);
+    EXPECT_EQ(pool.blockCount(), 0);
+
+    int* a = pool.allocate();
+    int* b = pool.allocate();
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(pool.allocatedCount(), 2);
+    EXPECT_EQ(pool.blockCount(), 1);
+
+    *a = 1;
+    *b = 2;
+    EXPECT_EQ(*a, 1);
+    EXPECT_EQ(*b, 2);
+
+    pool.deallocate(a);
+    pool.deallocate(b);
+    EXPECT_EQ(pool.allocatedCount(), 0);
+}
+
+TEST(MemoryPoolTest, FreedSlotIsReusedFirst)
+{
+    MemoryPool<double> pool;
+    double* a = pool.allocate();
+    double* b = pool.allocate();
+    pool.deallocate(a);
+
+    // 空闲链表是 LIFO，刚释放的槽位应当被立即复用
+    double* c = pool.allocate();
+    EXPECT_EQ(c, a);
+
+    pool.deallocate(b);
+    pool.deallocate(c);
+}
+
+TEST(MemoryPoolTest, GrowthDoesNotMoveLiveObjects)
+{
+    MemoryPool<uint64_t, 256> pool;
+    const size_t count = pool.slotsPerBlock() * 10;
+
+    std::vector<uint64_t*> pointers;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint64_t* p = pool.allocate();
+        *p = i;
+        pointers.push_back(p);
+    }
+
+    EXPECT_GE(pool.blockCount(), 10);
+    EXPECT_EQ(pool.allocatedCount(), count);
+
+    // 扩容后之前的对象地址和内容都应保持不变
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(*pointers[i], i);
+    }
+
+    for (auto* p : pointers)
+    {
+        pool.deallocate(p);
+    }
+    EXPECT_EQ(pool.allocatedCount(), 0);
+}
+
+TEST(MemoryPoolTest, NewAndDeleteElement)
+{
+    Tracked::aliveCount = 0;
+    {
+        MemoryPool<Tracked> pool;
+        Tracked* t = pool.newElement(42, "answer");
+        EXPECT_EQ(Tracked::aliveCount, 1);
+        EXPECT_EQ(t->value, 42);
+        EXPECT_EQ(t->name, "answer");
+
+        pool.deleteElement(t);
+        EXPECT_EQ(Tracked::aliveCount, 0);
+        EXPECT_EQ(pool.allocatedCount(), 0);
+    }
+}
+
+TEST(MemoryPoolTest, RespectsAlignment)
+{
+    MemoryPool<OverAligned> pool;
+    std::vector<OverAligned*> pointers;
+    for (int i = 0; i < 200; ++i)
+    {
+        OverAligned* p = pool.allocate();
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignof(OverAligned), 0u);
+        pointers.push_back(p);
+    }
+    for (auto* p : pointers)
+    {
+        pool.deallocate(p);
+    }
+}
+
+TEST(MemoryPoolTest, MoveTransfersOwnership)
+{
+    MemoryPool<int> pool;
+    int* p = pool.allocate();
+    *p = 7;
+
+    MemoryPool<int> moved(std::move(pool));
+    EXPECT_EQ(pool.allocatedCount(), 0);
+    EXPECT_EQ(pool.blockCount(), 0);
+    EXPECT_EQ(moved.allocatedCount(), 1);
+    EXPECT_EQ(*p, 7);
+
+    moved.deallocate(p);
+}
+
+TEST(MemoryPoolTest, PoolAllocatorWorksWithList)
+{
+    std::list<int, PoolAllocator<int>> values;
+    for (int i = 0; i < 10000; ++i)
+    {
+        values.push_back(i);
+    }
+    EXPECT_EQ(values.size(), 10000);
+
+    values.remove_if([](int v) { return v % 2 == 0; });
+    EXPECT_EQ(values.size(), 5000);
+    EXPECT_EQ(values.front(), 1);
+    EXPECT_EQ(values.back(), 9999);
+
+    std::list<int, PoolAllocator<int>> copied(values);
+    EXPECT_EQ(copied, values);
+
+    // 共享池的分配器彼此相等，跨容器 splice 是合法的
+    copied.splice(copied.end(), values);
+    EXPECT_TRUE(values.empty());
+    EXPECT_EQ(copied.size(), 10000);
+}
+
+TEST(MemoryPoolTest, PoolAllocatorWorksWithMap)
+{
+    using Pair = std::pair<const int, std::string>;
+    std::map<int, std::string, std::less<>, PoolAllocator<Pair>> table;
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.emplace(i, std::to_string(i));
+    }
+    EXPECT_EQ(table.size(), 1000);
+    EXPECT_EQ(table.at(500), "500");
+
+    table.erase(table.begin(), table.find(900));
+    EXPECT_EQ(table.size(), 100);
+}
+
+TEST(MemoryPoolTest, ArrayAllocationFallsBackToHeap)
+{
+    std::vector<long, PoolAllocator<long>> values;
+    for (long i = 0; i < 1000; ++i)
+    {
+        values.push_back(i);
+    }
+    EXPECT_EQ(values.size(), 1000);
+    EXPECT_EQ(values[999], 999);
+    // 只有 n == 1 的申请使用池中的槽位，其余直接向堆申请。
+    // vector 第一次扩容到容量 1 时占用一个槽位，之后扩容时归还，最终不占用槽位
+    EXPECT_EQ(PoolAllocator<long>::allocatedCount(), 0);
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "resource/ResourceCache.hpp"
+
+using namespace Tina;
+
+namespace {
+    class FakeResource : public Resource {
+    public:
+        FakeResource(const ResourceHandle &handle, const std::string &path, size_t gpuBytes)
+            : Resource(handle, path, handle.getType()), m_gpuBytes(gpuBytes) {
+        }
+
+        bool load() override { return true; }
+        void unload() override { m_gpuBytes = 0; }
+        bool isLoaded() const override { return true; }
+
+        ResourceMemoryUsage getMemoryUsage() const override { return {0, m_gpuBytes}; }
+
+        void setGpuBytes(size_t bytes) { m_gpuBytes = bytes; }
+
+    private:
+        size_t m_gpuBytes;
+    };
+
+    // 按 ResourceManager 的流程分配句柄并放入缓存，返回句柄，缓存之外不保留引用
+    ResourceHandle add(ResourceCache &cache, const std::string &path, size_t gpuBytes,
+                       ResourceType type = ResourceType::Texture) {
+        const ResourceHandle handle = cache.allocate(type);
+        cache.insert(createRefPtr<FakeResource>(handle, path, gpuBytes));
+        return handle;
+    }
+}
+
+TEST(ResourceCacheTest, HandlesEncodeTypeAndGeneration) {
+    ResourceCache cache;
+    const ResourceHandle texture = add(cache, "a.png", 10);
+    const ResourceHandle shader = add(cache, "basic", 10, ResourceType::Shader);
+
+    EXPECT_TRUE(texture.isValid());
+    EXPECT_EQ(texture.getType(), ResourceType::Texture);
+    EXPECT_EQ(shader.getType(), ResourceType::Shader);
+    // 每种类型有自己的槽位表，下标各自从 0 开始
+    EXPECT_EQ(texture.getIndex(), 0u);
+    EXPECT_EQ(shader.getIndex(), 0u);
+    EXPECT_NE(texture, shader);
+}
+
+TEST(ResourceCacheTest, StaleHandlesDoNotResolve) {
+    ResourceCache cache;
+    const ResourceHandle first = add(cache, "a.png", 10);
+    cache.erase(first);
+
+    // 复用同一槽位，但代数不同
+    const ResourceHandle second = add(cache, "b.png", 10);
+    EXPECT_EQ(second.getIndex(), first.getIndex());
+    EXPECT_NE(second.getGeneration(), first.getGeneration());
+
+    EXPECT_EQ(cache.peek(first), nullptr);
+    ASSERT_NE(cache.peek(second), nullptr);
+    EXPECT_EQ(cache.peek(second)->getPath(), "b.png");
+}
+
+TEST(ResourceCacheTest, ReservedSlotsAreNotLoaded) {
+    ResourceCache cache;
+    const ResourceHandle handle = cache.allocate(ResourceType::Texture);
+    EXPECT_TRUE(handle.isValid());
+    EXPECT_FALSE(cache.contains(handle));
+    EXPECT_EQ(cache.size(), 0u);
+
+    cache.erase(handle);
+    // 预留被释放后不能再插入
+    EXPECT_FALSE(cache.insert(createRefPtr<FakeResource>(handle, "a.png", 10)));
+    EXPECT_FALSE(cache.allocate(ResourceType::Count).isValid());
+}
+
+TEST(ResourceCacheTest, TracksHitsAndMisses) {
+    ResourceCache cache;
+    const ResourceHandle handle = add(cache, "a.png", 10);
+
+    EXPECT_NE(cache.find(handle), nullptr);
+    EXPECT_EQ(cache.find(ResourceHandle()), nullptr);
+    EXPECT_NE(cache.peek(handle), nullptr);
+
+    EXPECT_EQ(cache.getStats().hits, 1u);
+    EXPECT_EQ(cache.getStats().misses, 1u);
+
+    cache.resetStats();
+    EXPECT_EQ(cache.getStats().hits, 0u);
+}
+
+TEST(ResourceCacheTest, TracksMemoryUsagePerType) {
+    ResourceCache cache;
+    const ResourceHandle a = add(cache, "a.png", 100);
+    add(cache, "b.png", 50);
+    add(cache, "basic", 8, ResourceType::Shader);
+
+    EXPECT_EQ(cache.getMemoryUsage(ResourceType::Texture), 150u);
+    EXPECT_EQ(cache.getMemoryUsage(ResourceType::Shader), 8u);
+    EXPECT_EQ(cache.getTotalMemoryUsage().gpuBytes, 158u);
+
+    cache.erase(a);
+    EXPECT_EQ(cache.getMemoryUsage(ResourceType::Texture), 50u);
+    EXPECT_EQ(cache.size(), 2u);
+
+    EXPECT_EQ(cache.clear().size(), 2u);
+    EXPECT_EQ(cache.getTotalMemoryUsage().total(), 0u);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(ResourceCacheTest, IteratesResourcesOfOneType) {
+    ResourceCache cache;
+    add(cache, "a.png", 1);
+    const ResourceHandle b = add(cache, "b.png", 2);
+    add(cache, "c.png", 4);
+    add(cache, "basic", 8, ResourceType::Shader);
+    cache.erase(b);
+
+    size_t bytes = 0;
+    size_t count = 0;
+    cache.forEach(ResourceType::Texture, [&](const RefPtr<Resource> &resource) {
+        bytes += resource->getMemoryUsage().gpuBytes;
+        ++count;
+    });
+    EXPECT_EQ(count, 2u);
+    EXPECT_EQ(bytes, 5u);
+}
+
+TEST(ResourceCacheTest, EvictsLeastRecentlyUsedOverBudget) {
+    ResourceCache cache;
+    cache.setBudget(ResourceType::Texture, 250);
+    const ResourceHandle a = add(cache, "a.png", 100);
+    const ResourceHandle b = add(cache, "b.png", 100);
+    add(cache, "c.png", 100);
+
+    // a 最近被使用过，应淘汰 b
+    cache.find(a);
+
+    std::vector<RefPtr<Resource>> evicted;
+    EXPECT_EQ(cache.trim(evicted), 1u);
+    ASSERT_EQ(evicted.size(), 1u);
+    EXPECT_EQ(evicted[0]->getPath(), "b.png");
+    EXPECT_FALSE(cache.contains(b));
+    EXPECT_EQ(cache.getMemoryUsage(ResourceType::Texture), 200u);
+    EXPECT_EQ(cache.getStats().evictions, 1u);
+    EXPECT_EQ(cache.getStats().evictedBytes, 100u);
+}
+
+TEST(ResourceCacheTest, KeepsExternallyReferencedResources) {
+    ResourceCache cache;
+    cache.setBudget(ResourceType::Texture, 100);
+    const ResourceHandle a = add(cache, "a.png", 100);
+    const RefPtr<Resource> inUse = cache.peek(a);
+    const ResourceHandle b = add(cache, "b.png", 100);
+    cache.find(b);
+
+    std::vector<RefPtr<Resource>> evicted;
+    cache.trim(evicted);
+    // a 是最久未使用的，但仍被外部持有，只能淘汰 b
+    ASSERT_EQ(evicted.size(), 1u);
+    EXPECT_EQ(evicted[0]->getPath(), "b.png");
+    EXPECT_TRUE(cache.contains(a));
+
+    // 只剩仍在使用的资源时允许超出预算
+    add(cache, "c.png", 100);
+    evicted.clear();
+    cache.trim(evicted);
+    EXPECT_EQ(cache.getMemoryUsage(ResourceType::Texture), 100u);
+    EXPECT_TRUE(cache.contains(a));
+}
+
+TEST(ResourceCacheTest, BudgetsAreIndependentPerType) {
+    ResourceCache cache;
+    cache.setBudget(ResourceType::Texture, 100);
+    add(cache, "a.png", 100);
+    add(cache, "basic", 1000, ResourceType::Shader);
+
+    std::vector<RefPtr<Resource>> evicted;
+    EXPECT_EQ(cache.trim(evicted), 0u);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(ResourceCacheTest, UpdatesMemoryUsageAfterReload) {
+    ResourceCache cache;
+    const ResourceHandle handle = add(cache, "a.png", 10);
+    auto resource = std::static_pointer_cast<FakeResource>(cache.peek(handle));
+
+    resource->setGpuBytes(40);
+    cache.updateMemoryUsage(handle);
+    EXPECT_EQ(cache.getMemoryUsage(ResourceType::Texture), 40u);
+    EXPECT_EQ(cache.getTotalMemoryUsage().gpuBytes, 40u);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "resource/ResourceGroup.hpp"
+
+using namespace Tina;
+
+namespace {
+    ResourceGroupDesc makeGroup(const std::string &name, std::vector<std::string> dependencies = {}) {
+        ResourceGroupDesc desc;
+        desc.name = name;
+        desc.dependencies = std::move(dependencies);
+        desc.resources.push_back({ResourceType::Texture, name + ".png"});
+        return desc;
+    }
+
+    std::vector<std::string> names(const std::vector<const ResourceGroupDesc *> &groups) {
+        std::vector<std::string> result;
+        for (const auto *group: groups) {
+            result.push_back(group->name);
+        }
+        return result;
+    }
+
+    YamlValuePtr makeValue(YamlValue value) {
+        return std::make_shared<YamlValue>(std::move(value));
+    }
+}
+
+TEST(ResourceGroupTest, AcquireLoadsDependenciesFirst) {
+    ResourceGroupGraph graph;
+    graph.define(makeGroup("common"));
+    graph.define(makeGroup("ui", {"common"}));
+    graph.define(makeGroup("level", {"common", "ui"}));
+
+    std::vector<const ResourceGroupDesc *> activated;
+    ASSERT_TRUE(graph.acquire("level", activated));
+    EXPECT_EQ(names(activated), (std::vector<std::string>{"common", "ui", "level"}));
+    EXPECT_EQ(graph.getRefCount("common"), 2u);
+    EXPECT_EQ(graph.getRefCount("ui"), 1u);
+    EXPECT_EQ(graph.getRefCount("level"), 1u);
+
+    std::vector<const ResourceGroupDesc *> deactivated;
+    ASSERT_TRUE(graph.release("level", deactivated));
+    EXPECT_EQ(names(deactivated), (std::vector<std::string>{"level", "ui", "common"}));
+    EXPECT_EQ(graph.getRefCount("common"), 0u);
+}
+
+TEST(ResourceGroupTest, SharedDependencyStaysUntilLastRelease) {
+    ResourceGroupGraph graph;
+    graph.define(makeGroup("common"));
+    graph.define(makeGroup("level-1", {"common"}));
+    graph.define(makeGroup("level-2", {"common"}));
+
+    std::vector<const ResourceGroupDesc *> activated;
+    ASSERT_TRUE(graph.acquire("level-1", activated));
+    activated.clear();
+    ASSERT_TRUE(graph.acquire("level-2", activated));
+    EXPECT_EQ(names(activated), (std::vector<std::string>{"level-2"}));
+
+    std::vector<const ResourceGroupDesc *> deactivated;
+    ASSERT_TRUE(graph.release("level-1", deactivated));
+    EXPECT_EQ(names(deactivated), (std::vector<std::string>{"level-1"}));
+    EXPECT_EQ(graph.getRefCount("common"), 1u);
+
+    deactivated.clear();
+    ASSERT_TRUE(graph.release("level-2", deactivated));
+    EXPECT_EQ(names(deactivated), (std::vector<std::string>{"level-2", "common"}));
+}
+
+TEST(ResourceGroupTest, ReleaseOnlyDirectlyAcquired) {
+    ResourceGroupGraph graph;
+    graph.define(makeGroup("common"));
+    graph.define(makeGroup("level", {"common"}));
+
+    std::vector<const ResourceGroupDesc *> groups;
+    ASSERT_TRUE(graph.acquire("level", groups));
+    // common 只是作为依赖被引用，不能单独释放
+    EXPECT_FALSE(graph.release("common", groups));
+    EXPECT_FALSE(graph.release("missing", groups));
+    EXPECT_EQ(graph.getRefCount("common"), 1u);
+
+    // 被引用的组不能替换定义
+    EXPECT_FALSE(graph.define(makeGroup("common", {"level"})));
+
+    graph.releaseAll();
+    EXPECT_EQ(graph.getRefCount("level"), 0u);
+    EXPECT_FALSE(graph.release("level", groups));
+}
+
+TEST(ResourceGroupTest, RejectsUnknownAndCyclicGroups) {
+    ResourceGroupGraph graph;
+    graph.define(makeGroup("a", {"b"}));
+    graph.define(makeGroup("b", {"c"}));
+    graph.define(makeGroup("c", {"a"}));
+    graph.define(makeGroup("d", {"missing"}));
+
+    std::vector<const ResourceGroupDesc *> activated;
+    EXPECT_FALSE(graph.acquire("a", activated));
+    EXPECT_FALSE(graph.acquire("d", activated));
+    EXPECT_FALSE(graph.acquire("missing", activated));
+    EXPECT_TRUE(activated.empty());
+    EXPECT_EQ(graph.getRefCount("a"), 0u);
+    EXPECT_EQ(graph.getRefCount("b"), 0u);
+}
+
+TEST(ResourceGroupTest, ParseConfigSection) {
+    std::unordered_map<std::string, YamlValuePtr> common;
+    common["shaders"] = makeValue(std::vector<YamlValuePtr>{makeValue("sprite")});
+    common["textures"] = makeValue(std::unordered_map<std::string, YamlValuePtr>{
+        {"player", makeValue("player.png")},
+        {"enemy", makeValue("enemy.png")},
+    });
+
+    std::unordered_map<std::string, YamlValuePtr> level;
+    level["depends"] = makeValue("common");
+    level["textures"] = makeValue(std::vector<YamlValuePtr>{makeValue("grassland.png")});
+    level["sounds"] = makeValue("ignored.ogg");
+
+    std::unordered_map<std::string, YamlValuePtr> section;
+    section["common"] = makeValue(common);
+    section["level"] = makeValue(level);
+    section["broken"] = makeValue(1);
+
+    const auto groups = ResourceGroupGraph::parse(YamlValue(section));
+    ASSERT_EQ(groups.size(), 2u);
+
+    // 组和映射形式的资源都按名称排序
+    EXPECT_EQ(groups[0].name, "common");
+    EXPECT_TRUE(groups[0].dependencies.empty());
+    ASSERT_EQ(groups[0].resources.size(), 3u);
+    EXPECT_EQ(groups[0].resources[0].type, ResourceType::Shader);
+    EXPECT_EQ(groups[0].resources[0].path, "sprite");
+    EXPECT_EQ(groups[0].resources[1].type, ResourceType::Texture);
+    EXPECT_EQ(groups[0].resources[1].path, "enemy.png");
+    EXPECT_EQ(groups[0].resources[2].path, "player.png");
+
+    EXPECT_EQ(groups[1].name, "level");
+    EXPECT_EQ(groups[1].dependencies, (std::vector<std::string>{"common"}));
+    ASSERT_EQ(groups[1].resources.size(), 1u);
+    EXPECT_EQ(groups[1].resources[0].path, "grassland.png");
+
+    EXPECT_TRUE(ResourceGroupGraph::parse(YamlValue("not a map")).empty());
+}
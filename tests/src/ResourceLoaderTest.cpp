@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "resource/ResourceLoader.hpp"
+
+using namespace Tina;
+
+namespace {
+    // 不依赖 bgfx 的测试资源：decode 在工作线程执行，upload 记录所在线程
+    class FakeResource : public Resource {
+    public:
+        FakeResource(const std::string &path, size_t size, bool decodeSucceeds = true)
+            : Resource(ResourceHandle(), path, ResourceType::Unknown), m_size(size),
+              m_decodeSucceeds(decodeSucceeds) {
+        }
+
+        bool load() override { return decode() && upload(); }
+        void unload() override { m_uploaded = false; }
+        bool isLoaded() const override { return m_uploaded; }
+
+        bool decode() override {
+            decodeThread = std::this_thread::get_id();
+            return m_decodeSucceeds;
+        }
+
+        bool upload() override {
+            uploadThread = std::this_thread::get_id();
+            m_uploaded = true;
+            return true;
+        }
+
+        size_t getUploadSize() const override { return m_size; }
+
+        std::thread::id decodeThread;
+        std::thread::id uploadThread;
+
+    private:
+        size_t m_size;
+        bool m_decodeSucceeds;
+        bool m_uploaded = false;
+    };
+
+    void waitForUploadQueue(const ResourceLoader &loader, size_t count) {
+        while (loader.getPendingUploadCount() < count) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+TEST(ResourceLoaderTest, DecodesOnWorkerAndUploadsOnCaller) {
+    ResourceLoader loader(2);
+    auto resource = createRefPtr<FakeResource>("a.png", 16);
+    auto request = createRefPtr<ResourceLoadRequest>(resource);
+    loader.submit(request);
+
+    request->waitDecoded();
+    EXPECT_EQ(request->getState(), ResourceLoadState::Decoded);
+    EXPECT_NE(resource->decodeThread, std::this_thread::get_id());
+
+    std::vector<RefPtr<ResourceLoadRequest>> completed;
+    loader.processUploads(1024, completed);
+    ASSERT_EQ(completed.size(), 1u);
+    EXPECT_EQ(request->getState(), ResourceLoadState::Ready);
+    EXPECT_EQ(resource->uploadThread, std::this_thread::get_id());
+
+    ResourceFuture<FakeResource> future(request);
+    EXPECT_TRUE(future.isReady());
+    EXPECT_EQ(future.get(), resource);
+}
+
+TEST(ResourceLoaderTest, UploadsRespectByteBudget) {
+    ResourceLoader loader(1);
+    std::vector<RefPtr<ResourceLoadRequest>> requests;
+    for (int i = 0; i < 4; ++i) {
+        auto request = createRefPtr<ResourceLoadRequest>(
+            createRefPtr<FakeResource>("texture" + std::to_string(i), 100));
+        loader.submit(request);
+        requests.push_back(request);
+    }
+    waitForUploadQueue(loader, 4);
+
+    // 预算 250 字节：每帧上传两个
+    std::vector<RefPtr<ResourceLoadRequest>> completed;
+    EXPECT_EQ(loader.processUploads(250, completed), 200u);
+    EXPECT_EQ(completed.size(), 2u);
+    EXPECT_EQ(requests[1]->getState(), ResourceLoadState::Ready);
+    EXPECT_EQ(requests[2]->getState(), ResourceLoadState::Decoded);
+
+    // 单个资源超过预算时仍然至少上传一个，避免永远卡住
+    completed.clear();
+    EXPECT_EQ(loader.processUploads(10, completed), 100u);
+    EXPECT_EQ(completed.size(), 1u);
+
+    loader.finish(requests[3]);
+    EXPECT_EQ(requests[3]->getState(), ResourceLoadState::Ready);
+    EXPECT_EQ(loader.getPendingUploadCount(), 0u);
+}
+
+TEST(ResourceLoaderTest, FailedDecodeIsReported) {
+    ResourceLoader loader(1);
+    auto request = createRefPtr<ResourceLoadRequest>(createRefPtr<FakeResource>("missing.png", 0, false));
+    loader.submit(request);
+    waitForUploadQueue(loader, 1);
+
+    std::vector<RefPtr<ResourceLoadRequest>> completed;
+    loader.processUploads(1024, completed);
+    ASSERT_EQ(completed.size(), 1u);
+    EXPECT_EQ(request->getState(), ResourceLoadState::Failed);
+
+    ResourceFuture<FakeResource> future(request);
+    EXPECT_TRUE(future.isFailed());
+    EXPECT_EQ(future.wait(), nullptr);
+}
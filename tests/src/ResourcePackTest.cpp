@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "resource/ResourceData.hpp"
+#include "resource/ResourcePack.hpp"
+#include "resource/ResourcePackWriter.hpp"
+
+using namespace Tina;
+
+namespace {
+    std::vector<uint8_t> toBytes(const std::string &text) {
+        return {text.begin(), text.end()};
+    }
+
+    std::string toString(const uint8_t *data, size_t size) {
+        return {reinterpret_cast<const char *>(data), size};
+    }
+
+    const std::string PACK_NAME = "resource_pack_test.pak";
+    const std::string RANDOM_BYTES = "\x01\x7f\xfe\x33\x80\x10";
+    const std::string REPEATED(50000, 'r');
+
+    void writeTestPack() {
+        ResourcePackWriter writer(64);
+        writer.add("../resources/textures/./a.png", REPEATED.data(), REPEATED.size());
+        writer.add("../resources/shaders/sprite.vs.bin", RANDOM_BYTES.data(), RANDOM_BYTES.size());
+        writer.add("../resources/config/empty.yaml", nullptr, 0);
+        writer.add("../resources/config/settings.yaml", REPEATED.data(), REPEATED.size(), false);
+        ASSERT_TRUE(writer.write(Path(PACK_NAME)));
+    }
+}
+
+TEST(ResourcePackTest, FindsAndReadsEntries) {
+    writeTestPack();
+
+    ResourcePack pack;
+    ASSERT_TRUE(pack.open(Path(PACK_NAME)));
+    EXPECT_EQ(pack.getEntryCount(), 4u);
+    for (size_t i = 1; i < pack.getEntryCount(); ++i) {
+        EXPECT_LT(pack.getEntry(i - 1).id, pack.getEntry(i).id);
+    }
+
+    // 查找使用规范化路径的 id
+    const ResourcePack::Entry *texture = pack.find(ResourceId("../resources/textures/a.png"));
+    ASSERT_NE(texture, nullptr);
+    EXPECT_EQ(pack.getPath(*texture), "../resources/textures/a.png");
+    EXPECT_TRUE(texture->flags & ResourcePack::Compressed);
+    EXPECT_LT(texture->size, texture->originalSize);
+    EXPECT_EQ(texture->offset % 64, 0u);
+
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(pack.read(*texture, data));
+    EXPECT_EQ(toString(data.data(), data.size()), REPEATED);
+
+    // 压缩后没有变小的数据按原样存储
+    const ResourcePack::Entry *shader = pack.find(ResourceId("../resources/shaders/sprite.vs.bin"));
+    ASSERT_NE(shader, nullptr);
+    EXPECT_FALSE(shader->flags & ResourcePack::Compressed);
+    const ByteView view = pack.getData(*shader);
+    EXPECT_EQ(toString(view.data(), view.size()), RANDOM_BYTES);
+
+    const ResourcePack::Entry *empty = pack.find(ResourceId("../resources/config/empty.yaml"));
+    ASSERT_NE(empty, nullptr);
+    ASSERT_TRUE(pack.read(*empty, data));
+    EXPECT_TRUE(data.empty());
+
+    EXPECT_EQ(pack.find(ResourceId("../resources/textures/missing.png")), nullptr);
+
+    pack.close();
+    std::remove(PACK_NAME.c_str());
+}
+
+TEST(ResourcePackTest, ResourceDataUsesMountedPacks) {
+    writeTestPack();
+
+    auto pack = createRefPtr<ResourcePack>();
+    ASSERT_TRUE(pack->open(Path(PACK_NAME)));
+    ResourcePack::mount(pack);
+
+    // 未压缩的条目直接引用包的映射内存
+    auto stored = ResourceData::open("../resources/config/settings.yaml");
+    ASSERT_NE(stored, nullptr);
+    EXPECT_TRUE(stored->isFromPack());
+    const ResourcePack::Entry *entry = pack->find(ResourceId("../resources/config/settings.yaml"));
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(stored->data(), pack->getData(*entry).data());
+    EXPECT_EQ(toString(stored->data(), stored->size()), REPEATED);
+
+    auto compressed = ResourceData::open("..\\resources\\textures\\a.png");
+    ASSERT_NE(compressed, nullptr);
+    EXPECT_EQ(toString(compressed->data(), compressed->size()), REPEATED);
+
+    // 数据持有资源包，卸载后仍然有效
+    ResourcePack::unmount(pack);
+    pack.reset();
+    EXPECT_EQ(toString(stored->data(), stored->size()), REPEATED);
+    EXPECT_EQ(ResourceData::open("../resources/config/settings.yaml"), nullptr);
+    stored.reset();
+
+    // 包中没有时读取磁盘上的文件
+    auto loose = ResourceData::open(PACK_NAME);
+    ASSERT_NE(loose, nullptr);
+    EXPECT_FALSE(loose->isFromPack());
+    EXPECT_GT(loose->size(), REPEATED.size());
+
+    loose.reset();
+    std::remove(PACK_NAME.c_str());
+}
+
+TEST(ResourcePackTest, LaterMountsTakePriority) {
+    const std::vector<uint8_t> first = toBytes("first");
+    const std::vector<uint8_t> second = toBytes("second");
+    ResourcePackWriter firstWriter;
+    firstWriter.add("a.txt", first.data(), first.size());
+    ASSERT_TRUE(firstWriter.write(Path("resource_pack_first.pak")));
+    ResourcePackWriter secondWriter;
+    secondWriter.add("./a.txt", second.data(), second.size());
+    ASSERT_TRUE(secondWriter.write(Path("resource_pack_second.pak")));
+
+    auto firstPack = createRefPtr<ResourcePack>();
+    auto secondPack = createRefPtr<ResourcePack>();
+    ASSERT_TRUE(firstPack->open(Path("resource_pack_first.pak")));
+    ASSERT_TRUE(secondPack->open(Path("resource_pack_second.pak")));
+    ResourcePack::mount(firstPack);
+    ResourcePack::mount(secondPack);
+
+    const ResourcePack::Entry *entry = nullptr;
+    EXPECT_EQ(ResourcePack::findMounted(ResourceId("a.txt"), entry), secondPack);
+    ResourcePack::unmount(secondPack);
+    EXPECT_EQ(ResourcePack::findMounted(ResourceId("a.txt"), entry), firstPack);
+    ResourcePack::unmount(firstPack);
+    EXPECT_EQ(ResourcePack::findMounted(ResourceId("a.txt"), entry), nullptr);
+    EXPECT_EQ(entry, nullptr);
+
+    firstPack.reset();
+    secondPack.reset();
+    std::remove("resource_pack_first.pak");
+    std::remove("resource_pack_second.pak");
+}
+
+TEST(ResourcePackTest, RejectsDuplicatesAndCorruptFiles) {
+    const std::vector<uint8_t> data = toBytes("data");
+    ResourcePackWriter writer;
+    writer.add("textures/a.png", data.data(), data.size());
+    writer.add("textures/ui/../a.png", data.data(), data.size());
+    EXPECT_THROW(writer.write(Path("resource_pack_duplicate.pak")), std::runtime_error);
+
+    writeTestPack();
+    {
+        // 截断数据块后索引越界
+        std::ifstream in(PACK_NAME, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(PACK_NAME, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(content.size() - 10));
+    }
+    ResourcePack pack;
+    EXPECT_FALSE(pack.open(Path(PACK_NAME)));
+    EXPECT_FALSE(pack.isOpen());
+
+    {
+        std::ofstream out(PACK_NAME, std::ios::binary | std::ios::trunc);
+        out << "not a resource pack at all, just some text that is long enough";
+    }
+    EXPECT_FALSE(pack.open(Path(PACK_NAME)));
+    std::remove(PACK_NAME.c_str());
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "resource/ResourcePath.hpp"
+
+#include <stdexcept>
+
+using namespace Tina;
+
+// id 可以在编译期求值
+static_assert(ResourceId("textures/a.png") == ResourceId("./textures//a.png"));
+static_assert("textures/a.png"_res.id == ResourceId("textures/a.png"));
+static_assert(ResourceId("textures/a.png") != ResourceId("textures/b.png"));
+
+TEST(ResourcePathTest, NormalizesPaths) {
+    EXPECT_EQ(ResourcePath::normalize("./a.png"), "a.png");
+    EXPECT_EQ(ResourcePath::normalize("textures//a.png"), "textures/a.png");
+    EXPECT_EQ(ResourcePath::normalize("textures\\ui\\a.png"), "textures/ui/a.png");
+    EXPECT_EQ(ResourcePath::normalize("textures/ui/../a.png"), "textures/a.png");
+    EXPECT_EQ(ResourcePath::normalize("../resources/./a.png"), "../resources/a.png");
+    EXPECT_EQ(ResourcePath::normalize("a/../../b"), "../b");
+    EXPECT_EQ(ResourcePath::normalize("/a/../../b"), "/b");
+    EXPECT_EQ(ResourcePath::normalize("textures/"), "textures");
+}
+
+TEST(ResourcePathTest, EquivalentPathsShareId) {
+    const char *paths[] = {
+        "a.png", "./a.png", "textures//a.png", "textures\\ui\\a.png", "textures/ui/../a.png",
+        "../resources/./a.png", "a/../../b", "/a/../../b", "../../a/b/../c", "/", "",
+    };
+    for (const char *path: paths) {
+        EXPECT_EQ(ResourceId(path), ResourceId(ResourcePath::normalize(path))) << path;
+    }
+}
+
+TEST(ResourcePathTest, DistinctPathsHaveDistinctIds) {
+    EXPECT_NE(ResourceId("a.png"), ResourceId("/a.png"));
+    EXPECT_NE(ResourceId("a/b.png"), ResourceId("b/a.png"));
+    EXPECT_NE(ResourceId("ab/c"), ResourceId("a/bc"));
+    EXPECT_NE(ResourceId("../a.png"), ResourceId("a.png"));
+    EXPECT_TRUE(ResourceId("").isValid());
+    EXPECT_FALSE(ResourceId().isValid());
+}
+
+TEST(ResourcePathTest, LiteralKeepsOriginalPath) {
+    constexpr ResourcePath path = "./textures/a.png"_res;
+    EXPECT_EQ(path.path, "./textures/a.png");
+    EXPECT_EQ(path.id, ResourceId("textures/a.png"));
+}
+
+TEST(ResourcePathTest, CollisionCheckThrowsOnSharedId) {
+    if (!ResourcePath::isCollisionCheckEnabled()) {
+        GTEST_SKIP() << "collision check is only enabled in debug builds";
+    }
+    const ResourcePath first("collision/first.png");
+    ResourcePath second("collision/second.png");
+    // 两个不同的路径强制使用同一个 id，模拟哈希冲突
+    second.id = first.id;
+
+    EXPECT_NO_THROW(first.checkCollision());
+    EXPECT_NO_THROW(ResourcePath("./collision//first.png").checkCollision());
+    EXPECT_THROW(second.checkCollision(), std::runtime_error);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "graphics/SkylinePacker.hpp"
+
+using namespace Tina;
+
+namespace {
+    bool overlaps(const SkylinePacker::Rect &a, const SkylinePacker::Rect &b) {
+        return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+}
+
+TEST(SkylinePackerTest, PlacesBottomLeft) {
+    SkylinePacker packer(100, 100);
+    SkylinePacker::Rect a{}, b{}, c{};
+    ASSERT_TRUE(packer.insert(60, 20, a));
+    ASSERT_TRUE(packer.insert(40, 10, b));
+    ASSERT_TRUE(packer.insert(40, 30, c));
+
+    EXPECT_EQ(a.x, 0);
+    EXPECT_EQ(a.y, 0);
+    EXPECT_EQ(b.x, 60);
+    EXPECT_EQ(b.y, 0);
+    // 放在较低的右侧轮廓上
+    EXPECT_EQ(c.x, 60);
+    EXPECT_EQ(c.y, 10);
+}
+
+TEST(SkylinePackerTest, FillsExactly) {
+    SkylinePacker packer(64, 64);
+    SkylinePacker::Rect rect{};
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_TRUE(packer.insert(16, 16, rect)) << i;
+    }
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), 1.0f);
+    EXPECT_FALSE(packer.insert(1, 1, rect));
+}
+
+TEST(SkylinePackerTest, RejectsOversized) {
+    SkylinePacker packer(32, 32);
+    SkylinePacker::Rect rect{};
+    EXPECT_FALSE(packer.insert(33, 1, rect));
+    EXPECT_FALSE(packer.insert(1, 33, rect));
+    EXPECT_FALSE(packer.insert(0, 4, rect));
+    EXPECT_TRUE(packer.insert(32, 32, rect));
+
+    packer.reset(32, 32);
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), 0.0f);
+    EXPECT_TRUE(packer.insert(32, 32, rect));
+}
+
+TEST(SkylinePackerTest, RandomRectsDoNotOverlap) {
+    SkylinePacker packer(512, 512);
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> size(4, 64);
+
+    std::vector<SkylinePacker::Rect> placed;
+    for (int i = 0; i < 1000; ++i) {
+        SkylinePacker::Rect rect{};
+        if (!packer.insert(static_cast<uint16_t>(size(random)), static_cast<uint16_t>(size(random)), rect)) {
+            continue;
+        }
+        EXPECT_LE(rect.x + rect.width, 512);
+        EXPECT_LE(rect.y + rect.height, 512);
+        for (const auto &other: placed) {
+            ASSERT_FALSE(overlaps(rect, other));
+        }
+        placed.push_back(rect);
+    }
+    EXPECT_GT(placed.size(), 100u);
+    EXPECT_GT(packer.getOccupancy(), 0.6f);
+}
+
+TEST(SkylinePackerTest, ReusesRemovedRects) {
+    SkylinePacker packer(64, 64);
+    SkylinePacker::Rect rects[16]{};
+    for (auto &rect: rects) {
+        ASSERT_TRUE(packer.insert(16, 16, rect));
+    }
+    SkylinePacker::Rect rect{};
+    ASSERT_FALSE(packer.insert(16, 16, rect));
+
+    // 同样大小的矩形放回原处，例如热重载后的纹理
+    packer.remove(rects[5]);
+    ASSERT_TRUE(packer.insert(16, 16, rect));
+    EXPECT_EQ(rect.x, rects[5].x);
+    EXPECT_EQ(rect.y, rects[5].y);
+
+    // 较小的矩形切分空闲块，剩余部分仍可使用
+    packer.remove(rects[9]);
+    SkylinePacker::Rect small[4]{};
+    for (auto &part: small) {
+        ASSERT_TRUE(packer.insert(8, 8, part));
+    }
+    EXPECT_FALSE(packer.insert(8, 8, rect));
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), 1.0f);
+
+    // 全部释放后整体重置
+    for (int i = 0; i < 16; ++i) {
+        if (i != 9) {
+            packer.remove(rects[i]);
+        }
+    }
+    for (const auto &part: small) {
+        packer.remove(part);
+    }
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), 0.0f);
+    EXPECT_TRUE(packer.insert(64, 64, rect));
+}
+
+TEST(SkylinePackerTest, RandomInsertAndRemoveDoNotOverlap) {
+    SkylinePacker packer(256, 256);
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> size(4, 48);
+
+    std::vector<SkylinePacker::Rect> placed;
+    for (int i = 0; i < 2000; ++i) {
+        if (!placed.empty() && random() % 3 == 0) {
+            const size_t index = random() % placed.size();
+            packer.remove(placed[index]);
+            placed.erase(placed.begin() + static_cast<std::ptrdiff_t>(index));
+            continue;
+        }
+        SkylinePacker::Rect rect{};
+        if (!packer.insert(static_cast<uint16_t>(size(random)), static_cast<uint16_t>(size(random)), rect)) {
+            continue;
+        }
+        EXPECT_LE(rect.x + rect.width, 256);
+        EXPECT_LE(rect.y + rect.height, 256);
+        for (const auto &other: placed) {
+            ASSERT_FALSE(overlaps(rect, other));
+        }
+        placed.push_back(rect);
+    }
+    EXPECT_GT(placed.size(), 10u);
+}
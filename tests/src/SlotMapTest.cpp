@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "base/SlotMap.hpp"
+
+using namespace Tina;
+
+TEST(SlotMapTest, InsertAndGet) {
+    SlotMap<std::string> map;
+    const auto a = map.insert("a");
+    const auto b = map.insert("b");
+
+    EXPECT_NE(a, SlotMap<std::string>::INVALID_KEY);
+    EXPECT_NE(a, b);
+    ASSERT_NE(map.get(a), nullptr);
+    EXPECT_EQ(*map.get(a), "a");
+    EXPECT_EQ(*map.get(b), "b");
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.get(SlotMap<std::string>::INVALID_KEY), nullptr);
+}
+
+TEST(SlotMapTest, EraseInvalidatesKeyAndKeepsOthers) {
+    SlotMap<int> map;
+    const auto a = map.insert(1);
+    const auto b = map.insert(2);
+    const auto c = map.insert(3);
+
+    EXPECT_TRUE(map.erase(a));
+    EXPECT_FALSE(map.erase(a));
+    EXPECT_FALSE(map.contains(a));
+    EXPECT_EQ(*map.get(b), 2);
+    EXPECT_EQ(*map.get(c), 3);
+
+    // 被删除的槽位复用时代数变化，旧键不会取到新元素
+    const auto d = map.insert(4);
+    EXPECT_EQ(SlotMap<int>::getIndex(d), SlotMap<int>::getIndex(a));
+    EXPECT_NE(SlotMap<int>::getGeneration(d), SlotMap<int>::getGeneration(a));
+    EXPECT_EQ(map.get(a), nullptr);
+    EXPECT_EQ(*map.get(d), 4);
+}
+
+TEST(SlotMapTest, ValuesStayDense) {
+    SlotMap<int> map;
+    const auto a = map.insert(1);
+    map.insert(2);
+    map.insert(3);
+    map.erase(a);
+
+    int sum = 0;
+    for (const int value : map) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 5);
+
+    for (size_t i = 0; i < map.size(); ++i) {
+        EXPECT_EQ(*map.get(map.keyAt(i)), map.valueAt(i));
+    }
+}
+
+TEST(SlotMapTest, ClearInvalidatesAllKeys) {
+    SlotMap<int> map;
+    const auto a = map.insert(1);
+    const auto b = map.insert(2);
+    map.clear();
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.get(a), nullptr);
+    EXPECT_EQ(map.get(b), nullptr);
+    const auto c = map.insert(3);
+    EXPECT_EQ(*map.get(c), 3);
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(SlotMapTest, GenerationWrapsWithoutZeroKeys) {
+    using SmallMap = SlotMap<int, 4, 2>;
+    SmallMap map;
+    auto key = map.insert(0);
+    for (int i = 0; i < 10; ++i) {
+        map.erase(key);
+        key = map.insert(i);
+        EXPECT_NE(key, SmallMap::INVALID_KEY);
+        EXPECT_NE(SmallMap::getGeneration(key), 0u);
+    }
+}
+
+TEST(SlotMapTest, InsertFailsWhenFull) {
+    using SmallMap = SlotMap<int, 2, 8>;
+    SmallMap map;
+    for (uint32_t i = 0; i < SmallMap::MAX_SIZE; ++i) {
+        EXPECT_NE(map.insert(static_cast<int>(i)), SmallMap::INVALID_KEY);
+    }
+    EXPECT_EQ(map.insert(99), SmallMap::INVALID_KEY);
+}
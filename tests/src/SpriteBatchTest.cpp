@@ -0,0 +1,275 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "core/ThreadPool.hpp"
+#include "graphics/SpriteBatch.hpp"
+
+using namespace Tina;
+
+namespace {
+    SpriteBatch::Sprite makeSprite(float x, uint32_t abgr = 0xffffffff) {
+        return {x, 0.0f, 10.0f, 20.0f, 0.0f, 0.0f, 1.0f, 1.0f, abgr};
+    }
+
+    std::vector<float> sortedX(const SpriteBatch &batch) {
+        std::vector<SpriteVertex> vertices(batch.getSpriteCount() * SpriteBatch::VERTICES_PER_SPRITE);
+        batch.writeVertices(0, static_cast<uint32_t>(batch.getSpriteCount()), vertices.data());
+        std::vector<float> result;
+        for (size_t i = 0; i < vertices.size(); i += SpriteBatch::VERTICES_PER_SPRITE) {
+            result.push_back(vertices[i].m_x);
+        }
+        return result;
+    }
+}
+
+TEST(SpriteBatchTest, SortsByLayerThenState) {
+    SpriteBatch batch;
+    const SpriteBatchState a{1, 7, 0};
+    const SpriteBatchState b{2, 7, 0};
+
+    batch.add(0, b, makeSprite(0));
+    batch.add(0, a, makeSprite(1));
+    batch.add(-1, b, makeSprite(2));
+    batch.add(0, b, makeSprite(3));
+    batch.add(0, a, makeSprite(4));
+    batch.add(1, a, makeSprite(5));
+    batch.sort();
+
+    // 负的层在前，同状态内保持提交顺序
+    EXPECT_EQ(sortedX(batch), (std::vector<float>{2, 1, 4, 0, 3, 5}));
+
+    // 每个绘制段只有一个纹理槽位时，纹理变化就要开始新的绘制段
+    const auto &draws = batch.getDraws();
+    ASSERT_EQ(draws.size(), 4u);
+    EXPECT_EQ(draws[0].textures[0], 2);
+    EXPECT_EQ(draws[0].spriteCount, 1u);
+    EXPECT_EQ(draws[1].textures[0], 1);
+    EXPECT_EQ(draws[1].firstSprite, 1u);
+    EXPECT_EQ(draws[1].spriteCount, 2u);
+    EXPECT_EQ(draws[2].textures[0], 2);
+    EXPECT_EQ(draws[2].spriteCount, 2u);
+    EXPECT_EQ(draws[3].textures[0], 1);
+    EXPECT_EQ(draws[3].textureCount, 1);
+    EXPECT_EQ(draws[3].program, 7);
+    EXPECT_EQ(draws[3].firstSprite, 5u);
+}
+
+TEST(SpriteBatchTest, SharesDrawAcrossTextureStages) {
+    SpriteBatch batch;
+    batch.add(0, {3, 7, 0}, makeSprite(0));
+    batch.add(0, {1, 7, 0}, makeSprite(1));
+    batch.add(0, {UINT16_MAX, 7, 0}, makeSprite(2));
+    batch.add(0, {2, 7, 0}, makeSprite(3));
+    batch.add(1, {1, 7, 0}, makeSprite(4));
+    batch.add(1, {4, 7, 0}, makeSprite(5));
+    batch.add(1, {1, 8, 0}, makeSprite(6));
+    batch.sort(3);
+
+    EXPECT_EQ(sortedX(batch), (std::vector<float>{1, 3, 0, 2, 4, 5, 6}));
+
+    // 纹理 1、2、3 占满三个槽位，没有纹理的精灵和下一层已绑定的纹理 1 仍在同一段；
+    // 纹理 4 和不同的程序各自开始新的绘制段
+    const auto &draws = batch.getDraws();
+    ASSERT_EQ(draws.size(), 3u);
+    EXPECT_EQ(draws[0].textureCount, 3);
+    EXPECT_EQ(draws[0].textures[0], 1);
+    EXPECT_EQ(draws[0].textures[1], 2);
+    EXPECT_EQ(draws[0].textures[2], 3);
+    EXPECT_EQ(draws[0].spriteCount, 5u);
+    EXPECT_EQ(draws[1].textureCount, 1);
+    EXPECT_EQ(draws[1].textures[0], 4);
+    EXPECT_EQ(draws[1].firstSprite, 5u);
+    EXPECT_EQ(draws[2].program, 8);
+    EXPECT_EQ(draws[2].firstSprite, 6u);
+
+    std::vector<SpriteVertex> vertices(batch.getSpriteCount() * SpriteBatch::VERTICES_PER_SPRITE);
+    batch.writeVertices(0, static_cast<uint32_t>(batch.getSpriteCount()), vertices.data());
+    std::vector<float> stages;
+    for (size_t i = 0; i < vertices.size(); i += SpriteBatch::VERTICES_PER_SPRITE) {
+        EXPECT_EQ(vertices[i].m_texture, vertices[i + 3].m_texture);
+        stages.push_back(vertices[i].m_texture);
+    }
+    EXPECT_EQ(stages, (std::vector<float>{0, 1, 2, SpriteBatch::NO_TEXTURE_STAGE, 0, 0, 0}));
+
+    SpriteInstance instances[7];
+    batch.writeInstances(0, 7, instances);
+    EXPECT_FLOAT_EQ(instances[2].texture, 2.0f);
+
+    // 槽位数超出上限时按上限处理
+    batch.sort(255);
+    EXPECT_EQ(batch.getDraws().size(), 2u);
+}
+
+TEST(SpriteBatchTest, StateRoundTripsThroughKey) {
+    SpriteBatch batch;
+    batch.add(INT16_MIN, {UINT16_MAX, 0x1234, 0xff}, makeSprite(0));
+    batch.add(INT16_MAX, {0, UINT16_MAX, 2}, makeSprite(1));
+    batch.sort();
+
+    const auto &draws = batch.getDraws();
+    ASSERT_EQ(draws.size(), 2u);
+    // 无效纹理不占用槽位
+    EXPECT_EQ(draws[0].textureCount, 0);
+    EXPECT_EQ(draws[0].program, 0x1234);
+    EXPECT_EQ(draws[0].blend, 0xff);
+    EXPECT_EQ(draws[1].textureCount, 1);
+    EXPECT_EQ(draws[1].textures[0], 0);
+    EXPECT_EQ(draws[1].program, UINT16_MAX);
+    EXPECT_EQ(draws[1].blend, 2);
+
+    EXPECT_LT(SpriteBatch::makeKey(-1, {UINT16_MAX, UINT16_MAX, 0xff}), SpriteBatch::makeKey(0, {0, 0, 0}));
+}
+
+TEST(SpriteBatchTest, WritesQuads) {
+    SpriteBatch batch;
+    batch.add(0, {0, 0, 0}, {5.0f, 6.0f, 10.0f, 20.0f, 0.25f, 0.5f, 0.75f, 1.0f, 0xff00ff00});
+    batch.sort();
+
+    SpriteVertex vertices[4];
+    batch.writeVertices(0, 1, vertices);
+    EXPECT_FLOAT_EQ(vertices[0].m_x, 5.0f);
+    EXPECT_FLOAT_EQ(vertices[0].m_y, 6.0f);
+    EXPECT_FLOAT_EQ(vertices[0].m_u, 0.25f);
+    EXPECT_FLOAT_EQ(vertices[0].m_v, 0.5f);
+    EXPECT_FLOAT_EQ(vertices[3].m_x, 15.0f);
+    EXPECT_FLOAT_EQ(vertices[3].m_y, 26.0f);
+    EXPECT_FLOAT_EQ(vertices[3].m_u, 0.75f);
+    EXPECT_FLOAT_EQ(vertices[3].m_v, 1.0f);
+    EXPECT_EQ(vertices[2].m_rgba, 0xff00ff00u);
+
+    uint16_t indices16[12];
+    SpriteBatch::writeIndices(2, indices16);
+    const uint16_t expected16[12] = {0, 1, 2, 1, 3, 2, 4, 5, 6, 5, 7, 6};
+    EXPECT_TRUE(std::equal(std::begin(indices16), std::end(indices16), std::begin(expected16)));
+
+    // 超过 16 位范围的顶点编号
+    std::vector<uint32_t> indices32(20000 * SpriteBatch::INDICES_PER_SPRITE);
+    SpriteBatch::writeIndices(20000, indices32.data());
+    EXPECT_EQ(indices32.back(), 19999u * 4 + 2);
+    EXPECT_EQ(indices32[indices32.size() - 2], 19999u * 4 + 3);
+}
+
+TEST(SpriteBatchTest, RotatesAroundCenter) {
+    SpriteBatch batch;
+    SpriteBatch::Sprite sprite = makeSprite(0);
+    sprite.rotation = static_cast<float>(M_PI / 2);
+    batch.add(0, {0, 0, 0}, sprite);
+    batch.sort();
+
+    // 10x20 的矩形中心为 (5, 10)，旋转 90 度后左上角 (-5, -10) 变为 (10, -5)
+    SpriteVertex vertices[4];
+    batch.writeVertices(0, 1, vertices);
+    EXPECT_NEAR(vertices[0].m_x, 15.0f, 1e-4f);
+    EXPECT_NEAR(vertices[0].m_y, 5.0f, 1e-4f);
+    EXPECT_NEAR(vertices[3].m_x, -5.0f, 1e-4f);
+    EXPECT_NEAR(vertices[3].m_y, 15.0f, 1e-4f);
+    EXPECT_FLOAT_EQ(vertices[3].m_u, 1.0f);
+}
+
+TEST(SpriteBatchTest, WritesInstances) {
+    SpriteBatch batch;
+    batch.add(1, {0, 0, 0}, {1.0f, 2.0f, 3.0f, 4.0f, 0.0f, 0.5f, 0.5f, 1.0f, 0x80ff0000, 0.25f});
+    batch.add(0, {0, 0, 0}, makeSprite(7));
+    batch.sort();
+
+    SpriteInstance instances[2];
+    batch.writeInstances(0, 2, instances);
+    EXPECT_FLOAT_EQ(instances[0].x, 7.0f);
+
+    const SpriteInstance &instance = instances[1];
+    EXPECT_FLOAT_EQ(instance.x, 1.0f);
+    EXPECT_FLOAT_EQ(instance.height, 4.0f);
+    EXPECT_FLOAT_EQ(instance.v0, 0.5f);
+    EXPECT_FLOAT_EQ(instance.u1, 0.5f);
+    // ABGR：红 0、绿 0、蓝 255、alpha 128，两两合成 r + g * 256 和 b + a * 256
+    EXPECT_FLOAT_EQ(instance.colorRG, 0.0f);
+    EXPECT_FLOAT_EQ(instance.colorBA, 255.0f + 128.0f * 256.0f);
+    EXPECT_FLOAT_EQ(instance.rotation, 0.25f);
+}
+
+TEST(SpriteBatchTest, AppendKeepsContextOrder) {
+    SpriteBatch main;
+    SpriteBatch first;
+    SpriteBatch second;
+    main.add(0, {1, 0, 0}, makeSprite(0));
+    second.add(0, {1, 0, 0}, makeSprite(3));
+    first.add(0, {1, 0, 0}, makeSprite(1));
+    second.add(-1, {1, 0, 0}, makeSprite(4));
+    first.add(0, {1, 0, 0}, makeSprite(2));
+
+    // 追加顺序决定同状态精灵的先后，与各批次何时记录无关
+    main.append(first);
+    main.append(second);
+    main.sort();
+    EXPECT_EQ(sortedX(main), (std::vector<float>{4, 0, 1, 2, 3}));
+    EXPECT_EQ(first.getSpriteCount(), 2u);
+}
+
+TEST(SpriteBatchTest, ParallelWriteMatchesSerial) {
+    SpriteBatch batch;
+    const uint32_t count = SpriteBatch::MIN_SPRITES_PER_TASK * 3 + 17;
+    for (uint32_t i = 0; i < count; ++i) {
+        SpriteBatch::Sprite sprite = makeSprite(static_cast<float>(i), 0xff000000 | i);
+        sprite.rotation = (i % 3) * 0.5f;
+        batch.add(static_cast<int16_t>(i % 5), {static_cast<uint16_t>(i % 11), 0, 0}, sprite);
+    }
+    batch.sort(4);
+
+    ThreadPool pool(3);
+    const uint32_t first = 5;
+    const uint32_t written = count - first;
+    std::vector<SpriteVertex> serial(written * SpriteBatch::VERTICES_PER_SPRITE);
+    std::vector<SpriteVertex> parallel(serial.size());
+    batch.writeVertices(first, written, serial.data());
+    batch.writeVertices(first, written, parallel.data(), &pool);
+    EXPECT_EQ(memcmp(serial.data(), parallel.data(), serial.size() * sizeof(SpriteVertex)), 0);
+
+    std::vector<SpriteInstance> serialInstances(written);
+    std::vector<SpriteInstance> parallelInstances(written);
+    batch.writeInstances(first, written, serialInstances.data());
+    batch.writeInstances(first, written, parallelInstances.data(), &pool);
+    EXPECT_EQ(memcmp(serialInstances.data(), parallelInstances.data(), written * sizeof(SpriteInstance)), 0);
+}
+
+TEST(SpriteBatchTest, ClearResets) {
+    SpriteBatch batch;
+    batch.add(0, {0, 0, 0}, makeSprite(0));
+    batch.sort();
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    batch.sort();
+    EXPECT_TRUE(batch.getDraws().empty());
+}
+
+TEST(SpriteBatchTest, MaxSpritesPerFrameFitTransientBuffers) {
+    constexpr uint32_t count = SpriteBatch::MAX_SPRITES_PER_FRAME;
+    SpriteBatch batch;
+    batch.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        batch.add(0, {static_cast<uint16_t>(i % 16), 7, 0}, makeSprite(static_cast<float>(i)));
+    }
+    batch.sort(SpriteBatch::MAX_TEXTURE_STAGES);
+
+    // 绘制段连续覆盖所有精灵
+    uint32_t covered = 0;
+    for (const auto &draw: batch.getDraws()) {
+        EXPECT_EQ(draw.firstSprite, covered);
+        covered += draw.spriteCount;
+    }
+    EXPECT_EQ(covered, count);
+
+    // 一次分配即可写出整帧的顶点和 32 位索引，Renderer2D 不会丢弃精灵
+    std::vector<SpriteVertex> vertices(SpriteBatch::TRANSIENT_VERTEX_BUFFER_SIZE / sizeof(SpriteVertex));
+    ASSERT_GE(vertices.size(), size_t{count} * SpriteBatch::VERTICES_PER_SPRITE);
+    batch.writeVertices(0, count, vertices.data());
+    EXPECT_FLOAT_EQ(vertices[(count - 1) * SpriteBatch::VERTICES_PER_SPRITE].m_x, static_cast<float>(count - 1));
+
+    std::vector<uint32_t> indices(SpriteBatch::TRANSIENT_INDEX_BUFFER_SIZE / sizeof(uint32_t));
+    ASSERT_GE(indices.size(), size_t{count} * SpriteBatch::INDICES_PER_SPRITE);
+    SpriteBatch::writeIndices(count, indices.data());
+    EXPECT_EQ(*std::max_element(indices.begin(), indices.end()), count * SpriteBatch::VERTICES_PER_SPRITE - 1);
+
+    std::vector<SpriteInstance> instances(SpriteBatch::TRANSIENT_VERTEX_BUFFER_SIZE / sizeof(SpriteInstance));
+    ASSERT_GE(instances.size(), size_t{count});
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <fmt/format.h>
+#include "base/StringBuilder.hpp"
+
+using namespace Tina;
+
+TEST(StringBuilderTest, AppendAcrossChunks)
+{
+    StringBuilder builder(64);
+    std::string expected;
+    for (int i = 0; i < 100; ++i)
+    {
+        const std::string line = "line " + std::to_string(i) + "\n";
+        builder.append(line);
+        expected += line;
+    }
+
+    EXPECT_EQ(builder.size(), expected.size());
+    EXPECT_GT(builder.getChunkCount(), 1);
+    EXPECT_EQ(builder.toString(), expected);
+}
+
+TEST(StringBuilderTest, SegmentsCoverContentInOrder)
+{
+    StringBuilder builder(64);
+    builder.append(std::string(150, 'a'));
+    builder.append("tail");
+
+    std::string joined;
+    size_t total = 0;
+    for (const auto segment : builder.getSegments())
+    {
+        joined.append(segment);
+        total += segment.size();
+    }
+    EXPECT_EQ(total, builder.size());
+    EXPECT_EQ(joined, std::string(150, 'a') + "tail");
+}
+
+TEST(StringBuilderTest, LargeAppendUsesSingleChunk)
+{
+    StringBuilder builder(64);
+    builder.append(std::string(1000, 'x'));
+    EXPECT_EQ(builder.getChunkCount(), 1);
+    EXPECT_EQ(builder.getSegments().size(), 1);
+    EXPECT_EQ(builder.getSegments()[0].size(), 1000);
+}
+
+TEST(StringBuilderTest, MixedAppends)
+{
+    StringBuilder builder;
+    builder << "key" << ':' << ' ';
+    builder.append(String("value"));
+    builder.append(3, '!');
+    builder.append(static_cast<const char*>(nullptr));
+    fmt::format_to(std::back_inserter(builder), " {}={}", "width", 1280);
+
+    EXPECT_EQ(builder.toString(), "key: value!!! width=1280");
+    EXPECT_EQ(builder.toTinaString(), "key: value!!! width=1280");
+}
+
+TEST(StringBuilderTest, CopyToBuffer)
+{
+    StringBuilder builder(64);
+    builder.append(std::string(200, 'z'));
+    std::string buffer(builder.size(), '\0');
+    builder.copyTo(buffer.data());
+    EXPECT_EQ(buffer, std::string(200, 'z'));
+}
+
+TEST(StringBuilderTest, ClearKeepsFirstChunk)
+{
+    StringBuilder builder(64);
+    builder.append(std::string(500, 'q'));
+    builder.append(std::string(500, 'q'));
+    builder.clear();
+
+    EXPECT_TRUE(builder.empty());
+    EXPECT_EQ(builder.getChunkCount(), 1);
+    EXPECT_EQ(builder.toString(), "");
+    EXPECT_TRUE(builder.toTinaString().empty());
+
+    builder.append("again");
+    EXPECT_EQ(builder.toString(), "again");
+}
+
+TEST(StringBuilderTest, MoveTransfersContent)
+{
+    StringBuilder builder(64);
+    builder.append("moved content");
+
+    StringBuilder moved(std::move(builder));
+    EXPECT_EQ(moved.toString(), "moved content");
+    EXPECT_TRUE(builder.empty());
+
+    StringBuilder assigned;
+    assigned.append("old");
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.toString(), "moved content");
+}
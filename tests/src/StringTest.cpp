@@ -2,7 +2,10 @@
 // Created by wuxianggujun on 2025/1/26.
 //
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 #include "base/String.hpp"
+#include "base/StringSearch.hpp"
 
 using namespace Tina;
 
@@ -253,3 +256,108 @@ TEST_F(StringTest, SSOTest) {
     EXPECT_EQ(StringMemoryPool::getInstance().getStats().totalAllocations, 0);
 }
 
+TEST_F(StringTest, MemoryPoolReusesFreedBlock) {
+    auto& pool = StringMemoryPool::getInstance();
+    char* first = pool.allocate(100);
+    pool.deallocate(first, 100);
+
+    // 同一尺寸类的块被立即复用，且实际可用大小是整个尺寸类
+    char* second = pool.allocate(StringMemoryPool::MEDIUM_STRING_SIZE);
+    EXPECT_EQ(first, second);
+    std::memset(second, 'x', StringMemoryPool::MEDIUM_STRING_SIZE);
+    pool.deallocate(second, StringMemoryPool::MEDIUM_STRING_SIZE);
+}
+
+TEST_F(StringTest, MemoryPoolIsThreadSafe) {
+    constexpr int threadCount = 8;
+    constexpr int iterations = 2000;
+
+    // 每个线程创建的字符串交给下一个线程释放，覆盖跨线程归还的路径
+    std::vector<std::vector<String>> produced(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&produced, t] {
+            for (int i = 0; i < iterations; ++i) {
+                String s(std::string(static_cast<size_t>(20 + (i * 37) % 480), static_cast<char>('a' + t)));
+                s += "tail";
+                produced[t].push_back(std::move(s));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&produced, t] {
+            auto& strings = produced[(t + 1) % threadCount];
+            for (const auto& s : strings) {
+                EXPECT_EQ(s[0], static_cast<char>('a' + (t + 1) % threadCount));
+            }
+            strings.clear();
+            strings.shrink_to_fit();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto stats = StringMemoryPool::getInstance().getStats();
+    EXPECT_EQ(stats.currentAllocations, 0);
+    EXPECT_EQ(stats.currentMemoryUsed, 0);
+    EXPECT_GE(stats.totalAllocations, threadCount * iterations);
+}
+
+TEST_F(StringTest, FindCharTest) {
+    String path("resources/textures/player.png");
+    EXPECT_EQ(path.find('/'), 9);
+    EXPECT_EQ(path.find('/', 10), 18);
+    EXPECT_EQ(path.rfind('/'), 18);
+    EXPECT_EQ(path.rfind('.'), 25);
+    EXPECT_EQ(path.rfind('/', 17), 9);
+    EXPECT_EQ(path.find('#'), String::npos);
+    EXPECT_EQ(String().rfind('a'), String::npos);
+}
+
+// 每个 SIMD 级别的结果都与 std::string 一致，覆盖块边界和尾部
+TEST_F(StringTest, SimdSearchMatchesStdString) {
+    using StringSearch::SimdLevel;
+    const SimdLevel original = StringSearch::getSimdLevel();
+
+    std::string text;
+    for (int i = 0; i < 300; ++i) {
+        text += static_cast<char>('a' + (i * 7) % 5);
+        if (i % 37 == 0) text += "needle";
+        if (i % 53 == 0) text += '.';
+    }
+    const char* needles[] = {"needle", "ne", "e", ".", "abc", "needles", "zzz", "cb.", "aeb"};
+
+    for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        StringSearch::setSimdLevel(level);
+        for (size_t length = 0; length <= text.size(); length += 7) {
+            const std::string reference = text.substr(0, length);
+            const String s(reference);
+            for (const char* needle : needles) {
+                for (size_t pos = 0; pos <= length; pos += 5) {
+                    EXPECT_EQ(s.find(needle, pos), reference.find(needle, pos));
+                    EXPECT_EQ(s.rfind(needle, pos), reference.rfind(needle, pos));
+                }
+                EXPECT_EQ(s.rfind(needle), reference.rfind(needle));
+            }
+            EXPECT_EQ(s.find('.'), reference.find('.'));
+            EXPECT_EQ(s.rfind('.'), reference.rfind('.'));
+
+            String copy(reference);
+            EXPECT_TRUE(s == copy);
+            if (length > 0) {
+                copy[length - 1] = '#';
+                EXPECT_FALSE(s == copy);
+                EXPECT_FALSE(s == copy.c_str());
+            }
+            EXPECT_TRUE(s == reference.c_str());
+        }
+    }
+
+    StringSearch::setSimdLevel(original);
+}
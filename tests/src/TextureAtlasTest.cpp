@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <bgfx/bgfx.h>
+#include "graphics/TextureAtlas.hpp"
+
+using namespace Tina;
+
+namespace {
+    // 图集需要创建和更新纹理，使用不渲染的 Noop 后端
+    class TextureAtlasTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            bgfx::Init init;
+            init.type = bgfx::RendererType::Noop;
+            init.resolution.width = 1;
+            init.resolution.height = 1;
+            ASSERT_TRUE(bgfx::init(init));
+        }
+
+        void TearDown() override {
+            bgfx::shutdown();
+        }
+
+        // 64x64 的页，子图四周各留 1 像素，30x30 的子图正好放下 4 个
+        static constexpr uint16_t PAGE_SIZE = 64;
+        static constexpr uint16_t ENTRY_SIZE = 30;
+        const std::vector<uint8_t> m_pixels = std::vector<uint8_t>(ENTRY_SIZE * ENTRY_SIZE * 4, 0xff);
+    };
+
+    bool isSameRegion(const TextureRegion &a, const TextureRegion &b) {
+        return a.texture.idx == b.texture.idx && a.u0 == b.u0 && a.v0 == b.v0 && a.u1 == b.u1 && a.v1 == b.v1;
+    }
+}
+
+TEST_F(TextureAtlasTest, RemovedRegionIsReusedOnlyAfterEndFrame) {
+    TextureAtlas atlas(PAGE_SIZE, PAGE_SIZE, 1);
+    TextureRegion regions[4];
+    for (auto &region: regions) {
+        ASSERT_TRUE(atlas.add(ENTRY_SIZE, ENTRY_SIZE, m_pixels.data(), region));
+    }
+    ASSERT_EQ(atlas.getPageCount(), 1u);
+
+    // 本帧的绘制可能还在采样被释放的区域，新子图不能覆盖它，只能放到新的一页
+    atlas.remove(regions[0]);
+    TextureRegion sameFrame;
+    ASSERT_TRUE(atlas.add(ENTRY_SIZE, ENTRY_SIZE, m_pixels.data(), sameFrame));
+    EXPECT_EQ(atlas.getPageCount(), 2u);
+    for (const auto &region: regions) {
+        EXPECT_FALSE(isSameRegion(sameFrame, region));
+    }
+
+    // endFrame 之后释放的区域可以复用
+    atlas.endFrame();
+    TextureRegion nextFrame;
+    ASSERT_TRUE(atlas.add(ENTRY_SIZE, ENTRY_SIZE, m_pixels.data(), nextFrame));
+    EXPECT_EQ(atlas.getPageCount(), 2u);
+    EXPECT_TRUE(isSameRegion(nextFrame, regions[0]));
+}
+
+TEST_F(TextureAtlasTest, ClearDropsPendingRemovals) {
+    TextureAtlas atlas(PAGE_SIZE, PAGE_SIZE, 1);
+    TextureRegion region;
+    ASSERT_TRUE(atlas.add(ENTRY_SIZE, ENTRY_SIZE, m_pixels.data(), region));
+    atlas.remove(region);
+    atlas.clear();
+    EXPECT_EQ(atlas.getPageCount(), 0u);
+
+    // 待释放的区域属于已销毁的页，endFrame 不会把它交给新的页
+    TextureRegion added;
+    ASSERT_TRUE(atlas.add(ENTRY_SIZE, ENTRY_SIZE, m_pixels.data(), added));
+    atlas.endFrame();
+    TextureRegion second;
+    ASSERT_TRUE(atlas.add(ENTRY_SIZE, ENTRY_SIZE, m_pixels.data(), second));
+    EXPECT_EQ(atlas.getPageCount(), 1u);
+    EXPECT_FALSE(isSameRegion(added, second));
+}
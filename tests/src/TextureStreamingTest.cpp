@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "resource/TextureStreaming.hpp"
+
+using namespace Tina;
+
+TEST(TextureStreamingTest, MipForScreenSize) {
+    // 1024x512，共 11 级 mip
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 11, 2048.0f), 0);
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 11, 1024.0f), 0);
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 11, 1000.0f), 0);
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 11, 512.0f), 1);
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 11, 300.0f), 1);
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 11, 64.0f), 4);
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 11, 0.5f), 10);
+
+    // 不可见时只保留最低精度，mip 链不完整时按已有的级数截断
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 11, 0.0f), 10);
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 3, 64.0f), 2);
+    EXPECT_EQ(TextureStreaming::getMipForScreenSize(1024, 512, 1, 64.0f), 0);
+}
+
+TEST(TextureStreamingTest, InitialMip) {
+    EXPECT_EQ(TextureStreaming::getInitialMip(1024, 1024, 11), 4);
+    EXPECT_EQ(TextureStreaming::getInitialMip(2048, 256, 12), 5);
+    EXPECT_EQ(TextureStreaming::getInitialMip(64, 64, 7), 0);
+    EXPECT_EQ(TextureStreaming::getInitialMip(1024, 1024, 3), 2);
+    EXPECT_EQ(TextureStreaming::getInitialMip(1024, 1024, 11, 1), 10);
+}
+
+TEST(TextureStreamingTest, SmallSpriteStopsBelowFullResolution) {
+    // 1024x1024，共 11 级 mip；上传时从初始精度开始
+    constexpr uint8_t numMips = 11;
+    uint8_t residentMip = TextureStreaming::getInitialMip(1024, 1024, numMips);
+    uint8_t targetMip = residentMip;
+    TextureStreaming::ScreenSizeTracker tracker;
+
+    // 没有报告过屏幕尺寸时保持初始精度，不会自动提升到 mip 0
+    EXPECT_EQ(tracker.resolve(1024, 1024, numMips, targetMip), residentMip);
+
+    // 以 100 像素绘制，同一帧内的多次绘制取最大尺寸
+    for (int frame = 0; frame < 2 * numMips; ++frame) {
+        tracker.report(32.0f);
+        tracker.report(100.0f);
+        targetMip = tracker.resolve(1024, 1024, numMips, targetMip);
+        residentMip = TextureStreaming::getNextMip(residentMip, targetMip);
+        EXPECT_GT(residentMip, 0);
+    }
+    EXPECT_EQ(targetMip, 3);
+    EXPECT_EQ(residentMip, 3);
+
+    // 之后某一帧没有绘制，保持当前的目标
+    EXPECT_EQ(tracker.resolve(1024, 1024, numMips, targetMip), 3);
+
+    // 画得更小时直接降到目标
+    tracker.report(16.0f);
+    targetMip = tracker.resolve(1024, 1024, numMips, targetMip);
+    EXPECT_EQ(TextureStreaming::getNextMip(residentMip, targetMip), 6);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "core/ThreadPool.hpp"
+
+using namespace Tina;
+
+TEST(ThreadPoolTest, SubmitReturnsResult) {
+    ThreadPool pool(2);
+    auto future = pool.submit([]() { return 40 + 2; });
+    EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPoolTest, RunsAllTasks) {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(4);
+        for (int i = 0; i < 1000; ++i) {
+            pool.enqueue([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.waitIdle();
+        EXPECT_EQ(counter.load(), 1000);
+        EXPECT_EQ(pool.getPendingCount(), 0u);
+    }
+}
+
+TEST(ThreadPoolTest, DestructorDrainsQueue) {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(1);
+        for (int i = 0; i < 100; ++i) {
+            pool.enqueue([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+    }
+    EXPECT_EQ(counter.load(), 100);
+}
@@ -0,0 +1,202 @@
+#ifndef TRACK_MEMORY
+#define TRACK_MEMORY
+#endif
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "memory/MemoryPool.hpp"
+#include "memory/TrackMemory.hpp"
+
+using namespace Tina;
+
+namespace
+{
+    class TrackMemoryTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            TrackMemory::reset();
+        }
+
+        void TearDown() override
+        {
+            TrackMemory::reset();
+        }
+    };
+
+    void allocateResource(size_t bytes)
+    {
+        TINA_TRACK_ALLOC(MemoryTag::Resource, bytes);
+    }
+
+    void allocateRenderer(size_t bytes)
+    {
+        TINA_TRACK_ALLOC(MemoryTag::Renderer, bytes);
+    }
+}
+
+TEST_F(TrackMemoryTest, CountsBytesAndAllocationsPerTag)
+{
+    TrackMemory::recordAlloc(MemoryTag::Resource, 100);
+    TrackMemory::recordAlloc(MemoryTag::Resource, 50);
+    TrackMemory::recordAlloc(MemoryTag::Renderer, 8);
+    TrackMemory::recordFree(MemoryTag::Resource, 100);
+
+    const auto resource = TrackMemory::getStats(MemoryTag::Resource);
+    EXPECT_EQ(resource.currentBytes, 50);
+    EXPECT_EQ(resource.currentAllocations, 1);
+    EXPECT_EQ(resource.totalAllocations, 2);
+    // 释放前的 150 字节就是峰值，即使中间没有汇总
+    EXPECT_EQ(resource.peakBytes, 150);
+
+    const auto renderer = TrackMemory::getStats(MemoryTag::Renderer);
+    EXPECT_EQ(renderer.currentBytes, 8);
+    EXPECT_EQ(TrackMemory::getStats(MemoryTag::String).currentBytes, 0);
+}
+
+TEST_F(TrackMemoryTest, PeakIsKeptAfterFree)
+{
+    TrackMemory::recordAlloc(MemoryTag::Frame, 4096);
+    TrackMemory::sample();
+    TrackMemory::recordFree(MemoryTag::Frame, 4096);
+
+    const auto stats = TrackMemory::getStats(MemoryTag::Frame);
+    EXPECT_EQ(stats.currentBytes, 0);
+    EXPECT_EQ(stats.peakBytes, 4096);
+}
+
+TEST_F(TrackMemoryTest, AggregatesAcrossThreads)
+{
+    constexpr int threadCount = 8;
+    constexpr int allocationsPerThread = 10000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([]
+        {
+            for (int j = 0; j < allocationsPerThread; ++j)
+            {
+                TrackMemory::recordAlloc(MemoryTag::General, 16);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto stats = TrackMemory::getStats(MemoryTag::General);
+    EXPECT_EQ(stats.currentBytes, int64_t{threadCount} * allocationsPerThread * 16);
+    EXPECT_EQ(stats.totalAllocations, uint64_t{threadCount} * allocationsPerThread);
+
+    // 在另一个线程上释放，汇总结果仍然平衡
+    std::thread releaser([]
+    {
+        for (int j = 0; j < threadCount * allocationsPerThread; ++j)
+        {
+            TrackMemory::recordFree(MemoryTag::General, 16);
+        }
+    });
+    releaser.join();
+
+    EXPECT_EQ(TrackMemory::getStats(MemoryTag::General).currentBytes, 0);
+    EXPECT_EQ(TrackMemory::getStats(MemoryTag::General).currentAllocations, 0);
+}
+
+TEST_F(TrackMemoryTest, ReportsBudgetViolations)
+{
+    TrackMemory::setBudget(MemoryTag::Resource, 1024);
+    TrackMemory::setBudget(MemoryTag::Renderer, 1024);
+
+    TrackMemory::recordAlloc(MemoryTag::Resource, 512);
+    EXPECT_TRUE(TrackMemory::checkBudgets().empty());
+
+    TrackMemory::recordAlloc(MemoryTag::Resource, 1024);
+    TrackMemory::sample();
+    TrackMemory::recordFree(MemoryTag::Resource, 1024);
+
+    // 预算按采样到的峰值检查，超出后再释放同样会被报告
+    const auto violations = TrackMemory::checkBudgets();
+    ASSERT_EQ(violations.size(), 1);
+    EXPECT_EQ(violations[0].tag, MemoryTag::Resource);
+    EXPECT_EQ(violations[0].budgetBytes, 1024);
+    EXPECT_EQ(violations[0].peakBytes, 1536);
+}
+
+TEST_F(TrackMemoryTest, ReportsBudgetExceededBetweenSamples)
+{
+    TrackMemory::setBudget(MemoryTag::Resource, 1024);
+    TrackMemory::recordAlloc(MemoryTag::Resource, 256);
+    TrackMemory::sample();
+
+    // 两次汇总之间超出预算又释放，高水位在分配时记录
+    TrackMemory::recordAlloc(MemoryTag::Resource, 2048);
+    TrackMemory::recordFree(MemoryTag::Resource, 2048);
+
+    auto violations = TrackMemory::checkBudgets();
+    ASSERT_EQ(violations.size(), 1);
+    EXPECT_EQ(violations[0].peakBytes, 2304);
+
+    // 在工作线程上分配、在当前线程释放，中间同样没有汇总
+    TrackMemory::reset();
+    TrackMemory::setBudget(MemoryTag::Resource, 1024);
+    std::thread worker([]
+    {
+        TrackMemory::recordAlloc(MemoryTag::Resource, 4096);
+    });
+    worker.join();
+    TrackMemory::recordFree(MemoryTag::Resource, 4096);
+
+    violations = TrackMemory::checkBudgets();
+    ASSERT_EQ(violations.size(), 1);
+    EXPECT_EQ(violations[0].peakBytes, 4096);
+    EXPECT_EQ(TrackMemory::getStats(MemoryTag::Resource).currentBytes, 0);
+}
+
+TEST_F(TrackMemoryTest, RanksCallSitesByBytes)
+{
+    allocateRenderer(64);
+    for (int i = 0; i < 4; ++i)
+    {
+        allocateResource(1000);
+    }
+
+    const auto sites = TrackMemory::getTopCallSites(2);
+    ASSERT_EQ(sites.size(), 2);
+    EXPECT_EQ(sites[0]->bytes.load(), 4000);
+    EXPECT_EQ(sites[0]->count.load(), 4);
+    EXPECT_STREQ(sites[0]->function, "allocateResource");
+    EXPECT_EQ(sites[1]->bytes.load(), 64);
+
+    TrackMemory::dumpTopCallSites(2);
+}
+
+TEST_F(TrackMemoryTest, AttributesAllocatorMemoryToCaller)
+{
+    // 池的块记到创建池的这一行，而不是 MemoryPool 内部
+    const int line = __LINE__ + 1;
+    MemoryPool<uint64_t, 1024> pool;
+    uint64_t* value = pool.allocate();
+    ASSERT_NE(value, nullptr);
+
+    const auto sites = TrackMemory::getTopCallSites(4);
+    ASSERT_EQ(sites.size(), 1);
+    EXPECT_STREQ(sites[0]->file, __FILE__);
+    EXPECT_EQ(sites[0]->line, line);
+    EXPECT_EQ(sites[0]->bytes.load(), 1024);
+
+    // 显式传入的位置同样作为分配点
+    const SourceLocation location{"Caller.cpp", 42, "loadLevel"};
+    TrackMemory::recordAlloc(MemoryTag::Resource, 4096, location);
+    TrackMemory::recordAlloc(MemoryTag::Resource, 4096, location);
+    const auto top = TrackMemory::getTopCallSites(1);
+    ASSERT_EQ(top.size(), 1);
+    EXPECT_STREQ(top[0]->function, "loadLevel");
+    EXPECT_EQ(top[0]->count.load(), 2);
+    TrackMemory::recordFree(MemoryTag::Resource, 8192);
+
+    pool.deallocate(value);
+}
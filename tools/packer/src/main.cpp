@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "resource/ResourcePackWriter.hpp"
+
+using namespace Tina;
+
+namespace {
+    void printUsage() {
+        std::cerr << "Usage: TinaPacker <input dir> <output.pak> [--prefix <path>] [--compress] [--align <bytes>]\n"
+                  << "  --prefix    prepended to each file's path relative to <input dir> (default: none)\n"
+                  << "  --compress  LZ4-compress files other than cooked textures and shaders (default: store uncompressed)\n"
+                  << "  --align     data alignment in bytes, a power of two >= 8 (default: 16)" << std::endl;
+    }
+
+    std::string getExtension(const std::filesystem::path &file) {
+        std::string extension = file.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+
+    // 运行时直接从映射的包中切片使用的文件：预处理过的纹理按 mip 上传，着色器直接交给 bgfx。
+    // 压缩后读取时需要先解压到堆上，因此这些文件总是原样存储
+    bool isMappedDirectly(const std::filesystem::path &file) {
+        const std::string extension = getExtension(file);
+        return extension == ".ktx" || extension == ".dds" || extension == ".bin";
+    }
+
+    // 同目录下有构建时生成的 .ktx 的源图片：运行时总是优先读取包中的 .ktx，源图片不需要打包
+    bool hasCookedTexture(const std::filesystem::path &file) {
+        const std::string extension = getExtension(file);
+        if (extension != ".png" && extension != ".tga" && extension != ".jpg" && extension != ".jpeg") {
+            return false;
+        }
+        std::filesystem::path cooked(file);
+        return std::filesystem::is_regular_file(cooked.replace_extension(".ktx"));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return -1;
+    }
+
+    const std::filesystem::path inputDir(argv[1]);
+    const std::string outputPath(argv[2]);
+    std::string prefix;
+    bool compress = false;
+    uint32_t alignment = 16;
+
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if (arg == "--prefix" && i + 1 < argc) {
+            prefix = argv[++i];
+        } else if (arg == "--compress") {
+            compress = true;
+        } else if (arg == "--align" && i + 1 < argc) {
+            alignment = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else {
+            printUsage();
+            return -1;
+        }
+    }
+
+    try {
+        if (!std::filesystem::is_directory(inputDir)) {
+            std::cerr << "Input directory does not exist: " << inputDir.string() << std::endl;
+            return -1;
+        }
+
+        // 按路径排序，保证同样的输入生成同样的文件
+        std::vector<std::filesystem::path> files;
+        for (const auto &entry: std::filesystem::recursive_directory_iterator(inputDir)) {
+            if (entry.is_regular_file() && entry.path() != std::filesystem::absolute(outputPath) &&
+                !hasCookedTexture(entry.path())) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        ResourcePackWriter writer(alignment);
+        for (const auto &file: files) {
+            const std::string relative = std::filesystem::relative(file, inputDir).generic_string();
+            if (!writer.addFile(prefix + relative, Path(file.string()), compress && !isMappedDirectly(file))) {
+                return -1;
+            }
+        }
+
+        if (!writer.write(Path(outputPath))) {
+            return -1;
+        }
+        std::cout << "Packed " << writer.getEntryCount() << " files into " << outputPath << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "An error occurred: " << e.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}